@@ -0,0 +1,168 @@
+/**
+ CChangeJournal
+ @brief A class which records the edits made to a CMapLevel, so that anything built from the level can ask
+		what changed since it was last built and update only those tiles or chunks, instead of scanning the level.
+		Each edit goes up one version. The most recent edits are kept in a ring buffer,
+		and each chunk of tiles remembers the version of its last edit.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "ChangeJournal.h"
+
+/**
+ @brief Constructor
+ @param uiCapacity A const unsigned int variable containing the number of edits kept in the ring buffer
+ @param uiChunkSize A const unsigned int variable containing the number of tiles along each side of a chunk
+ */
+CChangeJournal::CChangeJournal(const unsigned int uiCapacity, const unsigned int uiChunkSize)
+	: uiVersion(0)
+	, uiOldestVersion(0)
+	, uiHead(0)
+	, uiNumEntries(0)
+	, uiChunkSize(uiChunkSize > 0 ? uiChunkSize : 1)
+	, uiNumChunkRows(0)
+	, uiNumChunkCols(0)
+{
+	arrEntries.resize(uiCapacity > 0 ? uiCapacity : 1);
+}
+
+/**
+ @brief Destructor
+ */
+CChangeJournal::~CChangeJournal(void)
+{
+}
+
+/**
+ @brief Start again for a level whose tiles were all replaced
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+void CChangeJournal::Reset(const CMapLevel& cLevel)
+{
+	uiVersion++;
+	uiOldestVersion = uiVersion;
+	uiHead = 0;
+	uiNumEntries = 0;
+
+	uiNumChunkRows = (cLevel.GetNumRows() + uiChunkSize - 1) / uiChunkSize;
+	uiNumChunkCols = (cLevel.GetNumCols() + uiChunkSize - 1) / uiChunkSize;
+	arrChunkVersions.assign(uiNumChunkRows * uiNumChunkCols, uiVersion);
+}
+
+/**
+ @brief Record an edit of a tile
+ @param uiRow A const unsigned int variable containing the inverted row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param iOldValue A const int variable containing the value the tile held
+ @param iNewValue A const int variable containing the value the tile holds now
+ */
+void CChangeJournal::Record(const unsigned int uiRow, const unsigned int uiCol, const int iOldValue, const int iNewValue)
+{
+	uiVersion++;
+
+	// Overwrite the oldest edit once the ring buffer is full
+	if (uiNumEntries == arrEntries.size())
+		uiOldestVersion = arrEntries[uiHead].uiVersion;
+	else
+		uiNumEntries++;
+	TileChange& sChange = arrEntries[uiHead];
+	sChange.uiVersion = uiVersion;
+	sChange.uiRow = uiRow;
+	sChange.uiCol = uiCol;
+	sChange.iOldValue = iOldValue;
+	sChange.iNewValue = iNewValue;
+	uiHead = (uiHead + 1) % arrEntries.size();
+
+	const unsigned int uiChunk = (uiRow / uiChunkSize) * uiNumChunkCols + uiCol / uiChunkSize;
+	if (uiChunk < arrChunkVersions.size())
+		arrChunkVersions[uiChunk] = uiVersion;
+}
+
+/**
+ @brief Get the version of the latest edit
+ */
+unsigned int CChangeJournal::GetVersion(void) const
+{
+	return uiVersion;
+}
+
+/**
+ @brief Get the edits made after a version, oldest first
+ @param uiVersion A const unsigned int variable containing the version which the caller is up to date with
+ @param arrChanges A std::vector<TileChange>& variable which will store the edits
+ */
+bool CChangeJournal::GetChangesSince(const unsigned int uiVersion, std::vector<TileChange>& arrChanges) const
+{
+	arrChanges.clear();
+	if (uiVersion < uiOldestVersion)
+		return false;
+	if (uiVersion >= this->uiVersion)
+		return true;
+
+	// The edits are in version order, so the ones wanted are the last (latest version - uiVersion) of them
+	const unsigned int uiNumChanges = this->uiVersion - uiVersion;
+	const unsigned int uiCapacity = (unsigned int)arrEntries.size();
+	arrChanges.reserve(uiNumChanges);
+	for (unsigned int i = uiNumChanges; i > 0; i--)
+		arrChanges.push_back(arrEntries[(uiHead + uiCapacity - i) % uiCapacity]);
+	return true;
+}
+
+/**
+ @brief Check if a chunk was edited after a version
+ @param uiChunkRow A const unsigned int variable containing the inverted row of the chunk
+ @param uiChunkCol A const unsigned int variable containing the column of the chunk
+ @param uiVersion A const unsigned int variable containing the version which the caller is up to date with
+ */
+bool CChangeJournal::IsChunkDirty(const unsigned int uiChunkRow, const unsigned int uiChunkCol, const unsigned int uiVersion) const
+{
+	if ((uiChunkRow >= uiNumChunkRows) || (uiChunkCol >= uiNumChunkCols))
+		return false;
+	return arrChunkVersions[uiChunkRow * uiNumChunkCols + uiChunkCol] > uiVersion;
+}
+
+/**
+ @brief Get a bitmap of the chunks edited after a version
+ @param uiVersion A const unsigned int variable containing the version which the caller is up to date with
+ @param arrBitmap A std::vector<unsigned int>& variable which will store the bitmap, 32 chunks to a word
+ */
+unsigned int CChangeJournal::GetDirtyChunks(const unsigned int uiVersion, std::vector<unsigned int>& arrBitmap) const
+{
+	const unsigned int uiNumChunks = (unsigned int)arrChunkVersions.size();
+	arrBitmap.assign((uiNumChunks + 31) / 32, 0);
+
+	unsigned int uiNumDirty = 0;
+	for (unsigned int i = 0; i < uiNumChunks; i++)
+	{
+		if (arrChunkVersions[i] > uiVersion)
+		{
+			arrBitmap[i >> 5] |= 1u << (i & 31);
+			uiNumDirty++;
+		}
+	}
+	return uiNumDirty;
+}
+
+/**
+ @brief Get the number of tiles along each side of a chunk
+ */
+unsigned int CChangeJournal::GetChunkSize(void) const
+{
+	return uiChunkSize;
+}
+
+/**
+ @brief Get the number of chunks along the rows of the level
+ */
+unsigned int CChangeJournal::GetNumChunkRows(void) const
+{
+	return uiNumChunkRows;
+}
+
+/**
+ @brief Get the number of chunks along the columns of the level
+ */
+unsigned int CChangeJournal::GetNumChunkCols(void) const
+{
+	return uiNumChunkCols;
+}
@@ -0,0 +1,76 @@
+/**
+ CChangeJournal
+ @brief A class which records the edits made to a CMapLevel, so that anything built from the level can ask
+		what changed since it was last built and update only those tiles or chunks, instead of scanning the level.
+		Each edit goes up one version. The most recent edits are kept in a ring buffer,
+		and each chunk of tiles remembers the version of its last edit.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <vector>
+
+// One edit of a tile. The row is inverted, like the path positions
+struct TileChange
+{
+	unsigned int uiVersion;
+	unsigned int uiRow;
+	unsigned int uiCol;
+	int iOldValue;
+	int iNewValue;
+};
+
+class CChangeJournal
+{
+public:
+	// Constructor
+	CChangeJournal(const unsigned int uiCapacity = 1024, const unsigned int uiChunkSize = 16);
+
+	// Destructor
+	~CChangeJournal(void);
+
+	// Start again for a level whose tiles were all replaced, e.g. when a map was loaded.
+	// Every chunk becomes dirty, and the edits before this cannot be asked for any more
+	void Reset(const CMapLevel& cLevel);
+
+	// Record an edit of a tile. The row is inverted, like the path positions
+	void Record(const unsigned int uiRow, const unsigned int uiCol, const int iOldValue, const int iNewValue);
+
+	// Get the version of the latest edit
+	unsigned int GetVersion(void) const;
+
+	// Get the edits made after uiVersion, oldest first. Returns false if some of them are no longer in the journal,
+	// in which case the caller has to rebuild everything, or use the dirty chunks
+	bool GetChangesSince(const unsigned int uiVersion, std::vector<TileChange>& arrChanges) const;
+
+	// Check if a chunk was edited after uiVersion
+	bool IsChunkDirty(const unsigned int uiChunkRow, const unsigned int uiChunkCol, const unsigned int uiVersion) const;
+	// Get a bitmap of the chunks edited after uiVersion, with bit (chunk row * chunk columns + chunk column) set for each.
+	// Returns the number of dirty chunks
+	unsigned int GetDirtyChunks(const unsigned int uiVersion, std::vector<unsigned int>& arrBitmap) const;
+
+	// Get the number of tiles along each side of a chunk, and the number of chunks along each side of the level
+	unsigned int GetChunkSize(void) const;
+	unsigned int GetNumChunkRows(void) const;
+	unsigned int GetNumChunkCols(void) const;
+
+protected:
+	// The version of the latest edit, and the version before the oldest edit still in the ring buffer
+	unsigned int uiVersion;
+	unsigned int uiOldestVersion;
+
+	// The most recent edits, with uiHead being where the next one is written
+	std::vector<TileChange> arrEntries;
+	unsigned int uiHead;
+	unsigned int uiNumEntries;
+
+	// The size of a chunk, the number of chunks, and the version of the last edit of each chunk
+	unsigned int uiChunkSize;
+	unsigned int uiNumChunkRows;
+	unsigned int uiNumChunkCols;
+	std::vector<unsigned int> arrChunkVersions;
+};
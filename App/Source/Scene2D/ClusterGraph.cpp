@@ -0,0 +1,622 @@
+/**
+ CClusterGraph
+ @brief A class which splits a CMapLevel into square clusters for Hierarchical Path Finding (HPA*).
+		The entrances between clusters and the distances between the entrances of each cluster are
+		precomputed. Only the clusters touched by a changed blocking tile are rebuilt.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "ClusterGraph.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+using namespace std;
+
+// Runs of entrance tiles shorter than this get 1 entrance in the middle, longer runs get 1 at each end
+static const int iMaxSingleEntranceLength = 6;
+
+/**
+ @brief Constructor
+ */
+CClusterGraph::CClusterGraph(void)
+	: uiClusterSize(10)
+	, uiNumClustersX(0)
+	, uiNumClustersY(0)
+	, uiNrOfDirections(4)
+	, m_uiGeneration(0)
+	, m_uiNumNodesExpanded(0)
+	, m_uiNumClustersRebuilt(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CClusterGraph::~CClusterGraph(void)
+{
+}
+
+/**
+ @brief Init the clusters for a level of this size
+ @param uiNumRows A const unsigned int variable containing the number of rows in the level
+ @param uiNumCols A const unsigned int variable containing the number of columns in the level
+ @param uiClusterSize A const unsigned int variable containing the width and height of a cluster, in tiles
+ */
+void CClusterGraph::Init(const unsigned int uiNumRows, const unsigned int uiNumCols, const unsigned int uiClusterSize)
+{
+	sMapSize.uiRowSize = uiNumRows;
+	sMapSize.uiColSize = uiNumCols;
+	this->uiClusterSize = uiClusterSize;
+	uiNumClustersX = (uiNumCols + uiClusterSize - 1) / uiClusterSize;
+	uiNumClustersY = (uiNumRows + uiClusterSize - 1) / uiClusterSize;
+
+	arrClusters.assign(uiNumClustersX * uiNumClustersY, Cluster());
+	for (unsigned int uiClusterY = 0; uiClusterY < uiNumClustersY; uiClusterY++)
+	{
+		for (unsigned int uiClusterX = 0; uiClusterX < uiNumClustersX; uiClusterX++)
+		{
+			Cluster& cluster = arrClusters[uiClusterY * uiNumClustersX + uiClusterX];
+			cluster.iMinX = uiClusterX * uiClusterSize;
+			cluster.iMinY = uiClusterY * uiClusterSize;
+			cluster.iMaxX = std::min((uiClusterX + 1) * uiClusterSize, uiNumCols);
+			cluster.iMaxY = std::min((uiClusterY + 1) * uiClusterSize, uiNumRows);
+		}
+	}
+	arrBordersX.assign(uiNumClustersX * uiNumClustersY, Border());
+	arrBordersY.assign(uiNumClustersX * uiNumClustersY, Border());
+	arrNodeIndices.assign(uiNumRows * uiNumCols, -1);
+
+	Node node;
+	node.uiGeneration = 0;
+	node.g = 0;
+	node.iParent = -1;
+	node.bClosed = false;
+	m_nodes.assign(uiNumRows * uiNumCols, node);
+	m_openList.Init(uiNumRows * uiNumCols);
+	m_uiGeneration = 0;
+
+	arrLocalDistances.resize(uiClusterSize * uiClusterSize);
+	arrLocalParents.resize(uiClusterSize * uiClusterSize);
+	arrLocalQueue.resize(uiClusterSize * uiClusterSize);
+
+	Invalidate();
+}
+
+/**
+ @brief Mark every cluster as out of date
+ */
+void CClusterGraph::Invalidate(void)
+{
+	for (unsigned int i = 0; i < arrClusters.size(); i++)
+	{
+		arrClusters[i].bDirty = true;
+		arrBordersX[i].bDirty = true;
+		arrBordersY[i].bDirty = true;
+	}
+}
+
+/**
+ @brief Mark the clusters around a tile as out of date. A tile inside a cluster only affects that cluster,
+		while a tile on the edge of a cluster also changes the entrances of the neighbouring cluster.
+ @param uiRow A const unsigned int variable containing the inverted row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CClusterGraph::OnTileChanged(const unsigned int uiRow, const unsigned int uiCol)
+{
+	const unsigned int uiClusterX = uiCol / uiClusterSize;
+	const unsigned int uiClusterY = uiRow / uiClusterSize;
+	const unsigned int uiCluster = uiClusterY * uiNumClustersX + uiClusterX;
+	arrClusters[uiCluster].bDirty = true;
+
+	if ((uiCol % uiClusterSize == 0) && (uiClusterX > 0))
+	{
+		arrBordersX[uiCluster - 1].bDirty = true;
+		arrClusters[uiCluster - 1].bDirty = true;
+	}
+	if ((uiCol % uiClusterSize == uiClusterSize - 1) && (uiClusterX + 1 < uiNumClustersX))
+	{
+		arrBordersX[uiCluster].bDirty = true;
+		arrClusters[uiCluster + 1].bDirty = true;
+	}
+	if ((uiRow % uiClusterSize == 0) && (uiClusterY > 0))
+	{
+		arrBordersY[uiCluster - uiNumClustersX].bDirty = true;
+		arrClusters[uiCluster - uiNumClustersX].bDirty = true;
+	}
+	if ((uiRow % uiClusterSize == uiClusterSize - 1) && (uiClusterY + 1 < uiNumClustersY))
+	{
+		arrBordersY[uiCluster].bDirty = true;
+		arrClusters[uiCluster + uiNumClustersX].bDirty = true;
+	}
+}
+
+/**
+ @brief Find a path. The start and target are joined to the entrances of their clusters, the path is found
+		over the entrances, and then each step between entrances is refined into tiles inside its cluster.
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param cPathFinder A CPathFinder& variable used for searches inside one cluster, and for its diagonal movement setting
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ */
+std::vector<glm::vec2> CClusterGraph::PathFind(const CMapLevel& cLevel,
+	CPathFinder& cPathFinder,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	int weight)
+{
+	m_uiNumNodesExpanded = 0;
+	m_uiNumClustersRebuilt = 0;
+
+	// Make sure that the clusters match this level and the diagonal movement setting
+	if ((cLevel.GetNumRows() != sMapSize.uiRowSize) || (cLevel.GetNumCols() != sMapSize.uiColSize))
+		Init(cLevel.GetNumRows(), cLevel.GetNumCols(), uiClusterSize);
+	const unsigned int uiDirections = cPathFinder.GetDiagonalMovement() ? 8 : 4;
+	if (uiDirections != uiNrOfDirections)
+	{
+		uiNrOfDirections = uiDirections;
+		Invalidate();
+	}
+
+	// Check if the startPos and targetPost are blocked
+	if (!CJumpTable::IsFree(cLevel, (int)startPos.x, (int)startPos.y) ||
+		!CJumpTable::IsFree(cLevel, (int)targetPos.x, (int)targetPos.y))
+	{
+		cout << "Invalid start or target position." << endl;
+		return std::vector<glm::vec2>();
+	}
+
+	// A search inside one cluster is short enough to run on the tiles
+	const int iStart = (int)startPos.y * sMapSize.uiColSize + (int)startPos.x;
+	const int iTarget = (int)targetPos.y * sMapSize.uiColSize + (int)targetPos.x;
+	const int iStartCluster = GetClusterIndex((int)startPos.x, (int)startPos.y);
+	const int iTargetCluster = GetClusterIndex((int)targetPos.x, (int)targetPos.y);
+	if (iStartCluster == iTargetCluster)
+		return cPathFinder.PathFind(cLevel, startPos, targetPos, heuristicFunc, weight);
+
+	Rebuild(cLevel);
+
+	// Find the distances from the target to the entrances of its cluster
+	const Cluster& targetCluster = arrClusters[iTargetCluster];
+	SearchCluster(cLevel, targetCluster, iTarget);
+	std::vector<int> arrTargetDistances(targetCluster.arrNodes.size());
+	for (unsigned int i = 0; i < targetCluster.arrNodes.size(); i++)
+		arrTargetDistances[i] = GetLocalDistance(targetCluster, targetCluster.arrNodes[i]);
+
+	// Find the distances from the start to the entrances of its cluster
+	const Cluster& startCluster = arrClusters[iStartCluster];
+	SearchCluster(cLevel, startCluster, iStart);
+
+	// Start a new search over the entrances
+	m_openList.Clear();
+	m_uiGeneration++;
+	if (m_uiGeneration == 0)
+	{
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			m_nodes[i].uiGeneration = 0;
+		m_uiGeneration = 1;
+	}
+	Node& startNode = GetNode(iStart);
+	startNode.iParent = iStart;
+	m_openList.Push(iStart, 0);
+
+	bool bFound = false;
+	while (!m_openList.Empty())
+	{
+		// Get the node with the least f value
+		const int iCurrent = m_openList.Top();
+
+		// If the targetPos was reached, then quit this loop
+		if (iCurrent == iTarget)
+		{
+			m_openList.Clear();
+			bFound = true;
+			break;
+		}
+
+		m_openList.Pop();
+		m_nodes[iCurrent].bClosed = true;
+		m_uiNumNodesExpanded++;
+		const unsigned int g = m_nodes[iCurrent].g;
+
+		// The start leads to every entrance of its cluster which it can reach
+		if (iCurrent == iStart)
+		{
+			for (unsigned int i = 0; i < startCluster.arrNodes.size(); i++)
+			{
+				const int iDistance = GetLocalDistance(startCluster, startCluster.arrNodes[i]);
+				if (iDistance > 0)
+					Relax(startCluster.arrNodes[i], iCurrent, g + iDistance, targetPos, heuristicFunc, weight);
+			}
+		}
+
+		const int iNodeIndex = arrNodeIndices[iCurrent];
+		if (iNodeIndex < 0)
+			continue;
+
+		// An entrance leads to the other entrances of its cluster...
+		const int iClusterX = (iCurrent % sMapSize.uiColSize) / uiClusterSize;
+		const int iClusterY = (iCurrent / sMapSize.uiColSize) / uiClusterSize;
+		const int iCluster = iClusterY * uiNumClustersX + iClusterX;
+		const Cluster& cluster = arrClusters[iCluster];
+		const unsigned int uiNumNodes = (unsigned int)cluster.arrNodes.size();
+		for (unsigned int i = 0; i < uiNumNodes; i++)
+		{
+			const unsigned int uiDistance = cluster.arrDistances[iNodeIndex * uiNumNodes + i];
+			if ((i != (unsigned int)iNodeIndex) && (uiDistance != UINT_MAX))
+				Relax(cluster.arrNodes[i], iCurrent, g + uiDistance, targetPos, heuristicFunc, weight);
+		}
+
+		// ...to the tiles across the borders of its cluster...
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			const int iCrossing = cluster.arrCrossings[iNodeIndex * 2 + i];
+			if (iCrossing >= 0)
+				Relax(iCrossing, iCurrent, g + 1, targetPos, heuristicFunc, weight);
+		}
+
+		// ...and to the target, if it is in the same cluster
+		if ((iCluster == iTargetCluster) && (arrTargetDistances[iNodeIndex] >= 0))
+			Relax(iTarget, iCurrent, g + arrTargetDistances[iNodeIndex], targetPos, heuristicFunc, weight);
+	}
+
+	if (!bFound)
+	{
+		// With 4 directions every way between clusters crosses an entrance, so the target cannot be reached.
+		// With 8 directions a diagonal step can cross a corner between entrances, so search the tiles
+		if (uiNrOfDirections == 8)
+			return cPathFinder.PathFind(cLevel, startPos, targetPos, heuristicFunc, weight);
+		return std::vector<glm::vec2>();
+	}
+
+	// Get the entrances on the path, from the start to the target
+	std::vector<int> arrWaypoints;
+	for (int iCurrent = iTarget; iCurrent != iStart; iCurrent = m_nodes[iCurrent].iParent)
+		arrWaypoints.push_back(iCurrent);
+	arrWaypoints.push_back(iStart);
+	std::reverse(arrWaypoints.begin(), arrWaypoints.end());
+
+	// Refine each step between entrances into tiles
+	std::vector<glm::vec2> path;
+	std::vector<glm::vec2> segment;
+	for (unsigned int i = 1; i < arrWaypoints.size(); i++)
+	{
+		const int iFrom = arrWaypoints[i - 1];
+		const int iTo = arrWaypoints[i];
+		const int iCluster = GetClusterIndex(iFrom % sMapSize.uiColSize, iFrom / sMapSize.uiColSize);
+		const Cluster& cluster = arrClusters[iCluster];
+
+		// A step across a border is a single tile
+		if (GetClusterIndex(iTo % sMapSize.uiColSize, iTo / sMapSize.uiColSize) != iCluster)
+		{
+			path.push_back(glm::vec2(iTo % sMapSize.uiColSize, iTo / sMapSize.uiColSize));
+			continue;
+		}
+
+		SearchCluster(cLevel, cluster, iFrom);
+		const int iWidth = cluster.iMaxX - cluster.iMinX;
+		segment.clear();
+		int iLocal = ((iTo / (int)sMapSize.uiColSize) - cluster.iMinY) * iWidth + (iTo % sMapSize.uiColSize) - cluster.iMinX;
+		while (arrLocalParents[iLocal] != iLocal)
+		{
+			segment.push_back(glm::vec2(cluster.iMinX + iLocal % iWidth, cluster.iMinY + iLocal / iWidth));
+			iLocal = arrLocalParents[iLocal];
+		}
+		path.insert(path.end(), segment.rbegin(), segment.rend());
+	}
+
+	// If the path has only 1 entry, then it is the the target position
+	// This is only OK if startPos is next to targetPos
+	if ((path.size() == 1) && (abs(targetPos.y - startPos.y) + abs(targetPos.x - startPos.x) > 1))
+		path.clear();
+
+	return path;
+}
+
+/**
+ @brief Get the number of abstract nodes expanded by the last call to PathFind()
+ */
+unsigned int CClusterGraph::GetNumNodesExpanded(void) const
+{
+	return m_uiNumNodesExpanded;
+}
+
+/**
+ @brief Get the number of clusters rebuilt by the last call to PathFind()
+ */
+unsigned int CClusterGraph::GetNumClustersRebuilt(void) const
+{
+	return m_uiNumClustersRebuilt;
+}
+
+/**
+ @brief Print out the details about this class instance in the console
+ */
+void CClusterGraph::PrintSelf(void) const
+{
+	unsigned int uiNumNodes = 0;
+	for (unsigned int i = 0; i < arrClusters.size(); i++)
+		uiNumNodes += (unsigned int)arrClusters[i].arrNodes.size();
+
+	cout << "uiClusterSize: " << uiClusterSize << endl;
+	cout << "arrClusters: " << uiNumClustersX << "x" << uiNumClustersY << endl;
+	cout << "Entrances: " << uiNumNodes << endl;
+	cout << "m_uiNumNodesExpanded: " << m_uiNumNodesExpanded << endl;
+}
+
+/**
+ @brief Get the cluster which a position is in
+ */
+int CClusterGraph::GetClusterIndex(const int iX, const int iY) const
+{
+	return (iY / uiClusterSize) * uiNumClustersX + (iX / uiClusterSize);
+}
+
+/**
+ @brief Rebuild the borders and clusters which are out of date
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+void CClusterGraph::Rebuild(const CMapLevel& cLevel)
+{
+	for (unsigned int uiClusterY = 0; uiClusterY < uiNumClustersY; uiClusterY++)
+	{
+		for (unsigned int uiClusterX = 0; uiClusterX < uiNumClustersX; uiClusterX++)
+		{
+			const unsigned int uiCluster = uiClusterY * uiNumClustersX + uiClusterX;
+			if (arrBordersX[uiCluster].bDirty && (uiClusterX + 1 < uiNumClustersX))
+				BuildBorder(cLevel, arrBordersX[uiCluster], false, uiClusterX, uiClusterY);
+			if (arrBordersY[uiCluster].bDirty && (uiClusterY + 1 < uiNumClustersY))
+				BuildBorder(cLevel, arrBordersY[uiCluster], true, uiClusterX, uiClusterY);
+		}
+	}
+
+	for (unsigned int i = 0; i < arrClusters.size(); i++)
+	{
+		if (arrClusters[i].bDirty)
+		{
+			BuildCluster(cLevel, i);
+			m_uiNumClustersRebuilt++;
+		}
+	}
+}
+
+/**
+ @brief Find the entrances across the border between a cluster and the cluster to its right or above it.
+		Each run of free tiles facing free tiles on the other side gets 1 or 2 entrances.
+ @param cLevel A const CMapLevel& variable containing the level
+ @param border A Border& variable which will store the entrances
+ @param bHorizontal A const bool variable which is true for the border with the cluster above
+ @param iClusterX A const int variable containing the column of the cluster
+ @param iClusterY A const int variable containing the row of the cluster
+ */
+void CClusterGraph::BuildBorder(const CMapLevel& cLevel, Border& border, const bool bHorizontal, const int iClusterX, const int iClusterY)
+{
+	const Cluster& cluster = arrClusters[iClusterY * uiNumClustersX + iClusterX];
+	const int iNumCols = (int)sMapSize.uiColSize;
+	// The border runs along the last column (or row) of this cluster
+	const int iStepX = bHorizontal ? 1 : 0;
+	const int iStepY = bHorizontal ? 0 : 1;
+	const int iFirstX = bHorizontal ? cluster.iMinX : cluster.iMaxX - 1;
+	const int iFirstY = bHorizontal ? cluster.iMaxY - 1 : cluster.iMinY;
+	const int iLength = bHorizontal ? cluster.iMaxX - cluster.iMinX : cluster.iMaxY - cluster.iMinY;
+
+	border.arrTransitions.clear();
+	int iRunStart = -1;
+	for (int i = 0; i <= iLength; i++)
+	{
+		const int iX = iFirstX + i * iStepX;
+		const int iY = iFirstY + i * iStepY;
+		const bool bOpen = (i < iLength) &&
+			CJumpTable::IsFree(cLevel, iX, iY) &&
+			CJumpTable::IsFree(cLevel, iX + iStepY, iY + iStepX);
+		if (bOpen)
+		{
+			if (iRunStart < 0)
+				iRunStart = i;
+			continue;
+		}
+		if (iRunStart < 0)
+			continue;
+
+		// Add the entrances of the run which just ended
+		const int iRunEnd = i - 1;
+		int arrEntrances[2] = { (iRunStart + iRunEnd) / 2, -1 };
+		if (iRunEnd - iRunStart + 1 >= iMaxSingleEntranceLength)
+		{
+			arrEntrances[0] = iRunStart;
+			arrEntrances[1] = iRunEnd;
+		}
+		for (unsigned int j = 0; j < 2; j++)
+		{
+			if (arrEntrances[j] < 0)
+				continue;
+			const int iEntranceX = iFirstX + arrEntrances[j] * iStepX;
+			const int iEntranceY = iFirstY + arrEntrances[j] * iStepY;
+			border.arrTransitions.push_back(iEntranceY * iNumCols + iEntranceX);
+			border.arrTransitions.push_back((iEntranceY + iStepX) * iNumCols + iEntranceX + iStepY);
+		}
+		iRunStart = -1;
+	}
+
+	border.bDirty = false;
+}
+
+/**
+ @brief Collect the entrances of a cluster from its 4 borders, and compute the distances between them
+ @param cLevel A const CMapLevel& variable containing the level
+ @param iCluster A const int variable containing the index of the cluster
+ */
+void CClusterGraph::BuildCluster(const CMapLevel& cLevel, const int iCluster)
+{
+	Cluster& cluster = arrClusters[iCluster];
+	const int iClusterX = iCluster % uiNumClustersX;
+	const int iClusterY = iCluster / uiNumClustersX;
+
+	for (unsigned int i = 0; i < cluster.arrNodes.size(); i++)
+		arrNodeIndices[cluster.arrNodes[i]] = -1;
+	cluster.arrNodes.clear();
+
+	// This cluster is the first cluster of its right and upper borders, and the second of its left and lower borders
+	if (iClusterX > 0)
+		AddBorderNodes(cluster.arrNodes, arrBordersX[iCluster - 1], false);
+	if (iClusterX + 1 < (int)uiNumClustersX)
+		AddBorderNodes(cluster.arrNodes, arrBordersX[iCluster], true);
+	if (iClusterY > 0)
+		AddBorderNodes(cluster.arrNodes, arrBordersY[iCluster - uiNumClustersX], false);
+	if (iClusterY + 1 < (int)uiNumClustersY)
+		AddBorderNodes(cluster.arrNodes, arrBordersY[iCluster], true);
+
+	// A corner tile can be an entrance of 2 borders
+	std::sort(cluster.arrNodes.begin(), cluster.arrNodes.end());
+	cluster.arrNodes.erase(std::unique(cluster.arrNodes.begin(), cluster.arrNodes.end()), cluster.arrNodes.end());
+
+	const unsigned int uiNumNodes = (unsigned int)cluster.arrNodes.size();
+	for (unsigned int i = 0; i < uiNumNodes; i++)
+		arrNodeIndices[cluster.arrNodes[i]] = i;
+
+	cluster.arrCrossings.assign(uiNumNodes * 2, -1);
+	if (iClusterX > 0)
+		AddBorderCrossings(cluster, arrBordersX[iCluster - 1], false);
+	if (iClusterX + 1 < (int)uiNumClustersX)
+		AddBorderCrossings(cluster, arrBordersX[iCluster], true);
+	if (iClusterY > 0)
+		AddBorderCrossings(cluster, arrBordersY[iCluster - uiNumClustersX], false);
+	if (iClusterY + 1 < (int)uiNumClustersY)
+		AddBorderCrossings(cluster, arrBordersY[iCluster], true);
+
+	// Compute the distances between the entrances inside this cluster
+	cluster.arrDistances.assign(uiNumNodes * uiNumNodes, UINT_MAX);
+	for (unsigned int i = 0; i < uiNumNodes; i++)
+	{
+		SearchCluster(cLevel, cluster, cluster.arrNodes[i]);
+		for (unsigned int j = 0; j < uiNumNodes; j++)
+		{
+			const int iDistance = GetLocalDistance(cluster, cluster.arrNodes[j]);
+			if (iDistance >= 0)
+				cluster.arrDistances[i * uiNumNodes + j] = iDistance;
+		}
+	}
+
+	cluster.bDirty = false;
+}
+
+/**
+ @brief Add the entrances of a cluster from one of its borders
+ @param arrNodes A std::vector<int>& variable to add the entrances to
+ @param border A const Border& variable containing the border
+ @param bFirst A const bool variable which is true if the cluster is the first cluster of this border
+ */
+void CClusterGraph::AddBorderNodes(std::vector<int>& arrNodes, const Border& border, const bool bFirst) const
+{
+	for (unsigned int i = (bFirst ? 0 : 1); i < border.arrTransitions.size(); i += 2)
+		arrNodes.push_back(border.arrTransitions[i]);
+}
+
+/**
+ @brief Add the tiles across a border from the entrances of a cluster. arrNodeIndices must be up to date for the cluster
+ @param cluster A Cluster& variable containing the cluster
+ @param border A const Border& variable containing the border
+ @param bFirst A const bool variable which is true if the cluster is the first cluster of this border
+ */
+void CClusterGraph::AddBorderCrossings(Cluster& cluster, const Border& border, const bool bFirst) const
+{
+	const unsigned int uiSide = bFirst ? 0 : 1;
+	for (unsigned int i = 0; i < border.arrTransitions.size(); i += 2)
+	{
+		const int iNodeIndex = arrNodeIndices[border.arrTransitions[i + uiSide]];
+		int* pCrossings = &cluster.arrCrossings[iNodeIndex * 2];
+		pCrossings[(pCrossings[0] < 0) ? 0 : 1] = border.arrTransitions[i + 1 - uiSide];
+	}
+}
+
+/**
+ @brief Breadth-first search inside a cluster, using the same moves and step cost as CPathFinder
+ @param cLevel A const CMapLevel& variable containing the level
+ @param cluster A const Cluster& variable containing the cluster to search in
+ @param iFrom A const int variable containing the tile to search from
+ */
+void CClusterGraph::SearchCluster(const CMapLevel& cLevel, const Cluster& cluster, const int iFrom)
+{
+	const int iWidth = cluster.iMaxX - cluster.iMinX;
+	const int iHeight = cluster.iMaxY - cluster.iMinY;
+	std::fill(arrLocalDistances.begin(), arrLocalDistances.begin() + iWidth * iHeight, -1);
+
+	const int iFromLocal = ((iFrom / (int)sMapSize.uiColSize) - cluster.iMinY) * iWidth +
+		(iFrom % sMapSize.uiColSize) - cluster.iMinX;
+	arrLocalDistances[iFromLocal] = 0;
+	arrLocalParents[iFromLocal] = iFromLocal;
+	arrLocalQueue[0] = iFromLocal;
+	int iHead = 0, iTail = 1;
+
+	while (iHead < iTail)
+	{
+		const int iCurrent = arrLocalQueue[iHead++];
+		const int iCurrentX = iCurrent % iWidth;
+		const int iCurrentY = iCurrent / iWidth;
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if ((iNeighborX < 0) || (iNeighborX >= iWidth) || (iNeighborY < 0) || (iNeighborY >= iHeight))
+				continue;
+			const int iNeighbor = iNeighborY * iWidth + iNeighborX;
+			if ((arrLocalDistances[iNeighbor] >= 0) ||
+				cLevel.IsBlocked(cluster.iMinY + iNeighborY, cluster.iMinX + iNeighborX))
+				continue;
+			arrLocalDistances[iNeighbor] = arrLocalDistances[iCurrent] + 1;
+			arrLocalParents[iNeighbor] = iCurrent;
+			arrLocalQueue[iTail++] = iNeighbor;
+		}
+	}
+}
+
+/**
+ @brief Get the distance to a tile found by the last SearchCluster(), or -1 if it was not reached
+ */
+int CClusterGraph::GetLocalDistance(const Cluster& cluster, const int iTile) const
+{
+	const int iWidth = cluster.iMaxX - cluster.iMinX;
+	return arrLocalDistances[((iTile / (int)sMapSize.uiColSize) - cluster.iMinY) * iWidth +
+		(iTile % sMapSize.uiColSize) - cluster.iMinX];
+}
+
+/**
+ @brief Get a node, resetting it if it was last touched by an older search
+ */
+CClusterGraph::Node& CClusterGraph::GetNode(const int iNode)
+{
+	Node& node = m_nodes[iNode];
+	if (node.uiGeneration != m_uiGeneration)
+	{
+		node.uiGeneration = m_uiGeneration;
+		node.g = 0;
+		node.iParent = -1;
+		node.bClosed = false;
+	}
+	return node;
+}
+
+/**
+ @brief Update a node if it is new or this path to it is shorter
+ */
+void CClusterGraph::Relax(const int iNode, const int iParent, const unsigned int g, const glm::vec2& targetPos,
+	const HeuristicFunction& heuristicFunc, const int weight)
+{
+	const bool bSeen = (m_nodes[iNode].uiGeneration == m_uiGeneration);
+	Node& node = GetNode(iNode);
+	if (node.bClosed)
+		return;
+
+	if (!bSeen || g < node.g)
+	{
+		node.g = g;
+		node.iParent = iParent;
+		const glm::vec2 pos((float)(iNode % sMapSize.uiColSize), (float)(iNode / sMapSize.uiColSize));
+		m_openList.Push(iNode, g + heuristicFunc(pos, targetPos, weight));
+	}
+}
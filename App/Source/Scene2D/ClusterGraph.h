@@ -0,0 +1,135 @@
+/**
+ CClusterGraph
+ @brief A class which splits a CMapLevel into square clusters for Hierarchical Path Finding (HPA*).
+		The entrances between clusters and the distances between the entrances of each cluster are
+		precomputed. Only the clusters touched by a changed blocking tile are rebuilt.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include PathFinder for the searches inside a cluster
+#include "PathFinder.h"
+
+#include <vector>
+
+class CClusterGraph
+{
+public:
+	// Constructor
+	CClusterGraph(void);
+
+	// Destructor
+	~CClusterGraph(void);
+
+	// Init the clusters for a level of this size
+	void Init(const unsigned int uiNumRows, const unsigned int uiNumCols, const unsigned int uiClusterSize = 10);
+
+	// Mark every cluster as out of date, e.g. after loading a new map
+	void Invalidate(void);
+
+	// Mark the clusters around a tile as out of date, after the tile became blocked or unblocked.
+	// The row is inverted (row 0 at the bottom), like the positions used for path finding
+	void OnTileChanged(const unsigned int uiRow, const unsigned int uiCol);
+
+	// Find a path in cLevel from startPos to targetPos, returning the same tile by tile path shape as CPathFinder::PathFind.
+	// Searches within one cluster, and searches which the cluster graph cannot answer, are passed to cPathFinder
+	std::vector<glm::vec2> PathFind(const CMapLevel& cLevel,
+									CPathFinder& cPathFinder,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									HeuristicFunction heuristicFunc,
+									int weight = 1);
+
+	// Get the number of abstract nodes expanded by the last call to PathFind()
+	unsigned int GetNumNodesExpanded(void) const;
+	// Get the number of clusters rebuilt by the last call to PathFind()
+	unsigned int GetNumClustersRebuilt(void) const;
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// A square area of the level, and the distances between its entrances
+	struct Cluster
+	{
+		int iMinX, iMinY;
+		int iMaxX, iMaxY;
+		// The tiles in this cluster which lead into a neighbouring cluster
+		std::vector<int> arrNodes;
+		// The distance between each pair of arrNodes, or UINT_MAX if one cannot reach the other inside this cluster
+		std::vector<unsigned int> arrDistances;
+		// The tiles across the borders from each of arrNodes, 2 per node (a corner tile can cross 2 borders), or -1
+		std::vector<int> arrCrossings;
+		bool bDirty;
+	};
+
+	// The entrances across the border between 2 clusters, stored as pairs of tiles:
+	// the tile in the left or lower cluster, then the tile in the right or upper cluster
+	struct Border
+	{
+		std::vector<int> arrTransitions;
+		bool bDirty;
+	};
+
+	// The A* data of an abstract node
+	struct Node
+	{
+		unsigned int uiGeneration;
+		unsigned int g;
+		int iParent;
+		bool bClosed;
+	};
+
+	// The size of the level
+	MapSize sMapSize;
+	// The width and height of a cluster, in tiles
+	unsigned int uiClusterSize;
+	// The number of clusters across and up the level
+	unsigned int uiNumClustersX;
+	unsigned int uiNumClustersY;
+	// The number of directions the cluster distances were computed for
+	unsigned int uiNrOfDirections;
+
+	std::vector<Cluster> arrClusters;
+	// The borders between each cluster and the cluster to its right
+	std::vector<Border> arrBordersX;
+	// The borders between each cluster and the cluster above it
+	std::vector<Border> arrBordersY;
+	// The index of each tile in the arrNodes of its cluster, or -1 if it is not an entrance
+	std::vector<int> arrNodeIndices;
+
+	// Lists for the A* search over the entrances
+	CIndexedHeap<unsigned int> m_openList;
+	std::vector<Node> m_nodes;
+	unsigned int m_uiGeneration;
+	unsigned int m_uiNumNodesExpanded;
+	unsigned int m_uiNumClustersRebuilt;
+
+	// The results of the last SearchCluster(), one entry per tile of the cluster
+	std::vector<int> arrLocalDistances;
+	std::vector<int> arrLocalParents;
+	std::vector<int> arrLocalQueue;
+
+	// Get the cluster which a position is in
+	int GetClusterIndex(const int iX, const int iY) const;
+	// Rebuild the borders and clusters which are out of date
+	void Rebuild(const CMapLevel& cLevel);
+	// Find the entrances across the border between 2 clusters
+	void BuildBorder(const CMapLevel& cLevel, Border& border, const bool bHorizontal, const int iClusterX, const int iClusterY);
+	// Collect the entrances of a cluster and compute the distances between them
+	void BuildCluster(const CMapLevel& cLevel, const int iCluster);
+	// Add the entrances of a cluster from one of its borders
+	void AddBorderNodes(std::vector<int>& arrNodes, const Border& border, const bool bFirst) const;
+	// Add the tiles across a border from the entrances of a cluster
+	void AddBorderCrossings(Cluster& cluster, const Border& border, const bool bFirst) const;
+	// Breadth-first search inside a cluster from a tile, filling arrLocalDistances and arrLocalParents
+	void SearchCluster(const CMapLevel& cLevel, const Cluster& cluster, const int iFrom);
+	// Get the distance to a tile found by the last SearchCluster(), or -1 if it was not reached
+	int GetLocalDistance(const Cluster& cluster, const int iTile) const;
+	// Get a node, resetting it if it was last touched by an older search
+	Node& GetNode(const int iNode);
+	// Update a node if this path to it is shorter
+	void Relax(const int iNode, const int iParent, const unsigned int g, const glm::vec2& targetPos,
+				const HeuristicFunction& heuristicFunc, const int weight);
+};
@@ -40,8 +40,14 @@ CEnemy2D::CEnemy2D(void)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
 	, sCurrentFSM(FSM::IDLE)
+	, bCanSeePlayer(false)
+	, bCanSeePet(false)
+	, bFlareDropped(false)
+	, uiFlareListenerID(0)
 	, iFSMCounter(0)
 	, quadMesh(NULL)
+	, uiPathRequestID(0)
+	, sPathRequestFSM(FSM::IDLE)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -73,6 +79,14 @@ CEnemy2D::~CEnemy2D(void)
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
 
+	// Stop the map from telling the planner about changed tiles, and drop the path request
+	if (cMap2D)
+	{
+		cMap2D->RemoveIncrementalPlanner(&cPlanner);
+		cMap2D->RemoveValueListener(uiFlareListenerID);
+		cMap2D->StopTimeSlicedSearch(&cHuntSearch);
+		CancelPathRequest();
+	}
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
@@ -99,14 +113,22 @@ bool CEnemy2D::Init(void)
 
 	// Get the handler to the CMap2D instance
 	cMap2D = CMap2D::GetInstance();
+	// Let the map tell the chase planner about changed tiles
+	cMap2D->AddIncrementalPlanner(&cPlanner);
+	// Let the map tell the enemy when a flare is dropped or erased, instead of looking for one every frame
+	bFlareDropped = cMap2D->GetValueCount(tiletype::FLARE_DROPPED) > 0;
+	uiFlareListenerID = cMap2D->AddValueListener(tiletype::FLARE_DROPPED, [this](const int iValue, const unsigned int, const unsigned int, const bool)
+	{
+		bFlareDropped = cMap2D->GetValueCount(iValue) > 0;
+	});
 	// Find the indices for the player in arrMapInfo, and assign it to cPlayer2D
 	unsigned int uiRow = -1;
 	unsigned int uiCol = -1;
-	if (cMap2D->FindValue(300, uiRow, uiCol) == false)
+	if (cMap2D->FindValue(tiletype::ENEMY_SPAWN, uiRow, uiCol) == false)
 		return false;	// Unable to find the start position of the player, so quit this game
 
 	// Erase the value of the player in the arrMapInfo
-	cMap2D->SetMapInfo(uiRow, uiCol, 0);
+	cMap2D->SetMapInfo(uiRow, uiCol, tiletype::EMPTY);
 
 	// Set the start position of the Player to iRow and iCol
 	vec2Index = glm::vec2(uiCol, uiRow);
@@ -150,15 +172,11 @@ void CEnemy2D::Update(const double dElapsedTime)
 {
 	v1 = rand() % 100;
 	cout << v1 << endl;
-	if (sCurrentFSM != FLAREFLLW)
+	if ((sCurrentFSM != FLAREFLLW) && bFlareDropped)
 	{
-		unsigned int uiRow = -1;
-		unsigned int uiCol = -1;
-		if (cMap2D->FindValue(3, uiRow, uiCol)) {
-			sCurrentFSM = FLAREFLLW;
-			flareOldIndex = cPlayer2D->flareIndex;
-			//cout << "Fllwing Flare :3" << endl;
-		}
+		sCurrentFSM = FLAREFLLW;
+		flareOldIndex = cPlayer2D->flareIndex;
+		//cout << "Fllwing Flare :3" << endl;
 	}
 	
 	if (cKeyboardController->IsKeyReleased(GLFW_KEY_SPACE))
@@ -168,10 +186,8 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			//Find player last location when they use the whistle
 			playerLast = cPlayer2D->vec2Index;
-			path = cMap2D->PathFind(vec2Index,
-				playerLast,
-				heuristic::manhattan,
-				10);
+			// Start searching towards it for HUNTING. The search runs over the next few frames
+			cMap2D->StartTimeSlicedSearch(&cHuntSearch, vec2Index, playerLast, heuristic::manhattan, 10);
 			iFSMCounter = 0;
 			sCurrentFSM = HUNTING;
 			cMap2D->PrintSelf();
@@ -181,6 +197,8 @@ void CEnemy2D::Update(const double dElapsedTime)
 	if (!bIsActive)
 		return;
 
+	UpdateVisibility();
+
 	switch (sCurrentFSM)
 	{
 	case IDLE:
@@ -208,9 +226,8 @@ void CEnemy2D::Update(const double dElapsedTime)
 			break;
 		}
 
-		//If player is close to the enemy
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 7.0f ||
-			cPhysics2D.CalculateDistance(vec2Index, cPet2D->vec2Index) < 7.0f)
+		//If player can be seen by the enemy
+		if (bCanSeePlayer || bCanSeePet)
 		{
 			sCurrentFSM = CHASE;
 			iFSMCounter = 0;
@@ -226,84 +243,28 @@ void CEnemy2D::Update(const double dElapsedTime)
 		iFSMCounter++;
 		break;
 	case CHASE:
-		//If Player & Pet is within Range OR Player is within range, chase the player
-		if ((cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 7.0f &&
-			cPhysics2D.CalculateDistance(vec2Index, cPet2D->vec2Index) < 7.0f) || 
-			cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 7.0f)
+		//If Player can be seen, chase the player
+		if (bCanSeePlayer)
 		{
 			cout << "DEMON CHASE: PLAYER" << endl;
 
-			path = cMap2D->PathFind(vec2Index,
-				cPlayer2D->vec2Index,
-				heuristic::euclidean,
-				10);
-
-			// Calculate new destination
-			bool bFirstPosition = true;
-			for (const auto& coord : path)
-			{
-				if (bFirstPosition == true)
-				{
-					// Set a destination
-					i32vec2Destination = coord;
-					// Calculate the direction between enemy2D and player2D
-					i32vec2Direction = i32vec2Destination - vec2Index;
-					bFirstPosition = false;
-				}
-				else
-				{
-					if ((coord - i32vec2Destination) == i32vec2Direction)
-					{
-						// Set a destination
-						i32vec2Destination = coord;
-					}
-					else 
-					{
-						break;
-					}
-				}
-			}
+			// Repair last frame's search towards the player, then follow it
+			if (cMap2D->Replan(cPlanner, vec2Index, cPlayer2D->vec2Index))
+				cPlanner.GetDestination(i32vec2Destination, i32vec2Direction);
 
 			// Update the Enemy2D's position for attack
 			UpdatePosition();
 
 			cSoundController->PlaySoundByID(5);
 		}
-		//If pet is within range but nothing else is, chase pet
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPet2D->vec2Index) < 7.0f)
+		//If pet can be seen but nothing else can, chase pet
+		else if (bCanSeePet)
 		{
 			cout << "DEMON CHASE: PLAYER" << endl;
 
-			path = cMap2D->PathFind(vec2Index,
-				cPet2D->vec2Index,
-				heuristic::euclidean,
-				10);
-
-			// Calculate new destination
-			bool bFirstPosition = true;
-			for (const auto& coord : path)
-			{
-				if (bFirstPosition == true)
-				{
-					// Set a destination
-					i32vec2Destination = coord;
-					// Calculate the direction between enemy2D and player2D
-					i32vec2Direction = i32vec2Destination - vec2Index;
-					bFirstPosition = false;
-				}
-				else
-				{
-					if ((coord - i32vec2Destination) == i32vec2Direction)
-					{
-						// Set a destination
-						i32vec2Destination = coord;
-					}
-					else
-					{
-						break;
-					}
-				}
-			}
+			// Repair last frame's search towards the pet, then follow it
+			if (cMap2D->Replan(cPlanner, vec2Index, cPet2D->vec2Index))
+				cPlanner.GetDestination(i32vec2Destination, i32vec2Direction);
 
 			// Update the Enemy2D's position for attack
 			UpdatePosition();
@@ -322,46 +283,19 @@ void CEnemy2D::Update(const double dElapsedTime)
 		cout << "DEMON HUNTING" << endl;
 
 		// follow last player location
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) > 7.0f)
+		if (!bCanSeePlayer)
 		{
-			path = cMap2D->PathFind(vec2Index,
-				playerLast,
-				heuristic::euclidean,
-				10);
-
-			bool bFirstPosition = true;
-			for (const auto& coord : path)
-			{
-				//std::cout << coord.x << "," << coord.y << "\n";
-
-				if (bFirstPosition == true)
-				{
-					// Set a destination
-					i32vec2Destination = coord;
-					// Calculate the direction between enemy2D and player2D
-					i32vec2Direction = i32vec2Destination - vec2Index;
-					bFirstPosition = false;
-				}
-				else
-				{
-					if ((coord - i32vec2Destination) == i32vec2Direction)
-					{
-						// Set a destination
-						i32vec2Destination = coord;
-					}
-					else
-					{
-						break;
-					}
-				}
-			}
+			// Search again from here if the best path found so far has moved away from the enemy
+			if ((cHuntSearch.GetStatus() != CTimeSlicedSearch::IDLE) && (!cHuntSearch.IsOnPath(vec2Index)))
+				cMap2D->StartTimeSlicedSearch(&cHuntSearch, vec2Index, playerLast, heuristic::manhattan, 10);
+			// Follow the path towards the last known player location, or towards the closest tile found so far
+			cHuntSearch.GetDestination(vec2Index, i32vec2Destination, i32vec2Direction);
 
 			UpdatePosition();
 		}
 		
 		// if the player is spotted, switch to chase
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 7.0f ||
-			cPhysics2D.CalculateDistance(vec2Index, cPet2D->vec2Index) < 7.0f)
+		else
 		{
 			sCurrentFSM = CHASE;
 			iFSMCounter = 0;
@@ -383,7 +317,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 	case FLAREFLLW:
 		if (iFSMCounter > fllwCounter)
 		{
-			cMap2D->SetMapInfo(cPlayer2D->flareIndex.y, cPlayer2D->flareIndex.x, 0);
+			cMap2D->SetMapInfo(cPlayer2D->flareIndex.y, cPlayer2D->flareIndex.x, tiletype::EMPTY);
 			sCurrentFSM = PATROL;
 			iFSMCounter = 0;
 
@@ -391,31 +325,20 @@ void CEnemy2D::Update(const double dElapsedTime)
 		}
 		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->flareIndex) > 1.0f)
 		{
-			path = cMap2D->PathFind(vec2Index,
-				flareOldIndex,
-				heuristic::euclidean,
-				10);
-
-			// Calculate new destination
-			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			// Search for the path towards the flare on the worker threads. It is followed when it arrives next frame
+			if (uiPathRequestID == 0)
 			{
-				if (bFirstPosition == true)
-				{
-					// Set a destination
-					flareOldIndex = coord;
-					bFirstPosition = false;
-				}
-				else
-				{
-					if ((coord - flareOldIndex) == i32vec2Direction)
+				uiPathRequestID = cMap2D->RequestPath(vec2Index,
+					flareOldIndex,
+					heuristic::euclidean,
+					10,
+					[this](const unsigned int, const std::vector<glm::vec2>& newPath)
 					{
-						// Set a destination
-						flareOldIndex = coord;
-					}
-					else
-						break;
-				}
+						uiPathRequestID = 0;
+						path = newPath;
+						FollowFlarePath();
+					});
+				sPathRequestFSM = FLAREFLLW;
 			}
 			UpdatePosition();
 		}
@@ -429,6 +352,12 @@ void CEnemy2D::Update(const double dElapsedTime)
 
 	InteractWithMap();
 
+	// A path requested in an FSM state which the enemy has left is no longer needed
+	if (sCurrentFSM != sPathRequestFSM)
+		CancelPathRequest();
+	if (sCurrentFSM != HUNTING)
+		cMap2D->StopTimeSlicedSearch(&cHuntSearch);
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
@@ -598,7 +527,7 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -608,8 +537,8 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y, vec2Index.x - 1))
 			{
 				return false;
 			}
@@ -629,7 +558,7 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -639,8 +568,8 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -661,7 +590,7 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -670,8 +599,8 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -692,7 +621,7 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -701,8 +630,8 @@ bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 		// If the new position is between 2 columns, then check both columns as well
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y - 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -867,7 +796,7 @@ void CEnemy2D::GenerateRandomPoint(void)
 		randx = rand() % ((int)cSettings->NUM_TILES_YAXIS - 1) + 1;
 		randy = rand() % ((int)cSettings->NUM_TILES_YAXIS - 1) + 1;
 
-		if (cMap2D->GetMapInfo(randy, randx) != 100)
+		if (!cMap2D->isBlocked(randy, randx))
 		{
 			glm::vec2 temp = glm::vec2(randx, randy);
 
@@ -875,11 +804,18 @@ void CEnemy2D::GenerateRandomPoint(void)
 			i32vec2Direction.x = 0;
 			i32vec2Direction.y = 0;
 
-			// Find player last location when hey use the whistle
-			path = cMap2D->PathFind(vec2Index,
+			// Search for the path to the patrol point on the worker threads
+			CancelPathRequest();
+			uiPathRequestID = cMap2D->RequestPath(vec2Index,
 				temp,
 				heuristic::manhattan,
-				20);
+				20,
+				[this](const unsigned int, const std::vector<glm::vec2>& newPath)
+				{
+					uiPathRequestID = 0;
+					path = newPath;
+				});
+			sPathRequestFSM = sCurrentFSM;
 			cout << "new random patrol point: " << temp.x << " , " << temp.y << endl;
 			break;
 		}
@@ -889,17 +825,72 @@ void CEnemy2D::GenerateRandomPoint(void)
 
 }
 
+/**
+ @brief Follow the path towards the flare which was delivered this frame.
+		The map hands out the turn points of the path, so the first one ends the first straight run
+ */
+void CEnemy2D::FollowFlarePath(void)
+{
+	// Set a destination
+	if (!path.empty())
+		flareOldIndex = path.front();
+}
+
+/**
+ @brief Cancel the path request which is waiting for its result
+ */
+void CEnemy2D::CancelPathRequest(void)
+{
+	if (uiPathRequestID != 0)
+	{
+		cMap2D->CancelPathRequest(uiPathRequestID);
+		uiPathRequestID = 0;
+	}
+}
+
+/**
+ @brief Check if the player and the pet can be seen this frame.
+		Only the ones within sight range are checked for a blocking tile in between, both in one call to the map
+ */
+void CEnemy2D::UpdateVisibility(void)
+{
+	LineOfSightQuery arrQueries[2];
+	bool arrbResults[2] = { false, false };
+	unsigned int uiNumQueries = 0;
+
+	const bool bPlayerInRange = cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < fSightRange;
+	if (bPlayerInRange)
+	{
+		arrQueries[uiNumQueries].observerPos = vec2Index;
+		arrQueries[uiNumQueries].targetPos = cPlayer2D->vec2Index;
+		uiNumQueries++;
+	}
+	const bool bPetInRange = cPhysics2D.CalculateDistance(vec2Index, cPet2D->vec2Index) < fSightRange;
+	if (bPetInRange)
+	{
+		arrQueries[uiNumQueries].observerPos = vec2Index;
+		arrQueries[uiNumQueries].targetPos = cPet2D->vec2Index;
+		uiNumQueries++;
+	}
+
+	if (uiNumQueries > 0)
+		cMap2D->HasLineOfSight(arrQueries, uiNumQueries, arrbResults);
+
+	bCanSeePlayer = bPlayerInRange && arrbResults[0];
+	bCanSeePet = bPetInRange && arrbResults[bPlayerInRange ? 1 : 0];
+}
+
 void CEnemy2D::InteractWithMap(void)
 {
-	switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x))
+	switch (tiletype::GetHandler(cMap2D->GetMapItem(vec2Index.y, vec2Index.x)))
 	{
-	case 3: // Flare Dropped
+	case tiletype::HANDLER_EAT_FLARE:
 		// Erase the flare from this position
-		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 0);
+		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::EMPTY);
 		break;
-	case 5: // Cereal Dropped
+	case tiletype::HANDLER_EAT_CEREAL:
 		// Erase the cereal from this position
-		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 0);
+		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::EMPTY);
 		// Insert Stun Code Here
 		sCurrentFSM = STUNNED;
 		//cout << "Switching to Enemy::STUNNED State" << endl;
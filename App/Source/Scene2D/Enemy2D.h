@@ -32,6 +32,12 @@ class CMap2D;
 // Include Pet2D
 #include "Pet2D.h"
 
+// Include IncrementalPlanner for chasing a moving target
+#include "IncrementalPlanner.h"
+
+// Include TimeSlicedSearch for hunting the last known player location
+#include "TimeSlicedSearch.h"
+
 class CEnemy2D : public CSingletonTemplate<CEnemy2D>, public CEntity2D
 {
 public:
@@ -113,9 +119,19 @@ protected:
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
 
-	// Current generated A* pathfinding route
+	// Current generated A* pathfinding route, as the tiles where it turns
 	vector<glm::vec2> path;
 
+	// The search towards the chased player or pet, repaired between frames instead of searched again
+	CIncrementalPlanner cPlanner;
+
+	// The search towards the last known player location, which the map runs a few nodes per frame
+	CTimeSlicedSearch cHuntSearch;
+
+	// The ID of the path request waiting for its result, or 0 if there is none, and the FSM state which made it
+	unsigned int uiPathRequestID;
+	FSM sPathRequestFSM;
+
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
 
@@ -167,6 +183,14 @@ protected:
 	// Current FSM
 	FSM sCurrentFSM;
 
+	// Whether the player and the pet are within sight range, with no blocking tile in between, this frame
+	bool bCanSeePlayer;
+	bool bCanSeePet;
+
+	// Whether a flare is on the map, kept up to date by the map, and the ID of the listener which does it
+	bool bFlareDropped;
+	unsigned int uiFlareListenerID;
+
 	float enemySpeed = 1.4f;
 
 	// FSM counter - count how many frames it has been in this FSM
@@ -178,6 +202,8 @@ protected:
 	const int eSoundPlay = 270;
 	const int stunnedCounter = 210;
 	const int fllwCounter = 210;
+	// How far the enemy2D can see, in tiles
+	const float fSightRange = 7.0f;
 
 	// Constraint the enemy2D's position within a boundary
 	void Constraint(DIRECTION eDirection = LEFT);
@@ -206,6 +232,15 @@ protected:
 
 	void GenerateRandomPoint(void);
 
+	// Follow the path towards the flare which was delivered this frame
+	void FollowFlarePath(void);
+
+	// Cancel the path request which is waiting for its result
+	void CancelPathRequest(void);
+
+	// Check if the player and the pet can be seen this frame
+	void UpdateVisibility(void);
+
 	// Let player interact with the map
 	void InteractWithMap(void);
 
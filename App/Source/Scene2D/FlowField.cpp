@@ -0,0 +1,183 @@
+/**
+ CFlowField
+ @brief A class which stores the distance from every tile of a CMapLevel to a target tile,
+		so that any number of agents can look up their next step towards the target in O(1)
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "FlowField.h"
+
+/**
+ @brief Constructor
+ */
+CFlowField::CFlowField(void)
+	: pLevel(NULL)
+	, targetPos(0, 0)
+	, uiNrOfDirections(4)
+	, bValid(false)
+	, uiNumComputes(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CFlowField::~CFlowField(void)
+{
+	// We won't delete this since it was created elsewhere
+	pLevel = NULL;
+}
+
+/**
+ @brief Compute the distances to a target with a breadth-first search outwards from the target.
+		Every step costs 1, like in CPathFinder::PathFind.
+ @param cLevel A const CMapLevel& variable containing the level
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+void CFlowField::Compute(const CMapLevel& cLevel, const glm::vec2& targetPos, const unsigned int uiNrOfDirections)
+{
+	pLevel = &cLevel;
+	this->targetPos = targetPos;
+	this->uiNrOfDirections = uiNrOfDirections;
+	sMapSize.uiRowSize = cLevel.GetNumRows();
+	sMapSize.uiColSize = cLevel.GetNumCols();
+	bValid = true;
+	uiNumComputes++;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const unsigned int uiNumTiles = sMapSize.uiRowSize * sMapSize.uiColSize;
+	arrDistances.assign(uiNumTiles, -1);
+	arrNextDirections.assign(uiNumTiles, -1);
+	arrQueue.resize(uiNumTiles);
+
+	const int iTarget = ConvertTo1D(targetPos);
+	if ((iTarget < 0) || !CJumpTable::IsFree(cLevel, (int)targetPos.x, (int)targetPos.y))
+		return;
+
+	arrDistances[iTarget] = 0;
+	arrQueue[0] = iTarget;
+	unsigned int uiHead = 0, uiTail = 1;
+	while (uiHead < uiTail)
+	{
+		const int iCurrent = arrQueue[uiHead++];
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+				continue;
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			if (arrDistances[iNeighbor] >= 0)
+				continue;
+
+			// The neighbour's next step is back the opposite way
+			arrDistances[iNeighbor] = arrDistances[iCurrent] + 1;
+			arrNextDirections[iNeighbor] = (signed char)GetDirectionIndex(-iDirectionX[i], -iDirectionY[i]);
+			arrQueue[uiTail++] = iNeighbor;
+		}
+	}
+}
+
+/**
+ @brief Mark the distances as out of date
+ */
+void CFlowField::Invalidate(void)
+{
+	bValid = false;
+}
+
+/**
+ @brief Check if the distances are up to date for this level, target and number of directions
+ */
+bool CFlowField::IsValid(const CMapLevel& cLevel, const glm::vec2& targetPos, const unsigned int uiNrOfDirections) const
+{
+	return bValid && (pLevel == &cLevel) && (this->targetPos == targetPos) &&
+		(this->uiNrOfDirections == uiNrOfDirections) &&
+		(sMapSize.uiRowSize == cLevel.GetNumRows()) && (sMapSize.uiColSize == cLevel.GetNumCols());
+}
+
+/**
+ @brief Get the level which the distances were computed for
+ */
+const CMapLevel* CFlowField::GetLevel(void) const
+{
+	return pLevel;
+}
+
+/**
+ @brief Get the target which the distances were computed for
+ */
+glm::vec2 CFlowField::GetTarget(void) const
+{
+	return targetPos;
+}
+
+/**
+ @brief Get the number of steps from a position to the target
+ @param pos A const glm::vec2& variable containing the position
+ */
+int CFlowField::GetDistance(const glm::vec2& pos) const
+{
+	const int iIndex = ConvertTo1D(pos);
+	if (iIndex < 0)
+		return -1;
+	return arrDistances[iIndex];
+}
+
+/**
+ @brief Get the next tile from a position towards the target
+ @param pos A const glm::vec2& variable containing the position
+ @param nextPos A glm::vec2& variable which will store the next tile
+ */
+bool CFlowField::GetNextStep(const glm::vec2& pos, glm::vec2& nextPos) const
+{
+	const int iIndex = ConvertTo1D(pos);
+	if ((iIndex < 0) || (arrNextDirections[iIndex] < 0))
+		return false;
+
+	const int iDirection = arrNextDirections[iIndex];
+	nextPos = glm::vec2(pos.x + iDirectionX[iDirection], pos.y + iDirectionY[iDirection]);
+	return true;
+}
+
+/**
+ @brief Get the furthest tile which can be reached from a position by repeating its next step.
+		This is the same destination the agents used to take from the first straight run of a path.
+ @param pos A const glm::vec2& variable containing the position
+ @param destination A glm::vec2& variable which will store the furthest tile
+ @param direction A glm::vec2& variable which will store the direction of the step
+ */
+bool CFlowField::GetDestination(const glm::vec2& pos, glm::vec2& destination, glm::vec2& direction) const
+{
+	if (!GetNextStep(pos, destination))
+		return false;
+	direction = destination - pos;
+
+	glm::vec2 nextPos;
+	while (GetNextStep(destination, nextPos) && ((nextPos - destination) == direction))
+		destination = nextPos;
+	return true;
+}
+
+/**
+ @brief Get the number of times the distances were computed
+ */
+unsigned int CFlowField::GetNumComputes(void) const
+{
+	return uiNumComputes;
+}
+
+/**
+ @brief Convert a position to a 1D index, or -1 if it is outside the level
+ */
+int CFlowField::ConvertTo1D(const glm::vec2& pos) const
+{
+	if ((pos.x < 0) || (pos.x >= sMapSize.uiColSize) || (pos.y < 0) || (pos.y >= sMapSize.uiRowSize))
+		return -1;
+	return (int)pos.y * sMapSize.uiColSize + (int)pos.x;
+}
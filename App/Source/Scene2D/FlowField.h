@@ -0,0 +1,76 @@
+/**
+ CFlowField
+ @brief A class which stores the distance from every tile of a CMapLevel to a target tile,
+		so that any number of agents can look up their next step towards the target in O(1)
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include JumpTable for the directions and the free tile check
+#include "JumpTable.h"
+
+#include <vector>
+
+class CFlowField
+{
+public:
+	// Constructor
+	CFlowField(void);
+
+	// Destructor
+	~CFlowField(void);
+
+	// Compute the distances to targetPos over cLevel, moving in 4 or 8 directions
+	void Compute(const CMapLevel& cLevel, const glm::vec2& targetPos, const unsigned int uiNrOfDirections);
+
+	// Mark the distances as out of date, e.g. when a blocking tile has changed
+	void Invalidate(void);
+
+	// Check if the distances are up to date for this level, target and number of directions
+	bool IsValid(const CMapLevel& cLevel, const glm::vec2& targetPos, const unsigned int uiNrOfDirections) const;
+
+	// Get the level which the distances were computed for
+	const CMapLevel* GetLevel(void) const;
+	// Get the target which the distances were computed for
+	glm::vec2 GetTarget(void) const;
+
+	// Get the number of steps from a position to the target, or -1 if the target cannot be reached
+	int GetDistance(const glm::vec2& pos) const;
+
+	// Get the next tile from a position towards the target. Returns false if there is none
+	bool GetNextStep(const glm::vec2& pos, glm::vec2& nextPos) const;
+
+	// Get the furthest tile which can be reached from a position by repeating its next step,
+	// and the direction of that step. Returns false if the position has no next step
+	bool GetDestination(const glm::vec2& pos, glm::vec2& destination, glm::vec2& direction) const;
+
+	// Get the number of times the distances were computed
+	unsigned int GetNumComputes(void) const;
+
+protected:
+	// The level, target and number of directions the distances were computed for
+	const CMapLevel* pLevel;
+	glm::vec2 targetPos;
+	unsigned int uiNrOfDirections;
+	bool bValid;
+
+	// The size of the level
+	MapSize sMapSize;
+
+	// The distance from each tile to the target, or -1 if the target cannot be reached
+	std::vector<int> arrDistances;
+	// The direction of the next step from each tile, or -1 if there is none
+	std::vector<signed char> arrNextDirections;
+	// The breadth-first search queue
+	std::vector<int> arrQueue;
+
+	// The number of times the distances were computed
+	unsigned int uiNumComputes;
+
+	// Convert a position to a 1D index, or -1 if it is outside the level
+	int ConvertTo1D(const glm::vec2& pos) const;
+};
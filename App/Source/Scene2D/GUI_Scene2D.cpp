@@ -6,6 +6,9 @@
  */
 #include "GUI_Scene2D.h"
 
+// Include Map2D for the path cache counters
+#include "Map2D.h"
+
 #include <iostream>
 using namespace std;
 
@@ -15,6 +18,7 @@ using namespace std;
 CGUI_Scene2D::CGUI_Scene2D(void)
 	: cSettings(NULL)
 	, m_fProgressBar(0.0f)
+	, cMap2D(NULL)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
 {
@@ -38,6 +42,7 @@ CGUI_Scene2D::~CGUI_Scene2D(void)
 
 	// We won't delete this since it was created elsewhere
 	cSettings = NULL;
+	cMap2D = NULL;
 }
 
 /**
@@ -51,6 +56,9 @@ bool CGUI_Scene2D::Init(void)
 	// Store the CFPSCounter singleton instance here
 	cFPSCounter = CFPSCounter::GetInstance();
 
+	// Get the handler to the CMap2D instance
+	cMap2D = CMap2D::GetInstance();
+
 	// Setup Dear ImGui context
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
@@ -124,6 +132,10 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	// Display the FPS
 	ImGui::TextColored(ImVec4(1, 1, 0, 1), "FPS: %d", cFPSCounter->GetFrameRate());
 
+	// Display how many paths were found in the path cache
+	ImGui::TextColored(ImVec4(1, 1, 0, 1), "Path cache: %u hits / %u misses",
+		cMap2D->GetPathCache().GetNumHits(), cMap2D->GetPathCache().GetNumMisses());
+
 	// Render the Health
 	//ImGuiWindowFlags healthWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
 	//	ImGuiWindowFlags_NoBackground |
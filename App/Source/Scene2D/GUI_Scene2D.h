@@ -40,6 +40,9 @@
 
 #include "GameControl/Settings.h"
 
+// Include CMap2D
+class CMap2D;
+
 #include <string>
 using namespace std;
 
@@ -83,6 +86,9 @@ protected:
 
 	CSettings* cSettings;
 
+	// Handler to the CMap2D instance
+	CMap2D* cMap2D;
+
 	// The handler containing the instance of CInventoryManager
 	CInventoryManager* cInventoryManager;
 	// The handler containing the instance of CInventoryItem
@@ -0,0 +1,500 @@
+/**
+ CIncrementalPlanner
+ @brief A class which plans a path for one agent with a moving target D* Lite, and keeps its search between calls.
+		The search runs from the agent, so when the target moves or a blocking tile changes,
+		only the nodes whose distance from the agent changed, or which the search has not reached yet, are expanded.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "IncrementalPlanner.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// The distance of a node which cannot be reached. Small enough that adding the key terms cannot overflow
+static const int INFINITE_DISTANCE = INT_MAX / 4;
+
+/**
+ @brief Constructor
+ */
+CIncrementalPlanner::CIncrementalPlanner(void)
+	: pLevel(NULL)
+	, iStart(-1)
+	, iTarget(-1)
+	, uiNrOfDirections(4)
+	, bValid(false)
+	, m_uiGeneration(0)
+	, iKeyModifier(0)
+	, m_uiNumNodesExpanded(0)
+	, m_uiTotalNodesExpanded(0)
+	, m_uiNumReplans(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CIncrementalPlanner::~CIncrementalPlanner(void)
+{
+	// We won't delete this since it was created elsewhere
+	pLevel = NULL;
+}
+
+/**
+ @brief Update the search for an agent chasing a target.
+		A moved target only offsets the keys in the open list, and a changed tile only updates the nodes around it.
+		When the agent steps onto another tile, the distances from it are all different, so a new search is started.
+ @param cLevel A const CMapLevel& variable containing the level
+ @param startPos A const glm::vec2& variable containing the position of the agent
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+bool CIncrementalPlanner::Replan(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, const unsigned int uiNrOfDirections)
+{
+	m_uiNumNodesExpanded = 0;
+	m_uiNumReplans++;
+
+	if (!bValid || (pLevel != &cLevel) || (this->uiNrOfDirections != uiNrOfDirections) ||
+		(sMapSize.uiRowSize != cLevel.GetNumRows()) || (sMapSize.uiColSize != cLevel.GetNumCols()))
+	{
+		pLevel = &cLevel;
+		this->uiNrOfDirections = uiNrOfDirections;
+		if ((sMapSize.uiRowSize != cLevel.GetNumRows()) || (sMapSize.uiColSize != cLevel.GetNumCols()))
+		{
+			sMapSize.uiRowSize = cLevel.GetNumRows();
+			sMapSize.uiColSize = cLevel.GetNumCols();
+
+			Node node;
+			node.uiGeneration = 0;
+			node.g = INFINITE_DISTANCE;
+			node.rhs = INFINITE_DISTANCE;
+			m_nodes.assign(sMapSize.uiRowSize * sMapSize.uiColSize, node);
+			arrTileChanged.assign(sMapSize.uiRowSize * sMapSize.uiColSize, 0);
+			m_openList.Init(sMapSize.uiRowSize * sMapSize.uiColSize);
+			m_uiGeneration = 0;
+		}
+		iStart = -1;
+		bValid = true;
+	}
+
+	const int iNewStart = ConvertTo1D(startPos);
+	const int iNewTarget = ConvertTo1D(targetPos);
+	if ((iNewStart < 0) || (iNewTarget < 0) || !IsFree(iNewStart) || !IsFree(iNewTarget))
+	{
+		m_path.clear();
+		return false;
+	}
+
+	if (iNewStart != iStart)
+	{
+		iTarget = iNewTarget;
+		NewSearch(iNewStart);
+	}
+	else
+	{
+		// The keys in the open list were computed with the heuristic to the old target.
+		// Adding how far the target moved keeps them lower bounds, so they do not need to be recomputed
+		if (iNewTarget != iTarget)
+		{
+			iKeyModifier += GetHeuristic(iTarget, iNewTarget);
+			iTarget = iNewTarget;
+		}
+
+		// A changed tile changes the cost of moving onto it, and so the distances of its neighbours
+		const int iNumCols = (int)sMapSize.uiColSize;
+		for (unsigned int i = 0; i < arrChangedTiles.size(); i++)
+		{
+			const int iTile = arrChangedTiles[i];
+			const int iTileX = iTile % iNumCols;
+			const int iTileY = iTile / iNumCols;
+			UpdateNode(iTile);
+			for (unsigned int j = 0; j < uiNrOfDirections; j++)
+			{
+				const int iNeighbor = ConvertTo1D(glm::vec2(iTileX + iDirectionX[j], iTileY + iDirectionY[j]));
+				if (iNeighbor >= 0)
+					UpdateNode(iNeighbor);
+			}
+		}
+	}
+	ClearChangedTiles();
+
+	ComputeShortestPath();
+	m_uiTotalNodesExpanded += m_uiNumNodesExpanded;
+	BuildPath();
+
+	return GetDistance(iTarget) < INFINITE_DISTANCE;
+}
+
+/**
+ @brief Replan and return the path
+ @param cLevel A const CMapLevel& variable containing the level
+ @param startPos A const glm::vec2& variable containing the position of the agent
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+std::vector<glm::vec2> CIncrementalPlanner::PathFind(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, const unsigned int uiNrOfDirections)
+{
+	std::vector<glm::vec2> path;
+	if (!Replan(cLevel, startPos, targetPos, uiNrOfDirections))
+		return path;
+	path = m_path;
+
+	// If the path has only 1 entry, then it is the the target position
+	// This is only OK if startPos is next to targetPos
+	if ((path.size() == 1) && (abs(targetPos.y - startPos.y) + abs(targetPos.x - startPos.x) > 1))
+		path.clear();
+
+	return path;
+}
+
+/**
+ @brief Get the furthest tile which the agent can reach in one straight run along the last planned path
+ @param destination A glm::vec2& variable which will store the furthest tile
+ @param direction A glm::vec2& variable which will store the direction of the run
+ */
+bool CIncrementalPlanner::GetDestination(glm::vec2& destination, glm::vec2& direction) const
+{
+	if (m_path.empty())
+		return false;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const glm::vec2 startPos(iStart % iNumCols, iStart / iNumCols);
+	destination = m_path[0];
+	direction = destination - startPos;
+	for (unsigned int i = 1; (i < m_path.size()) && ((m_path[i] - destination) == direction); i++)
+		destination = m_path[i];
+	return true;
+}
+
+/**
+ @brief Tell the planner that a tile became blocked or unblocked
+ @param uiRow A const unsigned int variable containing the inverted row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CIncrementalPlanner::OnTileChanged(const unsigned int uiRow, const unsigned int uiCol)
+{
+	if (!bValid || (uiRow >= sMapSize.uiRowSize) || (uiCol >= sMapSize.uiColSize))
+		return;
+
+	const int iTile = uiRow * sMapSize.uiColSize + uiCol;
+	if (arrTileChanged[iTile])
+		return;
+	arrTileChanged[iTile] = 1;
+	arrChangedTiles.push_back(iTile);
+
+	// Repairing this many tiles costs more than searching again, so throw the search away instead
+	if (arrChangedTiles.size() > m_nodes.size() / 8)
+		Invalidate();
+}
+
+/**
+ @brief Throw away the search
+ */
+void CIncrementalPlanner::Invalidate(void)
+{
+	bValid = false;
+	ClearChangedTiles();
+}
+
+/**
+ @brief Get the level which the search is running over
+ */
+const CMapLevel* CIncrementalPlanner::GetLevel(void) const
+{
+	return pLevel;
+}
+
+/**
+ @brief Get the number of nodes expanded by the last call to Replan()
+ */
+unsigned int CIncrementalPlanner::GetNumNodesExpanded(void) const
+{
+	return m_uiNumNodesExpanded;
+}
+
+/**
+ @brief Get the number of nodes expanded by all calls to Replan()
+ */
+unsigned int CIncrementalPlanner::GetTotalNodesExpanded(void) const
+{
+	return m_uiTotalNodesExpanded;
+}
+
+/**
+ @brief Get the number of calls to Replan()
+ */
+unsigned int CIncrementalPlanner::GetNumReplans(void) const
+{
+	return m_uiNumReplans;
+}
+
+/**
+ @brief Print out details about this class instance in the console window
+ */
+void CIncrementalPlanner::PrintSelf(void) const
+{
+	cout << "CIncrementalPlanner::PrintSelf()" << endl;
+	cout << "m_uiNumNodesExpanded: " << m_uiNumNodesExpanded << endl;
+	cout << "m_uiTotalNodesExpanded: " << m_uiTotalNodesExpanded << endl;
+	cout << "m_uiNumReplans: " << m_uiNumReplans << endl;
+	if (m_uiNumReplans > 0)
+		cout << "Nodes expanded per replan: " << (float)m_uiTotalNodesExpanded / m_uiNumReplans << endl;
+}
+
+/**
+ @brief Empty the list of changed tiles, and clear their flags
+ */
+void CIncrementalPlanner::ClearChangedTiles(void)
+{
+	for (unsigned int i = 0; i < arrChangedTiles.size(); i++)
+		arrTileChanged[arrChangedTiles[i]] = 0;
+	arrChangedTiles.clear();
+}
+
+/**
+ @brief Start a new search from a start node
+ @param iNewStart A const int variable containing the start node
+ */
+void CIncrementalPlanner::NewSearch(const int iNewStart)
+{
+	m_openList.Clear();
+	iKeyModifier = 0;
+	iStart = iNewStart;
+	m_uiGeneration++;
+
+	// If the generation counter wrapped around, then the old stamps could match again
+	if (m_uiGeneration == 0)
+	{
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			m_nodes[i].uiGeneration = 0;
+		m_uiGeneration = 1;
+	}
+
+	GetNode(iStart).rhs = 0;
+	UpdateOpenList(iStart);
+}
+
+/**
+ @brief Expand nodes until the target has the lowest key and its 2 distances agree
+ */
+void CIncrementalPlanner::ComputeShortestPath(void)
+{
+	while (!m_openList.Empty() &&
+		((m_openList.TopKey() < CalculateKey(iTarget)) || (GetNode(iTarget).rhs != GetNode(iTarget).g)))
+	{
+		const int iNode = m_openList.Top();
+		const Key oldKey = m_openList.TopKey();
+		const Key newKey = CalculateKey(iNode);
+
+		// The key was computed before the target moved, so put it back with its up to date key
+		if (oldKey < newKey)
+		{
+			m_openList.Update(iNode, newKey);
+			continue;
+		}
+
+		m_openList.Pop();
+		m_uiNumNodesExpanded++;
+
+		const int iNumCols = (int)sMapSize.uiColSize;
+		const int iNodeX = iNode % iNumCols;
+		const int iNodeY = iNode / iNumCols;
+		Node& node = GetNode(iNode);
+		if (node.g > node.rhs)
+		{
+			// The distance went down, so the neighbours may now be closer to the agent through this node
+			node.g = node.rhs;
+			for (unsigned int i = 0; i < uiNrOfDirections; i++)
+			{
+				const int iNeighbor = ConvertTo1D(glm::vec2(iNodeX + iDirectionX[i], iNodeY + iDirectionY[i]));
+				if ((iNeighbor < 0) || (iNeighbor == iStart) || !IsFree(iNeighbor))
+					continue;
+				Node& neighborNode = GetNode(iNeighbor);
+				if (node.g + 1 < neighborNode.rhs)
+				{
+					neighborNode.rhs = node.g + 1;
+					UpdateOpenList(iNeighbor);
+				}
+			}
+		}
+		else
+		{
+			// The distance went up, so this node and the neighbours which went through it must be recomputed
+			node.g = INFINITE_DISTANCE;
+			UpdateNode(iNode);
+			for (unsigned int i = 0; i < uiNrOfDirections; i++)
+			{
+				const int iNeighbor = ConvertTo1D(glm::vec2(iNodeX + iDirectionX[i], iNodeY + iDirectionY[i]));
+				if (iNeighbor >= 0)
+					UpdateNode(iNeighbor);
+			}
+		}
+	}
+}
+
+/**
+ @brief Build m_path by stepping back from the target to the neighbour closest to the agent, until the agent is reached
+ */
+void CIncrementalPlanner::BuildPath(void)
+{
+	m_path.clear();
+	if (GetDistance(iTarget) >= INFINITE_DISTANCE)
+		return;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	int iCurrent = iTarget;
+	while (iCurrent != iStart)
+	{
+		m_path.push_back(glm::vec2(iCurrent % iNumCols, iCurrent / iNumCols));
+
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		int iPrevious = -1;
+		int iLowest = GetDistance(iCurrent);
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+		{
+			const int iNeighbor = ConvertTo1D(glm::vec2(iCurrentX + iDirectionX[i], iCurrentY + iDirectionY[i]));
+			if ((iNeighbor >= 0) && IsFree(iNeighbor) && (GetDistance(iNeighbor) < iLowest))
+			{
+				iLowest = GetDistance(iNeighbor);
+				iPrevious = iNeighbor;
+			}
+		}
+		if (iPrevious < 0)
+		{
+			m_path.clear();
+			return;
+		}
+		iCurrent = iPrevious;
+	}
+	std::reverse(m_path.begin(), m_path.end());
+}
+
+/**
+ @brief Get a node, resetting it if it was last touched by an older search
+ @param iNode A const int variable containing the node
+ */
+CIncrementalPlanner::Node& CIncrementalPlanner::GetNode(const int iNode)
+{
+	Node& node = m_nodes[iNode];
+	if (node.uiGeneration != m_uiGeneration)
+	{
+		node.uiGeneration = m_uiGeneration;
+		node.g = INFINITE_DISTANCE;
+		node.rhs = INFINITE_DISTANCE;
+	}
+	return node;
+}
+
+/**
+ @brief Get the distance of a node from the agent as of its last expansion
+ @param iNode A const int variable containing the node
+ */
+int CIncrementalPlanner::GetDistance(const int iNode) const
+{
+	const Node& node = m_nodes[iNode];
+	return node.uiGeneration == m_uiGeneration ? node.g : INFINITE_DISTANCE;
+}
+
+/**
+ @brief Recompute the distance of a node from its neighbours, then update the open list
+ @param iNode A const int variable containing the node
+ */
+void CIncrementalPlanner::UpdateNode(const int iNode)
+{
+	Node& node = GetNode(iNode);
+	if (iNode == iStart)
+		node.rhs = 0;
+	else if (!IsFree(iNode))
+		node.rhs = INFINITE_DISTANCE;
+	else
+		node.rhs = GetLowestNeighbourDistance(iNode);
+	UpdateOpenList(iNode);
+}
+
+/**
+ @brief Put a node in the open list if its 2 distances differ, or take it out if they are the same
+ @param iNode A const int variable containing the node
+ */
+void CIncrementalPlanner::UpdateOpenList(const int iNode)
+{
+	const Node& node = GetNode(iNode);
+	if (node.g != node.rhs)
+		m_openList.Push(iNode, CalculateKey(iNode));
+	else
+		m_openList.Remove(iNode);
+}
+
+/**
+ @brief Get the lowest distance from the agent through the neighbours of a node
+ @param iNode A const int variable containing the node
+ */
+int CIncrementalPlanner::GetLowestNeighbourDistance(const int iNode) const
+{
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iNodeX = iNode % iNumCols;
+	const int iNodeY = iNode / iNumCols;
+	int iLowest = INFINITE_DISTANCE;
+	for (unsigned int i = 0; i < uiNrOfDirections; i++)
+	{
+		const int iNeighbor = ConvertTo1D(glm::vec2(iNodeX + iDirectionX[i], iNodeY + iDirectionY[i]));
+		if ((iNeighbor >= 0) && IsFree(iNeighbor) && (GetDistance(iNeighbor) + 1 < iLowest))
+			iLowest = GetDistance(iNeighbor) + 1;
+	}
+	return iLowest;
+}
+
+/**
+ @brief Get the priority of a node: the lowest possible length of a path to the target through it, then its distance
+ @param iNode A const int variable containing the node
+ */
+CIncrementalPlanner::Key CIncrementalPlanner::CalculateKey(const int iNode)
+{
+	const Node& node = GetNode(iNode);
+	const int iDistance = node.g < node.rhs ? node.g : node.rhs;
+	Key key;
+	key.k1 = iDistance + GetHeuristic(iNode, iTarget) + iKeyModifier;
+	key.k2 = iDistance;
+	return key;
+}
+
+/**
+ @brief Get the lower bound of the number of steps between 2 nodes. Diagonal steps cost 1, like straight steps
+ @param iFrom A const int variable containing the first node
+ @param iTo A const int variable containing the second node
+ */
+int CIncrementalPlanner::GetHeuristic(const int iFrom, const int iTo) const
+{
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iDeltaX = abs(iFrom % iNumCols - iTo % iNumCols);
+	const int iDeltaY = abs(iFrom / iNumCols - iTo / iNumCols);
+	if (uiNrOfDirections == 8)
+		return iDeltaX > iDeltaY ? iDeltaX : iDeltaY;
+	return iDeltaX + iDeltaY;
+}
+
+/**
+ @brief Check if a node can be walked on
+ @param iNode A const int variable containing the node
+ */
+bool CIncrementalPlanner::IsFree(const int iNode) const
+{
+	const int iNumCols = (int)sMapSize.uiColSize;
+	return CJumpTable::IsFree(*pLevel, iNode % iNumCols, iNode / iNumCols);
+}
+
+/**
+ @brief Convert a position to a 1D index, or -1 if it is outside the level
+ */
+int CIncrementalPlanner::ConvertTo1D(const glm::vec2& pos) const
+{
+	if ((pos.x < 0) || (pos.x >= sMapSize.uiColSize) || (pos.y < 0) || (pos.y >= sMapSize.uiRowSize))
+		return -1;
+	return (int)pos.y * sMapSize.uiColSize + (int)pos.x;
+}
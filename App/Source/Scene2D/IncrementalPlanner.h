@@ -0,0 +1,140 @@
+/**
+ CIncrementalPlanner
+ @brief A class which plans a path for one agent with a moving target D* Lite, and keeps its search between calls.
+		The search runs from the agent, so when the target moves or a blocking tile changes,
+		only the nodes whose distance from the agent changed, or which the search has not reached yet, are expanded.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include IndexedHeap for the open list
+#include "IndexedHeap.h"
+// Include JumpTable for the directions and the free tile check
+#include "JumpTable.h"
+
+#include <vector>
+
+class CIncrementalPlanner
+{
+public:
+	// Constructor
+	CIncrementalPlanner(void);
+
+	// Destructor
+	~CIncrementalPlanner(void);
+
+	// Update the search for an agent at startPos chasing targetPos over cLevel, moving in 4 or 8 directions.
+	// Returns true if the target can be reached. The search is started again if the level or number of directions changed
+	bool Replan(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, const unsigned int uiNrOfDirections);
+
+	// Replan and return the same tile by tile path shape as CPathFinder::PathFind
+	std::vector<glm::vec2> PathFind(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, const unsigned int uiNrOfDirections);
+
+	// Get the furthest tile which the agent can reach in one straight run along the last planned path,
+	// and the direction of that run. Returns false if there is no path
+	bool GetDestination(glm::vec2& destination, glm::vec2& direction) const;
+
+	// Tell the planner that a tile became blocked or unblocked. The row is inverted (row 0 at the bottom),
+	// like the positions used for path finding. The change is repaired by the next call to Replan(), or the search
+	// is thrown away once so many tiles changed that a new search is cheaper
+	void OnTileChanged(const unsigned int uiRow, const unsigned int uiCol);
+
+	// Throw away the search, e.g. after loading a new map. The next call to Replan() searches from scratch
+	void Invalidate(void);
+
+	// Get the level which the search is running over
+	const CMapLevel* GetLevel(void) const;
+
+	// Get the number of nodes expanded by the last call to Replan()
+	unsigned int GetNumNodesExpanded(void) const;
+	// Get the number of nodes expanded by all calls to Replan(), and the number of calls
+	unsigned int GetTotalNodesExpanded(void) const;
+	unsigned int GetNumReplans(void) const;
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// The priority of a node in the open list, compared first by k1 and then by k2
+	struct Key
+	{
+		int k1;
+		int k2;
+
+		bool operator<(const Key& rhs) const
+		{
+			return (k1 < rhs.k1) || ((k1 == rhs.k1) && (k2 < rhs.k2));
+		}
+	};
+
+	// The search data of a map grid. A node only holds valid data if its
+	// uiGeneration matches m_uiGeneration, so a new search resets every node in O(1)
+	struct Node
+	{
+		unsigned int uiGeneration;
+		// The distance from the agent as of the last expansion of this node, and as seen from its neighbours
+		int g;
+		int rhs;
+	};
+
+	// The level, start, target and number of directions of the search
+	const CMapLevel* pLevel;
+	int iStart;
+	int iTarget;
+	unsigned int uiNrOfDirections;
+	bool bValid;
+
+	// The size of the level
+	MapSize sMapSize;
+
+	// The nodes of the search, and the search which is currently running
+	std::vector<Node> m_nodes;
+	unsigned int m_uiGeneration;
+	// The open list of nodes whose 2 distances differ
+	CIndexedHeap<Key> m_openList;
+	// The sum of how far the target moved since the search started, added to the keys
+	// so that the keys already in the open list stay lower bounds
+	int iKeyModifier;
+
+	// The tiles which changed since the last call to Replan(), each listed once with its flag set in arrTileChanged
+	std::vector<int> arrChangedTiles;
+	std::vector<unsigned char> arrTileChanged;
+	// The path found by the last call to Replan(), from the tile after the agent to the target
+	std::vector<glm::vec2> m_path;
+
+	// Counters of the expanded nodes
+	unsigned int m_uiNumNodesExpanded;
+	unsigned int m_uiTotalNodesExpanded;
+	unsigned int m_uiNumReplans;
+
+	// Start a new search from a start node
+	void NewSearch(const int iNewStart);
+	// Empty the list of changed tiles
+	void ClearChangedTiles(void);
+	// Expand nodes until the distance of the target node is known
+	void ComputeShortestPath(void);
+	// Build m_path by stepping back from the target to the start
+	void BuildPath(void);
+	// Get a node, resetting it if it was last touched by an older search
+	Node& GetNode(const int iNode);
+	// Get the distance of a node from the agent as of its last expansion
+	int GetDistance(const int iNode) const;
+	// Recompute the distance of a node from its neighbours, then update the open list
+	void UpdateNode(const int iNode);
+	// Put a node in the open list if its 2 distances differ, or take it out if they are the same
+	void UpdateOpenList(const int iNode);
+	// Get the lowest distance from the agent through the neighbours of a node
+	int GetLowestNeighbourDistance(const int iNode) const;
+	// Get the priority of a node
+	Key CalculateKey(const int iNode);
+	// Get the lower bound of the number of steps between 2 nodes
+	int GetHeuristic(const int iFrom, const int iTo) const;
+	// Check if a node can be walked on
+	bool IsFree(const int iNode) const;
+	// Convert a position to a 1D index, or -1 if it is outside the level
+	int ConvertTo1D(const glm::vec2& pos) const;
+};
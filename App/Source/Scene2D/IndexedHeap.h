@@ -0,0 +1,200 @@
+/**
+ CIndexedHeap
+ @brief A binary min-heap of integer node IDs which supports changing the key of a node
+		already in the heap. Used as the open list for the path finders.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <vector>
+
+template <typename KeyType>
+class CIndexedHeap
+{
+public:
+	// Constructor
+	CIndexedHeap(void)
+	{
+	}
+
+	// Destructor
+	~CIndexedHeap(void)
+	{
+	}
+
+	// Init the heap so that it can store node IDs from 0 to uiCapacity - 1
+	void Init(const unsigned int uiCapacity)
+	{
+		arrHeap.clear();
+		arrHeap.reserve(uiCapacity);
+		arrPositions.assign(uiCapacity, -1);
+	}
+
+	// Get the number of node IDs which this heap can store
+	unsigned int GetCapacity(void) const
+	{
+		return (unsigned int)arrPositions.size();
+	}
+
+	// Check if the heap is empty
+	bool Empty(void) const
+	{
+		return arrHeap.empty();
+	}
+
+	// Get the number of nodes in the heap
+	unsigned int Size(void) const
+	{
+		return (unsigned int)arrHeap.size();
+	}
+
+	// Check if a node is in the heap
+	bool Contains(const int iNode) const
+	{
+		return arrPositions[iNode] >= 0;
+	}
+
+	// Get the key of a node in the heap
+	const KeyType& GetKey(const int iNode) const
+	{
+		return arrHeap[arrPositions[iNode]].key;
+	}
+
+	// Get the node with the smallest key
+	int Top(void) const
+	{
+		return arrHeap[0].iNode;
+	}
+
+	// Get the smallest key
+	const KeyType& TopKey(void) const
+	{
+		return arrHeap[0].key;
+	}
+
+	// Add a node to the heap, or change its key if it is already in the heap
+	void Push(const int iNode, const KeyType& key)
+	{
+		if (Contains(iNode))
+		{
+			Update(iNode, key);
+			return;
+		}
+		arrPositions[iNode] = (int)arrHeap.size();
+		arrHeap.push_back(Entry(iNode, key));
+		SiftUp(arrPositions[iNode]);
+	}
+
+	// Change the key of a node which is in the heap
+	void Update(const int iNode, const KeyType& key)
+	{
+		const int iPosition = arrPositions[iNode];
+		if (key < arrHeap[iPosition].key)
+		{
+			arrHeap[iPosition].key = key;
+			SiftUp(iPosition);
+		}
+		else
+		{
+			arrHeap[iPosition].key = key;
+			SiftDown(iPosition);
+		}
+	}
+
+	// Remove and return the node with the smallest key
+	int Pop(void)
+	{
+		const int iNode = arrHeap[0].iNode;
+		RemoveAt(0);
+		return iNode;
+	}
+
+	// Remove a node from the heap, if it is in the heap
+	void Remove(const int iNode)
+	{
+		if (Contains(iNode))
+			RemoveAt(arrPositions[iNode]);
+	}
+
+	// Empty the heap. This only touches the nodes which are still in the heap
+	void Clear(void)
+	{
+		for (unsigned int i = 0; i < arrHeap.size(); i++)
+			arrPositions[arrHeap[i].iNode] = -1;
+		arrHeap.clear();
+	}
+
+protected:
+	// An entry in the heap
+	struct Entry
+	{
+		Entry(const int iNode, const KeyType& key) : iNode(iNode), key(key) {}
+
+		int iNode;
+		KeyType key;
+	};
+
+	// The heap of entries
+	std::vector<Entry> arrHeap;
+	// The position of each node in arrHeap, or -1 if the node is not in the heap
+	std::vector<int> arrPositions;
+
+	// Remove the entry at a position in arrHeap
+	void RemoveAt(const int iPosition)
+	{
+		arrPositions[arrHeap[iPosition].iNode] = -1;
+		const int iLast = (int)arrHeap.size() - 1;
+		if (iPosition != iLast)
+		{
+			arrHeap[iPosition] = arrHeap[iLast];
+			arrPositions[arrHeap[iPosition].iNode] = iPosition;
+			arrHeap.pop_back();
+			SiftDown(iPosition);
+			SiftUp(iPosition);
+		}
+		else
+		{
+			arrHeap.pop_back();
+		}
+	}
+
+	// Move an entry up until its parent has a smaller key
+	void SiftUp(int iPosition)
+	{
+		Entry entry = arrHeap[iPosition];
+		while (iPosition > 0)
+		{
+			const int iParent = (iPosition - 1) / 2;
+			if (!(entry.key < arrHeap[iParent].key))
+				break;
+			arrHeap[iPosition] = arrHeap[iParent];
+			arrPositions[arrHeap[iPosition].iNode] = iPosition;
+			iPosition = iParent;
+		}
+		arrHeap[iPosition] = entry;
+		arrPositions[entry.iNode] = iPosition;
+	}
+
+	// Move an entry down until its children have larger keys
+	void SiftDown(int iPosition)
+	{
+		const int iSize = (int)arrHeap.size();
+		Entry entry = arrHeap[iPosition];
+		while (true)
+		{
+			int iChild = iPosition * 2 + 1;
+			if (iChild >= iSize)
+				break;
+			if ((iChild + 1 < iSize) && (arrHeap[iChild + 1].key < arrHeap[iChild].key))
+				iChild++;
+			if (!(arrHeap[iChild].key < entry.key))
+				break;
+			arrHeap[iPosition] = arrHeap[iChild];
+			arrPositions[arrHeap[iPosition].iNode] = iPosition;
+			iPosition = iChild;
+		}
+		arrHeap[iPosition] = entry;
+		arrPositions[entry.iNode] = iPosition;
+	}
+};
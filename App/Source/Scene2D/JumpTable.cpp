@@ -0,0 +1,246 @@
+/**
+ CJumpTable
+ @brief A class which stores the jump distances of every tile of a CMapLevel for Jump Point Search.
+		It is built once per level (JPS+) and has to be rebuilt when a blocking tile changes.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "JumpTable.h"
+
+/**
+ @brief Check if a direction sweeps across the map, looking for jump points in the directions beside it.
+		These are the diagonal directions with 8 directions, and the horizontal directions with 4 directions.
+ */
+static bool IsSweepingDirection(const unsigned int uiNrOfDirections, const unsigned int uiDirection)
+{
+	if (uiNrOfDirections == 8)
+		return uiDirection >= 4;
+	return uiDirection < 2;
+}
+
+/**
+ @brief Get the directions which a sweeping direction looks for jump points in
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions
+ @param uiDirection A const unsigned int variable containing the sweeping direction
+ @param uirFirst An unsigned int variable which will store the first direction
+ @param uirSecond An unsigned int variable which will store the second direction
+ */
+static void GetSweptDirections(const unsigned int uiNrOfDirections,
+	const unsigned int uiDirection,
+	unsigned int& uirFirst,
+	unsigned int& uirSecond)
+{
+	if (uiNrOfDirections == 8)
+	{
+		uirFirst = GetDirectionIndex(iDirectionX[uiDirection], 0);
+		uirSecond = GetDirectionIndex(0, iDirectionY[uiDirection]);
+	}
+	else
+	{
+		uirFirst = 2;
+		uirSecond = 3;
+	}
+}
+
+/**
+ @brief Constructor
+ */
+CJumpTable::CJumpTable(void)
+	: bValid(false)
+	, uiNrOfDirections(0)
+	, pLevel(NULL)
+	, uiCollisionVersion(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CJumpTable::~CJumpTable(void)
+{
+}
+
+/**
+ @brief Build the jump distances of every tile in cLevel
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+void CJumpTable::Build(const CMapLevel& cLevel, const unsigned int uiNrOfDirections)
+{
+	this->uiNrOfDirections = uiNrOfDirections;
+	sMapSize.uiRowSize = cLevel.GetNumRows();
+	sMapSize.uiColSize = cLevel.GetNumCols();
+	pLevel = &cLevel;
+	uiCollisionVersion = cLevel.GetCollisionVersion();
+	arrDistances.assign(sMapSize.uiRowSize * sMapSize.uiColSize * 8, 0);
+
+	// The sweeping directions use the jump distances of the straight directions, so build those first
+	for (unsigned int uiDirection = 0; uiDirection < uiNrOfDirections; uiDirection++)
+	{
+		if (!IsSweepingDirection(uiNrOfDirections, uiDirection))
+			BuildDirection(cLevel, uiDirection);
+	}
+	for (unsigned int uiDirection = 0; uiDirection < uiNrOfDirections; uiDirection++)
+	{
+		if (IsSweepingDirection(uiNrOfDirections, uiDirection))
+			BuildDirection(cLevel, uiDirection);
+	}
+
+	bValid = true;
+}
+
+/**
+ @brief Mark the jump distances as out of date
+ */
+void CJumpTable::Invalidate(void)
+{
+	bValid = false;
+}
+
+/**
+ @brief Check if the jump distances were built from this level, for this number of directions,
+		and no tile of it has become blocked or free since
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+bool CJumpTable::IsValid(const CMapLevel& cLevel, const unsigned int uiNrOfDirections) const
+{
+	return bValid && (this->uiNrOfDirections == uiNrOfDirections) && (pLevel == &cLevel) &&
+		(uiCollisionVersion == cLevel.GetCollisionVersion()) &&
+		(sMapSize.uiRowSize == cLevel.GetNumRows()) && (sMapSize.uiColSize == cLevel.GetNumCols());
+}
+
+/**
+ @brief Compute a jump distance by scanning the tiles from a position
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param iX A const int variable containing the column of the position
+ @param iY A const int variable containing the inverted row of the position
+ @param uiDirection A const unsigned int variable containing the direction to scan in
+ */
+int CJumpTable::ComputeJumpDistance(const CMapLevel& cLevel,
+	const unsigned int uiNrOfDirections,
+	const int iX,
+	const int iY,
+	const unsigned int uiDirection)
+{
+	const bool bSweeping = IsSweepingDirection(uiNrOfDirections, uiDirection);
+	unsigned int uiFirst = 0, uiSecond = 0;
+	if (bSweeping)
+		GetSweptDirections(uiNrOfDirections, uiDirection, uiFirst, uiSecond);
+
+	int iStep = 1;
+	while (true)
+	{
+		const int iCurrentX = iX + iStep * iDirectionX[uiDirection];
+		const int iCurrentY = iY + iStep * iDirectionY[uiDirection];
+		if (!IsFree(cLevel, iCurrentX, iCurrentY))
+			return 1 - iStep;
+
+		if (HasForcedNeighbour(cLevel, uiNrOfDirections, iCurrentX, iCurrentY, uiDirection))
+			return iStep;
+
+		// A sweeping direction stops where a jump point can be reached from the directions beside it
+		if (bSweeping &&
+			((ComputeJumpDistance(cLevel, uiNrOfDirections, iCurrentX, iCurrentY, uiFirst) > 0) ||
+			(ComputeJumpDistance(cLevel, uiNrOfDirections, iCurrentX, iCurrentY, uiSecond) > 0)))
+			return iStep;
+
+		iStep++;
+	}
+}
+
+/**
+ @brief Check if a tile, reached by moving in a direction, has a neighbour which only it can reach optimally.
+		Diagonal steps may cut corners and cost the same as straight steps, like in CPathFinder::PathFind.
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param iX A const int variable containing the column of the tile
+ @param iY A const int variable containing the inverted row of the tile
+ @param uiDirection A const unsigned int variable containing the direction the tile was reached in
+ */
+bool CJumpTable::HasForcedNeighbour(const CMapLevel& cLevel,
+	const unsigned int uiNrOfDirections,
+	const int iX,
+	const int iY,
+	const unsigned int uiDirection)
+{
+	const int iDeltaX = iDirectionX[uiDirection];
+	const int iDeltaY = iDirectionY[uiDirection];
+
+	if (uiNrOfDirections == 4)
+	{
+		// Paths move horizontally first, so only a vertical move has to turn, and only
+		// when the tile beside the previous tile blocks the horizontal move from there
+		if (iDeltaX != 0)
+			return false;
+		return (!IsFree(cLevel, iX - 1, iY - iDeltaY) && IsFree(cLevel, iX - 1, iY)) ||
+			(!IsFree(cLevel, iX + 1, iY - iDeltaY) && IsFree(cLevel, iX + 1, iY));
+	}
+
+	if ((iDeltaX == 0) || (iDeltaY == 0))
+	{
+		// A straight move has to turn diagonally when the tile beside it is blocked
+		const int iSideX = iDeltaY;
+		const int iSideY = iDeltaX;
+		return (!IsFree(cLevel, iX + iSideX, iY + iSideY) && IsFree(cLevel, iX + iSideX + iDeltaX, iY + iSideY + iDeltaY)) ||
+			(!IsFree(cLevel, iX - iSideX, iY - iSideY) && IsFree(cLevel, iX - iSideX + iDeltaX, iY - iSideY + iDeltaY));
+	}
+
+	// A diagonal move has to turn to the other diagonals when the tiles behind it are blocked
+	return (!IsFree(cLevel, iX - iDeltaX, iY) && IsFree(cLevel, iX - iDeltaX, iY + iDeltaY)) ||
+		(!IsFree(cLevel, iX, iY - iDeltaY) && IsFree(cLevel, iX + iDeltaX, iY - iDeltaY));
+}
+
+/**
+ @brief Build the jump distances for one direction. Each tile uses the distance of the next tile in
+		that direction, so the tiles are visited from the far side of the map.
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiDirection A const unsigned int variable containing the direction
+ */
+void CJumpTable::BuildDirection(const CMapLevel& cLevel, const unsigned int uiDirection)
+{
+	const int iNumRows = (int)sMapSize.uiRowSize;
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iDeltaX = iDirectionX[uiDirection];
+	const int iDeltaY = iDirectionY[uiDirection];
+
+	const bool bSweeping = IsSweepingDirection(uiNrOfDirections, uiDirection);
+	unsigned int uiFirst = 0, uiSecond = 0;
+	if (bSweeping)
+		GetSweptDirections(uiNrOfDirections, uiDirection, uiFirst, uiSecond);
+
+	const int iStartY = (iDeltaY > 0) ? iNumRows - 1 : 0;
+	const int iStepY = (iDeltaY > 0) ? -1 : 1;
+	const int iStartX = (iDeltaX > 0) ? iNumCols - 1 : 0;
+	const int iStepX = (iDeltaX > 0) ? -1 : 1;
+
+	for (int iY = iStartY; (iY >= 0) && (iY < iNumRows); iY += iStepY)
+	{
+		for (int iX = iStartX; (iX >= 0) && (iX < iNumCols); iX += iStepX)
+		{
+			const int iNextX = iX + iDeltaX;
+			const int iNextY = iY + iDeltaY;
+			short& sDistance = arrDistances[(iY * iNumCols + iX) * 8 + uiDirection];
+
+			if (!IsFree(cLevel, iNextX, iNextY))
+			{
+				sDistance = 0;
+				continue;
+			}
+
+			const int iNext = iNextY * iNumCols + iNextX;
+			if (HasForcedNeighbour(cLevel, uiNrOfDirections, iNextX, iNextY, uiDirection) ||
+				(bSweeping && ((arrDistances[iNext * 8 + uiFirst] > 0) || (arrDistances[iNext * 8 + uiSecond] > 0))))
+			{
+				sDistance = 1;
+				continue;
+			}
+
+			const short sNextDistance = arrDistances[iNext * 8 + uiDirection];
+			sDistance = (sNextDistance > 0) ? sNextDistance + 1 : sNextDistance - 1;
+		}
+	}
+}
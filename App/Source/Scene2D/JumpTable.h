@@ -0,0 +1,91 @@
+/**
+ CJumpTable
+ @brief A class which stores the jump distances of every tile of a CMapLevel for Jump Point Search.
+		It is built once per level (JPS+) and has to be rebuilt when a blocking tile changes.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <vector>
+
+// The 8 directions used by the path finders: the 4 straight directions first, then the 4 diagonal directions
+static const int iDirectionX[8] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+static const int iDirectionY[8] = { 0, 0, 1, -1, -1, 1, 1, -1 };
+
+// Get the index into iDirectionX and iDirectionY of a direction. Returns -1 for (0, 0)
+inline int GetDirectionIndex(const int iDeltaX, const int iDeltaY)
+{
+	static const int iDirectionIndices[3][3] = { { 4, 3, 7 }, { 0, -1, 1 }, { 6, 2, 5 } };
+	return iDirectionIndices[iDeltaY + 1][iDeltaX + 1];
+}
+
+class CJumpTable
+{
+public:
+	// Constructor
+	CJumpTable(void);
+
+	// Destructor
+	~CJumpTable(void);
+
+	// Build the jump distances of every tile in cLevel for 4 or 8 directions
+	void Build(const CMapLevel& cLevel, const unsigned int uiNrOfDirections);
+
+	// Mark the jump distances as out of date, e.g. when a blocking tile has changed
+	void Invalidate(void);
+
+	// Check if the jump distances were built from this level, for this number of directions,
+	// and no tile of it has become blocked or free since
+	bool IsValid(const CMapLevel& cLevel, const unsigned int uiNrOfDirections) const;
+
+	// Get the jump distance from a tile in a direction.
+	// A positive distance is the number of steps to the next jump point.
+	// Otherwise, minus the distance is the number of free steps before a wall or the edge of the map.
+	int GetJumpDistance(const int iNode, const unsigned int uiDirection) const
+	{
+		return arrDistances[iNode * 8 + uiDirection];
+	}
+
+	// Compute a jump distance without a table, by scanning the tiles. Used by Jump Point Search without JPS+
+	static int ComputeJumpDistance(const CMapLevel& cLevel,
+									const unsigned int uiNrOfDirections,
+									const int iX,
+									const int iY,
+									const unsigned int uiDirection);
+
+	// Check if a tile is inside the level and not blocked. Positions are (column, inverted row)
+	static bool IsFree(const CMapLevel& cLevel, const int iX, const int iY)
+	{
+		return (iX >= 0) && (iX < (int)cLevel.GetNumCols()) &&
+			(iY >= 0) && (iY < (int)cLevel.GetNumRows()) &&
+			!cLevel.IsBlocked(iY, iX);
+	}
+
+	// Check if a tile, reached by moving in a direction, has a neighbour which only it can reach optimally
+	static bool HasForcedNeighbour(const CMapLevel& cLevel,
+									const unsigned int uiNrOfDirections,
+									const int iX,
+									const int iY,
+									const unsigned int uiDirection);
+
+protected:
+	// Whether the jump distances are up to date
+	bool bValid;
+	// The number of directions the jump distances were built for
+	unsigned int uiNrOfDirections;
+	// The size of the level the jump distances were built for
+	MapSize sMapSize;
+	// The level the jump distances were built from, and the version of its collision layer then
+	const CMapLevel* pLevel;
+	unsigned int uiCollisionVersion;
+
+	// 8 jump distances per tile, in the order of iDirectionX and iDirectionY
+	std::vector<short> arrDistances;
+
+	// Build the jump distances for one direction, using the distances of the next tile in that direction
+	void BuildDirection(const CMapLevel& cLevel, const unsigned int uiDirection);
+};
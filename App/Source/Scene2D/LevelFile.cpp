@@ -0,0 +1,364 @@
+/**
+ CLevelFile
+ @brief A class which reads a level compiled into a binary file by mapping the file into memory,
+		so that its tiles can be used as they are, without parsing them.
+		The file holds a header, the tile values of one or more layers and some metadata, e.g. the column labels of the CSV.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "LevelFile.h"
+
+// Include MapSaver for flushing and renaming the written file
+#include "MapSaver.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+// The first 4 bytes of a level file, and the version of its layout.
+// The header is { magic, version, rows, columns, layers, metadata bytes, CSV size (low, high), CSV hash },
+// followed by the layers and the metadata
+static const unsigned int uiFileMagic = 0x314C564C;	// "LVL1"
+static const unsigned int uiFileVersion = 2;
+static const unsigned int uiHeaderSize = 9 * sizeof(unsigned int);
+
+/**
+ @brief Add bytes to an FNV-1a hash
+ @param uiHash A const unsigned int variable containing the hash of the bytes before these
+ @param pBytes A const char* variable containing the bytes
+ @param uiSize A const size_t variable containing the number of bytes
+ */
+static unsigned int HashBytes(unsigned int uiHash, const char* pBytes, const size_t uiSize)
+{
+	for (size_t i = 0; i < uiSize; i++)
+	{
+		uiHash ^= (unsigned char)pBytes[i];
+		uiHash *= 16777619u;
+	}
+	return uiHash;
+}
+
+/**
+ @brief Constructor
+ */
+CLevelFile::CLevelFile(void)
+	: pData(NULL)
+	, uiSize(0)
+#ifdef _WIN32
+	, hFile(NULL)
+	, hMapping(NULL)
+#endif
+{
+}
+
+/**
+ @brief Destructor
+ */
+CLevelFile::~CLevelFile(void)
+{
+	Close();
+}
+
+/**
+ @brief Map a level file into memory
+ @param filename A const std::string& variable containing the name of the file
+ */
+bool CLevelFile::Open(const std::string& filename)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	hFile = file;
+	LARGE_INTEGER sFileSize;
+	if ((!GetFileSizeEx(file, &sFileSize)) || (sFileSize.QuadPart < uiHeaderSize))
+	{
+		Close();
+		return false;
+	}
+	uiSize = (size_t)sFileSize.QuadPart;
+	hMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL)
+	{
+		Close();
+		return false;
+	}
+	pData = (const char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (pData == NULL)
+	{
+		Close();
+		return false;
+	}
+#else
+	const int iFile = open(filename.c_str(), O_RDONLY);
+	if (iFile < 0)
+		return false;
+	struct stat sFileStat;
+	if ((fstat(iFile, &sFileStat) != 0) || (sFileStat.st_size < (off_t)uiHeaderSize))
+	{
+		close(iFile);
+		return false;
+	}
+	void* pMapping = mmap(NULL, (size_t)sFileStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+	// The mapping stays valid once the file is closed
+	close(iFile);
+	if (pMapping == MAP_FAILED)
+		return false;
+	pData = (const char*)pMapping;
+	uiSize = (size_t)sFileStat.st_size;
+#endif
+
+	// A file of another layout, or one which was cut short, cannot be used
+	const unsigned int* pHeader = (const unsigned int*)pData;
+	const unsigned long long ullLayersSize = (unsigned long long)pHeader[2] * pHeader[3] * pHeader[4] * sizeof(int);
+	if ((pHeader[0] != uiFileMagic) ||
+		(pHeader[1] != uiFileVersion) ||
+		(pHeader[4] == 0) ||
+		(uiHeaderSize + ullLayersSize + pHeader[5] > uiSize))
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Unmap the level file
+ */
+void CLevelFile::Close(void)
+{
+#ifdef _WIN32
+	if (pData)
+		UnmapViewOfFile(pData);
+	if (hMapping)
+		CloseHandle(hMapping);
+	if (hFile)
+		CloseHandle(hFile);
+	hMapping = NULL;
+	hFile = NULL;
+#else
+	if (pData)
+		munmap((void*)pData, uiSize);
+#endif
+	pData = NULL;
+	uiSize = 0;
+}
+
+/**
+ @brief Check if a level file is mapped
+ */
+bool CLevelFile::IsOpen(void) const
+{
+	return pData != NULL;
+}
+
+/**
+ @brief Get the number of rows of the level
+ */
+unsigned int CLevelFile::GetNumRows(void) const
+{
+	return pData ? ((const unsigned int*)pData)[2] : 0;
+}
+
+/**
+ @brief Get the number of columns of the level
+ */
+unsigned int CLevelFile::GetNumCols(void) const
+{
+	return pData ? ((const unsigned int*)pData)[3] : 0;
+}
+
+/**
+ @brief Get the number of layers of the level
+ */
+unsigned int CLevelFile::GetNumLayers(void) const
+{
+	return pData ? ((const unsigned int*)pData)[4] : 0;
+}
+
+/**
+ @brief Get the values of a layer
+ @param uiLayer A const unsigned int variable containing the layer
+ */
+const int* CLevelFile::GetLayer(const unsigned int uiLayer) const
+{
+	if (uiLayer >= GetNumLayers())
+		return NULL;
+	const size_t uiNumTiles = (size_t)GetNumRows() * GetNumCols();
+	return (const int*)(pData + uiHeaderSize) + uiLayer * uiNumTiles;
+}
+
+/**
+ @brief Get the metadata
+ */
+std::string CLevelFile::GetMetadata(void) const
+{
+	if (!pData)
+		return string();
+	const size_t uiNumTiles = (size_t)GetNumRows() * GetNumCols();
+	const char* pMetadata = pData + uiHeaderSize + GetNumLayers() * uiNumTiles * sizeof(int);
+	return string(pMetadata, ((const unsigned int*)pData)[5]);
+}
+
+/**
+ @brief Get the stamp of the CSV file which the level was compiled from
+ */
+SourceStamp CLevelFile::GetSource(void) const
+{
+	SourceStamp sStamp = { 0, 0, 0 };
+	if (pData)
+	{
+		const unsigned int* pHeader = (const unsigned int*)pData;
+		sStamp.uiSizeLow = pHeader[6];
+		sStamp.uiSizeHigh = pHeader[7];
+		sStamp.uiHash = pHeader[8];
+	}
+	return sStamp;
+}
+
+/**
+ @brief Copy the tile values into a level of the same size
+ @param cLevel A CMapLevel& variable containing the level
+ */
+bool CLevelFile::CopyTo(CMapLevel& cLevel) const
+{
+	if ((!pData) || (cLevel.GetNumRows() != GetNumRows()) || (cLevel.GetNumCols() != GetNumCols()))
+		return false;
+
+	const int* pTiles = GetLayer(0);
+	std::copy(pTiles, pTiles + (size_t)GetNumRows() * GetNumCols(), cLevel.GetTiles());
+	cLevel.UpdateLayers();
+	return true;
+}
+
+/**
+ @brief Write a level into a level file. It is written into a temporary file, which is flushed to the disk and then
+		renamed over the level file, so that a write which is cut short never leaves a level file which looks valid
+ @param filename A const std::string& variable containing the name of the file
+ @param cLevel A const CMapLevel& variable containing the level
+ @param metadata A const std::string& variable containing the metadata
+ @param sSource A const SourceStamp& variable containing the stamp of the CSV file which the level was compiled from
+ */
+bool CLevelFile::Save(const std::string& filename, const CMapLevel& cLevel, const std::string& metadata, const SourceStamp& sSource)
+{
+	const string tempFilename = filename + ".tmp";
+	ofstream file(tempFilename.c_str(), ios::binary | ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	const unsigned int arrHeader[9] = { uiFileMagic,
+										uiFileVersion,
+										cLevel.GetNumRows(),
+										cLevel.GetNumCols(),
+										1,
+										(unsigned int)metadata.size(),
+										sSource.uiSizeLow,
+										sSource.uiSizeHigh,
+										sSource.uiHash };
+	file.write((const char*)arrHeader, sizeof(arrHeader));
+	file.write((const char*)cLevel.GetTiles(), (streamsize)cLevel.GetNumRows() * cLevel.GetNumCols() * sizeof(int));
+	file.write(metadata.data(), metadata.size());
+	file.close();
+	if (file.fail())
+	{
+		remove(tempFilename.c_str());
+		return false;
+	}
+	return CMapSaver::CommitFile(tempFilename, filename);
+}
+
+/**
+ @brief Get the name of the level file which belongs to a CSV file, by replacing its extension with ".lvl"
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ */
+std::string CLevelFile::GetFilename(const std::string& csvFilename)
+{
+	const size_t uiDot = csvFilename.find_last_of('.');
+	const size_t uiSlash = csvFilename.find_last_of("/\\");
+	if ((uiDot == string::npos) || ((uiSlash != string::npos) && (uiDot < uiSlash)))
+		return csvFilename + ".lvl";
+	return csvFilename.substr(0, uiDot) + ".lvl";
+}
+
+/**
+ @brief Check if a level file exists, and was compiled from its CSV file as it is now. The times of the files are not
+		used, as a checkout gives the level file and the CSV file the same time whichever was changed last
+ @param filename A const std::string& variable containing the name of the level file
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ */
+bool CLevelFile::IsUpToDate(const std::string& filename, const std::string& csvFilename)
+{
+	CLevelFile cLevelFile;
+	if (!cLevelFile.Open(filename))
+		return false;
+	const SourceStamp sSource = cLevelFile.GetSource();
+	cLevelFile.Close();
+
+	// A level file without a CSV file is all there is
+	struct stat sCsvStat;
+	if (stat(csvFilename.c_str(), &sCsvStat) != 0)
+		return true;
+	// Only read the CSV file to hash it if its size matches
+	const unsigned long long ullCsvSize = (unsigned long long)sCsvStat.st_size;
+	if ((sSource.uiSizeLow != (unsigned int)ullCsvSize) || (sSource.uiSizeHigh != (unsigned int)(ullCsvSize >> 32)))
+		return false;
+	SourceStamp sStamp;
+	return GetSourceStamp(csvFilename, sStamp) && (sStamp == sSource);
+}
+
+/**
+ @brief Get the stamp of a CSV text
+ @param pText A const char* variable containing the text
+ @param uiSize A const size_t variable containing the number of characters in the text
+ */
+SourceStamp CLevelFile::GetSourceStamp(const char* pText, const size_t uiSize)
+{
+	SourceStamp sStamp;
+	sStamp.uiSizeLow = (unsigned int)uiSize;
+	sStamp.uiSizeHigh = (unsigned int)((unsigned long long)uiSize >> 32);
+	sStamp.uiHash = HashBytes(2166136261u, pText, uiSize);
+	return sStamp;
+}
+
+/**
+ @brief Get the stamp of a CSV file by reading it a block at a time
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ @param sStamp A SourceStamp& variable which will store the stamp
+ */
+bool CLevelFile::GetSourceStamp(const std::string& csvFilename, SourceStamp& sStamp)
+{
+	ifstream file(csvFilename.c_str(), ios::binary);
+	if (!file.is_open())
+		return false;
+
+	char arrBlock[65536];
+	unsigned long long ullSize = 0;
+	unsigned int uiHash = 2166136261u;
+	while (file)
+	{
+		file.read(arrBlock, sizeof(arrBlock));
+		const size_t uiRead = (size_t)file.gcount();
+		uiHash = HashBytes(uiHash, arrBlock, uiRead);
+		ullSize += uiRead;
+	}
+	if (file.bad())
+		return false;
+
+	sStamp.uiSizeLow = (unsigned int)ullSize;
+	sStamp.uiSizeHigh = (unsigned int)(ullSize >> 32);
+	sStamp.uiHash = uiHash;
+	return true;
+}
@@ -0,0 +1,85 @@
+/**
+ CLevelFile
+ @brief A class which reads a level compiled into a binary file by mapping the file into memory,
+		so that its tiles can be used as they are, without parsing them.
+		The file holds a header, the tile values of one or more layers and some metadata, e.g. the column labels of the CSV.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <string>
+
+// The size and FNV-1a hash of the CSV file which a level file or chunk file was built from,
+// so that the file is only used while the CSV file is unchanged. It is all 0 for a file built without one
+struct SourceStamp
+{
+	unsigned int uiSizeLow;
+	unsigned int uiSizeHigh;
+	unsigned int uiHash;
+
+	bool operator==(const SourceStamp& rhs) const
+	{
+		return (uiSizeLow == rhs.uiSizeLow) && (uiSizeHigh == rhs.uiSizeHigh) && (uiHash == rhs.uiHash);
+	}
+};
+
+class CLevelFile
+{
+public:
+	// Constructor
+	CLevelFile(void);
+
+	// Destructor, which closes the file
+	~CLevelFile(void);
+
+	// Map a level file into memory. Returns false if it cannot be opened, or it is not a level file of this version
+	bool Open(const std::string& filename);
+	// Unmap the level file
+	void Close(void);
+
+	// Check if a level file is mapped
+	bool IsOpen(void) const;
+
+	// Get the size of the level
+	unsigned int GetNumRows(void) const;
+	unsigned int GetNumCols(void) const;
+	// Get the number of layers. Layer 0 holds the tile values
+	unsigned int GetNumLayers(void) const;
+	// Get the values of a layer, stored row by row in CSV order like CMapLevel::GetTiles()
+	const int* GetLayer(const unsigned int uiLayer) const;
+	// Get the metadata
+	std::string GetMetadata(void) const;
+	// Get the stamp of the CSV file which the level was compiled from
+	SourceStamp GetSource(void) const;
+
+	// Copy the tile values into a level of the same size. Returns false if the sizes differ
+	bool CopyTo(CMapLevel& cLevel) const;
+
+	// Write a level into a level file, with its tile values as layer 0, and the stamp of the CSV file it was compiled from.
+	// The old file is only replaced once the new one is complete
+	static bool Save(const std::string& filename, const CMapLevel& cLevel, const std::string& metadata, const SourceStamp& sSource);
+
+	// Get the name of the level file which belongs to a CSV file
+	static std::string GetFilename(const std::string& csvFilename);
+	// Check if a level file exists, and was compiled from the CSV file as it is now, if there is one
+	static bool IsUpToDate(const std::string& filename, const std::string& csvFilename);
+
+	// Get the stamp of a CSV text
+	static SourceStamp GetSourceStamp(const char* pText, const size_t uiSize);
+	// Get the stamp of a CSV file by reading it. Returns false if it cannot be read
+	static bool GetSourceStamp(const std::string& csvFilename, SourceStamp& sStamp);
+
+protected:
+	// The mapped file, and its size in bytes
+	const char* pData;
+	size_t uiSize;
+#ifdef _WIN32
+	// The handles of the file and its mapping
+	void* hFile;
+	void* hMapping;
+#endif
+};
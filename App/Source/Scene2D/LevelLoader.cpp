@@ -0,0 +1,184 @@
+/**
+ CLevelLoader
+ @brief A class which reads a level and builds what CMap2D needs from its tiles, either at once or on a worker thread
+		while another level is played, so that switching to the level only swaps the prepared data into place.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "LevelLoader.h"
+
+// Include LevelFile and TileCsv for reading the level
+#include "LevelFile.h"
+#include "TileCsv.h"
+
+#include <iostream>
+
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CLevelLoader::CLevelLoader(void)
+	: bReady(false)
+	, bLoaded(false)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CLevelLoader::~CLevelLoader(void)
+{
+	Cancel();
+}
+
+/**
+ @brief Read a level, index its values, and load its visible sets
+ @param csvFilename A const std::string& variable containing the full path of the CSV file
+ @param uiNumRows A const unsigned int variable containing the number of rows the level must have
+ @param uiNumCols A const unsigned int variable containing the number of columns the level must have
+ @param sLevel A LoadedLevel& variable which will store the level
+ @param arrCsvText A std::vector<char>& variable which holds the CSV text
+ */
+bool CLevelLoader::Load(const std::string& csvFilename,
+						const unsigned int uiNumRows,
+						const unsigned int uiNumCols,
+						LoadedLevel& sLevel,
+						std::vector<char>& arrCsvText)
+{
+	const string levelFilename = CLevelFile::GetFilename(csvFilename);
+	sLevel.cLevel.Init(uiNumRows, uiNumCols);
+
+	// Use the compiled level file if it was compiled from the CSV file as it is now, as its tiles can be copied as they are.
+	// Hashing the CSV text is much cheaper than parsing it. Without a CSV file, the level file is all there is
+	size_t uiCsvSize = 0;
+	const bool bHasCsv = tilecsv::ReadFile(csvFilename, arrCsvText, uiCsvSize);
+	const SourceStamp sSource = bHasCsv ? CLevelFile::GetSourceStamp(arrCsvText.data(), uiCsvSize) : SourceStamp();
+	CLevelFile cLevelFile;
+	if (cLevelFile.Open(levelFilename) && ((!bHasCsv) || (cLevelFile.GetSource() == sSource)))
+	{
+		// Check if the sizes of the level file matches the declared arrMapInfo sizes
+		if (!cLevelFile.CopyTo(sLevel.cLevel))
+		{
+			cout << "Sizes of level file does not match declared arrMapInfo sizes." << endl;
+			return false;
+		}
+		sLevel.columnLabels = cLevelFile.GetMetadata();
+		cLevelFile.Close();
+	}
+	else
+	{
+		cLevelFile.Close();
+		if (!bHasCsv)
+		{
+			cout << "Unable to read the CSV map " << csvFilename << endl;
+			return false;
+		}
+
+		// Check if the sizes of CSV data matches the declared arrMapInfo sizes
+		unsigned int uiCsvRows = 0, uiCsvCols = 0;
+		if ((!tilecsv::GetSize(arrCsvText.data(), uiCsvSize, uiCsvRows, uiCsvCols)) ||
+			(uiNumCols != uiCsvCols) ||
+			(uiNumRows != uiCsvRows))
+		{
+			cout << "Sizes of CSV map does not match declared arrMapInfo sizes." << endl;
+			return false;
+		}
+
+		// Read the rows and columns of CSV data, and keep the column labels for SaveMap
+		if (!tilecsv::Parse(arrCsvText.data(), uiCsvSize, uiNumRows, uiNumCols, sLevel.cLevel.GetTiles(), &sLevel.columnLabels))
+		{
+			cout << "Unable to read the CSV map " << csvFilename << ", a cell is not an integer." << endl;
+			return false;
+		}
+		// Split the walls and items out of the values
+		sLevel.cLevel.UpdateLayers();
+		// Compile the level so that the next load does not parse the CSV
+		if (!CLevelFile::Save(levelFilename, sLevel.cLevel, sLevel.columnLabels, sSource))
+			cout << "Unable to save the level file " << levelFilename << endl;
+	}
+
+	sLevel.cValueIndex.Build(sLevel.cLevel);
+
+	// Load the visible sets which PvsCook saved next to the CSV file. Building them takes time in the square of the
+	// number of tiles, so it is not done here. Without them, CMap2D::HasLineOfSight walks the lines of sight instead
+	const string pvsFilename = CPotentiallyVisibleSet::GetFilename(csvFilename);
+	if (!sLevel.cVisibleSet.Load(pvsFilename, sLevel.cLevel, 0))
+		cout << "The visible sets in " << pvsFilename << " are missing or out of date, run PvsCook to rebuild them" << endl;
+	return true;
+}
+
+/**
+ @brief Start loading a level on the worker thread
+ @param csvFilename A const std::string& variable containing the full path of the CSV file
+ @param uiNumRows A const unsigned int variable containing the number of rows the level must have
+ @param uiNumCols A const unsigned int variable containing the number of columns the level must have
+ */
+void CLevelLoader::Preload(const std::string& csvFilename, const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	Cancel();
+
+	filename = csvFilename;
+	bReady = false;
+	cWorker = std::thread([this, uiNumRows, uiNumCols]() {
+		bLoaded = Load(filename, uiNumRows, uiNumCols, sLoadedLevel, arrCsvText);
+		bReady = true;
+	});
+}
+
+/**
+ @brief Get the CSV file of the level being loaded
+ */
+const std::string& CLevelLoader::GetFilename(void) const
+{
+	return filename;
+}
+
+/**
+ @brief Check if the worker thread has finished loading the level
+ */
+bool CLevelLoader::IsReady(void) const
+{
+	return bReady;
+}
+
+/**
+ @brief Wait for the worker thread, and swap the level it loaded into sLevel
+ @param sLevel A LoadedLevel& variable which will store the level
+ */
+bool CLevelLoader::Take(LoadedLevel& sLevel)
+{
+	if (!cWorker.joinable())
+		return false;
+	cWorker.join();
+
+	const bool bResult = bLoaded;
+	if (bResult)
+	{
+		sLevel.cLevel.Swap(sLoadedLevel.cLevel);
+		sLevel.columnLabels.swap(sLoadedLevel.columnLabels);
+		sLevel.cValueIndex.Swap(sLoadedLevel.cValueIndex);
+		sLevel.cVisibleSet.Swap(sLoadedLevel.cVisibleSet);
+	}
+	Cancel();
+	return bResult;
+}
+
+/**
+ @brief Wait for the worker thread, and drop the level it loaded
+ */
+void CLevelLoader::Cancel(void)
+{
+	if (cWorker.joinable())
+		cWorker.join();
+
+	// Free the memory of the level, rather than keep it for the next one
+	LoadedLevel sEmptyLevel;
+	sLoadedLevel.cLevel.Swap(sEmptyLevel.cLevel);
+	sLoadedLevel.columnLabels.clear();
+	sLoadedLevel.cValueIndex.Swap(sEmptyLevel.cValueIndex);
+	sLoadedLevel.cVisibleSet.Swap(sEmptyLevel.cVisibleSet);
+	filename.clear();
+	bLoaded = false;
+	bReady = false;
+}
@@ -0,0 +1,71 @@
+/**
+ CLevelLoader
+ @brief A class which reads a level and builds what CMap2D needs from its tiles, either at once or on a worker thread
+		while another level is played, so that switching to the level only swaps the prepared data into place.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+// Include TileValueIndex and PotentiallyVisibleSet, which are built or loaded along with the tiles
+#include "TileValueIndex.h"
+#include "PotentiallyVisibleSet.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A level read from its files, and what is built from its tiles before it is swapped into CMap2D
+struct LoadedLevel
+{
+	CMapLevel cLevel;
+	// The column labels in the first line of the CSV file
+	std::string columnLabels;
+	CTileValueIndex cValueIndex;
+	// The visible sets, made for version 0 of the level
+	CPotentiallyVisibleSet cVisibleSet;
+};
+
+class CLevelLoader
+{
+public:
+	// Constructor
+	CLevelLoader(void);
+
+	// Destructor, which waits for the worker thread
+	~CLevelLoader(void);
+
+	// Read a level from its CSV file, or from its compiled level file if that is up to date, then index its values
+	// and load its visible sets, if PvsCook has saved them for its blocking tiles. arrCsvText holds the CSV text, so that its memory can be reused.
+	// Returns false if the level cannot be read, or it does not have uiNumRows rows and uiNumCols columns
+	static bool Load(const std::string& csvFilename,
+					const unsigned int uiNumRows,
+					const unsigned int uiNumCols,
+					LoadedLevel& sLevel,
+					std::vector<char>& arrCsvText);
+
+	// Start loading a level with Load() on the worker thread, dropping the level loaded before
+	void Preload(const std::string& csvFilename, const unsigned int uiNumRows, const unsigned int uiNumCols);
+	// Get the CSV file of the level being loaded, or an empty string if there is none
+	const std::string& GetFilename(void) const;
+	// Check if the worker thread has finished loading the level
+	bool IsReady(void) const;
+	// Wait for the worker thread, and swap the level it loaded into sLevel. Returns false if it could not be loaded
+	bool Take(LoadedLevel& sLevel);
+	// Wait for the worker thread, and drop the level it loaded
+	void Cancel(void);
+
+protected:
+	// The worker thread, and whether it has finished
+	std::thread cWorker;
+	std::atomic<bool> bReady;
+	// The level being loaded, and whether it could be loaded. Only used by the worker thread until bReady is set
+	std::string filename;
+	LoadedLevel sLoadedLevel;
+	bool bLoaded;
+	// The CSV text of the worker thread
+	std::vector<char> arrCsvText;
+};
@@ -0,0 +1,236 @@
+/**
+ CLineOfSight
+ @brief A class which checks if the straight line between the centres of two tiles of a CMapLevel crosses a blocking tile.
+		It walks every tile which the line touches over a bitmask of the blocking tiles,
+		and keeps the recent results for each pair of tiles and map version.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "LineOfSight.h"
+
+#include <cstdlib>
+
+// The number of cached results. It must be a power of 2
+static const unsigned int uiCacheSize = 4096;
+
+/**
+ @brief Constructor
+ */
+CLineOfSight::CLineOfSight(void)
+	: bValid(false)
+	, uiNumQueries(0)
+	, uiNumCacheHits(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+
+	CacheEntry entry;
+	entry.ullKey = 0;
+	entry.uiMapVersion = 0;
+	entry.bValid = false;
+	entry.bVisible = false;
+	arrCache.assign(uiCacheSize, entry);
+}
+
+/**
+ @brief Destructor
+ */
+CLineOfSight::~CLineOfSight(void)
+{
+}
+
+/**
+ @brief Build the bitmask of the blocking tiles of a level
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+void CLineOfSight::Build(const CMapLevel& cLevel)
+{
+	sMapSize.uiRowSize = cLevel.GetNumRows();
+	sMapSize.uiColSize = cLevel.GetNumCols();
+
+	const unsigned int uiNumTiles = sMapSize.uiRowSize * sMapSize.uiColSize;
+	arrBlockedBits.assign((uiNumTiles + 31) / 32, 0);
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+	{
+		if (cLevel.IsBlocked(i / sMapSize.uiColSize, i % sMapSize.uiColSize))
+			arrBlockedBits[i >> 5] |= 1u << (i & 31);
+	}
+
+	// The cached results may be for another level with the same version
+	for (unsigned int i = 0; i < arrCache.size(); i++)
+		arrCache[i].bValid = false;
+
+	bValid = true;
+}
+
+/**
+ @brief Mark the bitmask as out of date
+ */
+void CLineOfSight::Invalidate(void)
+{
+	bValid = false;
+}
+
+/**
+ @brief Check if the bitmask is up to date for this level size
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+bool CLineOfSight::IsValid(const CMapLevel& cLevel) const
+{
+	return bValid &&
+		(sMapSize.uiRowSize == cLevel.GetNumRows()) &&
+		(sMapSize.uiColSize == cLevel.GetNumCols());
+}
+
+/**
+ @brief Update the bitmask after a tile changed between blocked and free
+ @param cLevel A const CMapLevel& variable containing the level, with the tile already changed
+ @param uiRow A const unsigned int variable containing the inverted row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CLineOfSight::OnTileChanged(const CMapLevel& cLevel, const unsigned int uiRow, const unsigned int uiCol)
+{
+	if (!bValid)
+		return;
+
+	const unsigned int i = uiRow * sMapSize.uiColSize + uiCol;
+	if (cLevel.IsBlocked(uiRow, uiCol))
+		arrBlockedBits[i >> 5] |= 1u << (i & 31);
+	else
+		arrBlockedBits[i >> 5] &= ~(1u << (i & 31));
+}
+
+/**
+ @brief Check if no blocking tile lies between two tiles
+ @param observerPos A const glm::vec2& variable containing the tile of the observer
+ @param targetPos A const glm::vec2& variable containing the tile being looked at
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ */
+bool CLineOfSight::HasLineOfSight(const glm::vec2& observerPos, const glm::vec2& targetPos, const unsigned int uiMapVersion)
+{
+	uiNumQueries++;
+
+	const int iObserverX = (int)observerPos.x;
+	const int iObserverY = (int)observerPos.y;
+	const int iTargetX = (int)targetPos.x;
+	const int iTargetY = (int)targetPos.y;
+	if (IsBlocked(iObserverX, iObserverY) || IsBlocked(iTargetX, iTargetY))
+		return false;
+
+	// The line touches the same tiles in both directions, so both orders of a pair share a result
+	unsigned int uiObserver = (unsigned int)(iObserverY * (int)sMapSize.uiColSize + iObserverX);
+	unsigned int uiTarget = (unsigned int)(iTargetY * (int)sMapSize.uiColSize + iTargetX);
+	if (uiTarget < uiObserver)
+	{
+		const unsigned int uiTemp = uiObserver;
+		uiObserver = uiTarget;
+		uiTarget = uiTemp;
+	}
+	const unsigned long long ullKey = ((unsigned long long)uiObserver << 32) | uiTarget;
+
+	CacheEntry& entry = arrCache[(uiObserver * 2654435761u + uiTarget) & (uiCacheSize - 1)];
+	if (entry.bValid && (entry.ullKey == ullKey) && (entry.uiMapVersion == uiMapVersion))
+	{
+		uiNumCacheHits++;
+		return entry.bVisible;
+	}
+
+	entry.ullKey = ullKey;
+	entry.uiMapVersion = uiMapVersion;
+	entry.bValid = true;
+	entry.bVisible = CastRay(iObserverX, iObserverY, iTargetX, iTargetY);
+	return entry.bVisible;
+}
+
+/**
+ @brief Check many pairs of tiles at once
+ @param pQueries A const LineOfSightQuery* variable containing the queries
+ @param uiNumQueries A const unsigned int variable containing the number of queries
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ @param pbResults A bool* variable which will store whether each target can be seen by its observer
+ */
+void CLineOfSight::HasLineOfSight(const LineOfSightQuery* pQueries,
+	const unsigned int uiNumQueries,
+	const unsigned int uiMapVersion,
+	bool* pbResults)
+{
+	for (unsigned int i = 0; i < uiNumQueries; i++)
+		pbResults[i] = HasLineOfSight(pQueries[i].observerPos, pQueries[i].targetPos, uiMapVersion);
+}
+
+/**
+ @brief Walk every tile which the line between the centres of two tiles touches, without the cache.
+		The two end tiles are not checked. Where the line passes exactly through the corner of 4 tiles,
+		it can only pass if at least one of the 2 tiles beside the corner is free.
+ @param iObserverX A const int variable containing the column of the observer
+ @param iObserverY A const int variable containing the inverted row of the observer
+ @param iTargetX A const int variable containing the column of the target
+ @param iTargetY A const int variable containing the inverted row of the target
+ */
+bool CLineOfSight::CastRay(const int iObserverX, const int iObserverY, const int iTargetX, const int iTargetY) const
+{
+	const int iStepX = (iTargetX > iObserverX) ? 1 : -1;
+	const int iStepY = (iTargetY > iObserverY) ? 1 : -1;
+	const int iDeltaX = std::abs(iTargetX - iObserverX);
+	const int iDeltaY = std::abs(iTargetY - iObserverY);
+
+	// The error tells whether the line leaves the current tile through a vertical side, a horizontal side or a corner
+	int iError = iDeltaX - iDeltaY;
+	int iX = iObserverX;
+	int iY = iObserverY;
+	for (int iNumSteps = iDeltaX + iDeltaY; iNumSteps > 0; iNumSteps--)
+	{
+		if (iError > 0)
+		{
+			iX += iStepX;
+			iError -= 2 * iDeltaY;
+		}
+		else if (iError < 0)
+		{
+			iY += iStepY;
+			iError += 2 * iDeltaX;
+		}
+		else
+		{
+			if (IsBlocked(iX + iStepX, iY) && IsBlocked(iX, iY + iStepY))
+				return false;
+			iX += iStepX;
+			iY += iStepY;
+			iError += 2 * (iDeltaX - iDeltaY);
+			iNumSteps--;
+		}
+
+		if (((iX != iTargetX) || (iY != iTargetY)) && IsBlocked(iX, iY))
+			return false;
+	}
+	return true;
+}
+
+/**
+ @brief Get the number of queries so far
+ */
+unsigned int CLineOfSight::GetNumQueries(void) const
+{
+	return uiNumQueries;
+}
+
+/**
+ @brief Get the number of queries answered by the cache
+ */
+unsigned int CLineOfSight::GetNumCacheHits(void) const
+{
+	return uiNumCacheHits;
+}
+
+/**
+ @brief Check if a tile is blocked, or outside the level
+ @param iX A const int variable containing the column of the tile
+ @param iY A const int variable containing the inverted row of the tile
+ */
+bool CLineOfSight::IsBlocked(const int iX, const int iY) const
+{
+	if ((iX < 0) || (iX >= (int)sMapSize.uiColSize) || (iY < 0) || (iY >= (int)sMapSize.uiRowSize))
+		return true;
+	const unsigned int i = (unsigned int)(iY * (int)sMapSize.uiColSize + iX);
+	return (arrBlockedBits[i >> 5] & (1u << (i & 31))) != 0;
+}
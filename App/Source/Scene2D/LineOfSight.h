@@ -0,0 +1,89 @@
+/**
+ CLineOfSight
+ @brief A class which checks if the straight line between the centres of two tiles of a CMapLevel crosses a blocking tile.
+		It walks every tile which the line touches over a bitmask of the blocking tiles,
+		and keeps the recent results for each pair of tiles and map version.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <vector>
+
+// A line of sight query. Positions are (column, inverted row)
+struct LineOfSightQuery
+{
+	glm::vec2 observerPos;
+	glm::vec2 targetPos;
+};
+
+class CLineOfSight
+{
+public:
+	// Constructor
+	CLineOfSight(void);
+
+	// Destructor
+	~CLineOfSight(void);
+
+	// Build the bitmask of the blocking tiles of cLevel
+	void Build(const CMapLevel& cLevel);
+
+	// Mark the bitmask as out of date, e.g. when a new map was loaded
+	void Invalidate(void);
+
+	// Check if the bitmask is up to date for this level size
+	bool IsValid(const CMapLevel& cLevel) const;
+
+	// Update the bitmask after a tile changed between blocked and free. The row is inverted, like the path positions
+	void OnTileChanged(const CMapLevel& cLevel, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Check if no blocking tile lies between two tiles. uiMapVersion identifies the state of the level for the cached results
+	bool HasLineOfSight(const glm::vec2& observerPos, const glm::vec2& targetPos, const unsigned int uiMapVersion);
+	// Check many pairs of tiles at once, and store the result of each query in pbResults
+	void HasLineOfSight(const LineOfSightQuery* pQueries,
+						const unsigned int uiNumQueries,
+						const unsigned int uiMapVersion,
+						bool* pbResults);
+
+	// Walk the tiles between two tiles without the cache
+	bool CastRay(const int iObserverX, const int iObserverY, const int iTargetX, const int iTargetY) const;
+
+	// Get the number of queries so far, and how many of them were answered by the cache
+	unsigned int GetNumQueries(void) const;
+	unsigned int GetNumCacheHits(void) const;
+
+protected:
+	// A cached result for a pair of tiles
+	struct CacheEntry
+	{
+		unsigned long long ullKey;
+		unsigned int uiMapVersion;
+		bool bValid;
+		bool bVisible;
+	};
+
+	// Whether the bitmask is up to date
+	bool bValid;
+	// The size of the level the bitmask was built for
+	MapSize sMapSize;
+
+	// One bit per tile, set if it is blocked
+	std::vector<unsigned int> arrBlockedBits;
+
+	// The cached results. Each pair of tiles can only be stored in one place, which it shares with other pairs
+	std::vector<CacheEntry> arrCache;
+
+	// Counters
+	unsigned int uiNumQueries;
+	unsigned int uiNumCacheHits;
+
+	// Check if a tile is blocked, or outside the level
+	bool IsBlocked(const int iX, const int iY) const;
+};
@@ -17,15 +17,24 @@
 
 #include <iostream>
 #include <vector>
-// For AStar PathFinding
-using namespace std::placeholders;
+#include <algorithm>
+#include <iterator>
 
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CMap2D::CMap2D(void)
-	: uiCurLevel(0)
+	: uiPreloadLevel(0)
+	, uiCurLevel(0)
 	, quadMesh(NULL)
+	, uiFlowFieldClock(0)
+	, uiPathFindBudget(2000)
+	, uiTimeSlicedRotation(0)
+	, uiNumTimeSlicedFinished(0)
+	, uiTimeSlicedFrames(0)
+	, uiMaxTimeSlicedFrames(0)
+	, uiNextValueListenerID(1)
+	, ePathSmoothing(pathsmoothing::NONE)
 {
 }
 
@@ -34,16 +43,16 @@ CMap2D::CMap2D(void)
  */
 CMap2D::~CMap2D(void)
 {
-	// Dynamically deallocate the 3D array used to store the map information
-	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
-	{
-		for (unsigned int iRow = 0; iRow < cSettings->NUM_TILES_YAXIS; iRow++)
-		{
-			delete[] arrMapInfo[uiLevel][iRow];
-		}
-		delete[] arrMapInfo[uiLevel];
-	}
-	delete[] arrMapInfo;
+	// Stop the path request workers before the levels go away
+	cPathRequestQueue.Destroy();
+	// Finish writing the saves
+	cMapSaver.Destroy();
+
+	// Write the edited chunks of the streamed levels back
+	arrStreamedLevels.clear();
+
+	// Deallocate the levels used to store the map information
+	arrMapInfo.clear();
 
 	if (quadMesh)
 	{
@@ -51,9 +60,6 @@ CMap2D::~CMap2D(void)
 		quadMesh = NULL;
 	}
 
-	// Delete AStar lists
-	DeleteAStarLists();
-
 	// optional: de-allocate all resources once they've outlived their purpose:
 	glDeleteVertexArrays(1, &VAO);
 	glDeleteBuffers(1, &VBO);
@@ -73,21 +79,45 @@ bool CMap2D::Init(const unsigned int uiNumLevels,
 	// Get the handler to the CSettings instance
 	cSettings = CSettings::GetInstance();
 
+	// Drop a level which was being preloaded for the levels before
+	cLevelLoader.Cancel();
+
 	// Create the arrMapInfo and initialise to 0
-	// Start by initialising the number of levels
-	arrMapInfo = new Grid * *[uiNumLevels];
+	// Each level stores its tiles in one contiguous array
+	arrMapInfo.resize(uiNumLevels);
 	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		arrMapInfo[uiLevel] = new Grid * [uiNumRows];
-		for (unsigned uiRow = 0; uiRow < uiNumRows; uiRow++)
-		{
-			arrMapInfo[uiLevel][uiRow] = new Grid[uiNumCols];
-			for (unsigned uiCol = 0; uiCol < uiNumCols; uiCol++)
-			{
-				arrMapInfo[uiLevel][uiRow][uiCol].value = 0;
-			}
-		}
+		arrMapInfo[uiLevel].Init(uiNumRows, uiNumCols);
 	}
+	arrJumpTables.resize(uiNumLevels);
+	arrClusterGraphs.resize(uiNumLevels);
+	arrReachabilityIndices.resize(uiNumLevels);
+	arrLinesOfSight.resize(uiNumLevels);
+	arrPotentiallyVisibleSets.resize(uiNumLevels);
+	arrValueIndices.resize(uiNumLevels);
+	arrChangeJournals.resize(uiNumLevels);
+	arrColumnLabels.resize(uiNumLevels);
+	arrStreamedLevels.clear();
+	arrStreamedLevels.resize(uiNumLevels);
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		arrClusterGraphs[uiLevel].Init(uiNumRows, uiNumCols);
+		arrValueIndices[uiLevel].Build(arrMapInfo[uiLevel]);
+		arrChangeJournals[uiLevel].Reset(arrMapInfo[uiLevel]);
+	}
+	// Keep a flow field for each of the targets which can be chased at the same time
+	arrFlowFields.resize(4);
+	arrFlowFieldUses.assign(arrFlowFields.size(), 0);
+	arrMapVersions.assign(uiNumLevels, 0);
+	arrSnapshots.assign(uiNumLevels, std::shared_ptr<const CMapLevel>());
+	arrSnapshotVersions.assign(uiNumLevels, 0);
+	arrSaveSnapshots.assign(uiNumLevels, std::shared_ptr<CMapLevel>());
+	arrSaveSnapshotVersions.assign(uiNumLevels, 0);
+
+	// Leave one core for the main thread
+	const unsigned int uiNumCores = std::thread::hardware_concurrency();
+	cPathRequestQueue.Init(uiNumCores > 1 ? std::min(uiNumCores - 1, 4u) : 1);
+	cMapSaver.Init();
 
 	// Store the map sizes in cSettings
 	uiCurLevel = 0;
@@ -102,101 +132,24 @@ bool CMap2D::Init(const unsigned int uiNumLevels,
 	//CS: Create the Quad Mesh using the mesh builder
 	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
 
-	// Load and create textures
-#pragma region MyRegion
-   // Load the ground texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Assets/wall.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Assets/wall.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(100, iTextureID));
-	}
-
-	// Load the tree texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Flare.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/carrot.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(2, iTextureID));
-	}
-
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Flare.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/carrot.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(3, iTextureID));
-	}
-
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Cornflakes.tga", true);
-	if (iTextureID == 0)
+	// Load the textures of the tile types. The types which share a texture file share its texture ID
+	for (unsigned int uiType = 0; uiType < tiletype::NUM_TILETYPES; uiType++)
 	{
-		cout << "Unable to load Image/carrot.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(4, iTextureID));
-	}
+		arrTextureIDs[uiType] = 0;
+		const char* pTextureFile = tiletype::arrTileTypes[uiType].pTextureFile;
+		if (pTextureFile == NULL)
+			continue;
 
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Cornflakes.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/carrot.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(5, iTextureID));
-	}
-
-	
-	// Load the Exit texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Exit.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_Exit.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(99, iTextureID));
+		arrTextureIDs[uiType] = CImageLoader::GetInstance()->LoadTextureGetID(pTextureFile, true);
+		if (arrTextureIDs[uiType] == 0)
+		{
+			cout << "Unable to load " << pTextureFile << endl;
+			return false;
+		}
 	}
 
-#pragma endregion
-
-	// Initialise the variables for AStar
-	m_weight = 1;
-	m_startPos = glm::vec2(0, 0);
-	m_targetPos = glm::vec2(0, 0);
-	//m_size = cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS;
-
-	m_nrOfDirections = 4;
-	m_directions = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
-						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
-
-
-
-	// Resize these 2 lists
-	m_cameFromList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
-	m_closedList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS, false);
+	// Initialise the search lists for AStar
+	cPathFinder.Init(uiNumRows, uiNumCols);
 
 	return true;
 }
@@ -209,266 +162,438 @@ std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos,
 	HeuristicFunction heuristicFunc,
 	int weight)
 {
-	// Check if the startPos and targetPost are blocked
-	if (isBlocked(startPos.y, startPos.x) ||
-		(isBlocked(targetPos.y, targetPos.x)))
-	{
-		cout << "Invalid start or target position." << endl;
-		// Return an empty path
-		std::vector<glm::vec2> path;
+	// A search for a target which cannot be reached would visit every tile it can reach before giving up
+	std::vector<glm::vec2> path;
+	if (!IsReachable(startPos, targetPos))
 		return path;
+
+	// The cache keeps the tile by tile paths, so that a path through the start of a query can still answer it
+	const CPathCache::Key sKey = GetPathCacheKey(startPos, targetPos, heuristicFunc, weight);
+	if (!cPathCache.Find(sKey, path))
+	{
+		path = cPathFinder.PathFind(arrMapInfo[uiCurLevel], startPos, targetPos, heuristicFunc, weight, &arrJumpTables[uiCurLevel]);
+		cPathCache.Store(sKey, path);
 	}
+	SmoothPath(startPos, path);
+	return path;
+}
 
-	// Set up the variables and lists
-	m_startPos = startPos;
-	m_targetPos = targetPos;
-	m_weight = weight;
-	m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
+/**
+ @brief Find a path with Hierarchical PathFinding
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ */
+std::vector<glm::vec2> CMap2D::HierarchicalPathFind(const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	int weight)
+{
+	if (!IsReachable(startPos, targetPos))
+		return std::vector<glm::vec2>();
 
-	// Reset AStar lists
-	ResetAStarLists();
+	std::vector<glm::vec2> path = arrClusterGraphs[uiCurLevel].PathFind(arrMapInfo[uiCurLevel], cPathFinder, startPos, targetPos, heuristicFunc, weight);
+	SmoothPath(startPos, path);
+	return path;
+}
 
-	// Add the start pos to 2 lists
-	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
-	m_openList.push(Grid(m_startPos, 0));
+/**
+ @brief Find the paths of a batch of queries on the current level
+ @param pQueries A const PathQuery* variable containing the queries
+ @param uiNumQueries A const unsigned int variable containing the number of queries
+ @param cWorkspace A CPathWorkspace& variable containing the search lists, owned by the caller
+ @param cArena A CPathArena& variable which will store the paths, in the order of the queries
+ */
+void CMap2D::PathFindBatch(const PathQuery* pQueries,
+	const unsigned int uiNumQueries,
+	CPathWorkspace& cWorkspace,
+	CPathArena& cArena)
+{
+	const unsigned int uiNrOfDirections = cPathFinder.GetDiagonalMovement() ? 8 : 4;
+	CReachabilityIndex& cReachabilityIndex = arrReachabilityIndices[uiCurLevel];
+	if (!cReachabilityIndex.IsValid(arrMapInfo[uiCurLevel], uiNrOfDirections))
+		cReachabilityIndex.Build(arrMapInfo[uiCurLevel], uiNrOfDirections);
+	cWorkspace.PathFindBatch(arrMapInfo[uiCurLevel], pQueries, uiNumQueries, uiNrOfDirections, cArena, &cReachabilityIndex);
+}
 
-	unsigned int fNew, gNew, hNew;
-	glm::vec2 currentPos;
+/**
+ @brief Check if a path exists between two positions on the current level.
+		The connected regions are labelled the first time they are needed, and then kept up to date by SetMapInfo
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+bool CMap2D::IsReachable(const glm::vec2& startPos, const glm::vec2& targetPos)
+{
+	const unsigned int uiNrOfDirections = cPathFinder.GetDiagonalMovement() ? 8 : 4;
+	CReachabilityIndex& cReachabilityIndex = arrReachabilityIndices[uiCurLevel];
+	if (!cReachabilityIndex.IsValid(arrMapInfo[uiCurLevel], uiNrOfDirections))
+		cReachabilityIndex.Build(arrMapInfo[uiCurLevel], uiNrOfDirections);
+	return cReachabilityIndex.IsConnected(startPos, targetPos);
+}
+
+/**
+ @brief Check if no blocking tile lies between two tiles of the current level.
+		The visible sets answer it while they are up to date. Otherwise the blocking tiles are copied into a bitmask
+		the first time they are needed, and then kept up to date by SetMapInfo
+ @param observerPos A const glm::vec2& variable containing the position of the observer
+ @param targetPos A const glm::vec2& variable containing the position being looked at
+ */
+bool CMap2D::HasLineOfSight(const glm::vec2& observerPos, const glm::vec2& targetPos)
+{
+	const CPotentiallyVisibleSet& cPotentiallyVisibleSet = arrPotentiallyVisibleSets[uiCurLevel];
+	if (cPotentiallyVisibleSet.IsValid(arrMapVersions[uiCurLevel]))
+		return cPotentiallyVisibleSet.IsVisible(observerPos, targetPos);
+
+	CLineOfSight& cLineOfSight = arrLinesOfSight[uiCurLevel];
+	if (!cLineOfSight.IsValid(arrMapInfo[uiCurLevel]))
+		cLineOfSight.Build(arrMapInfo[uiCurLevel]);
+	return cLineOfSight.HasLineOfSight(observerPos, targetPos, arrMapVersions[uiCurLevel]);
+}
 
-	// Start the path finding...
-	while (!m_openList.empty())
+/**
+ @brief Check many (observer, target) pairs on the current level at once
+ @param pQueries A const LineOfSightQuery* variable containing the queries
+ @param uiNumQueries A const unsigned int variable containing the number of queries
+ @param pbResults A bool* variable which will store whether each target can be seen by its observer
+ */
+void CMap2D::HasLineOfSight(const LineOfSightQuery* pQueries, const unsigned int uiNumQueries, bool* pbResults)
+{
+	const CPotentiallyVisibleSet& cPotentiallyVisibleSet = arrPotentiallyVisibleSets[uiCurLevel];
+	if (cPotentiallyVisibleSet.IsValid(arrMapVersions[uiCurLevel]))
 	{
-		// Get the node with the least f value
-		currentPos = m_openList.top().pos;
-		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
-		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+		for (unsigned int i = 0; i < uiNumQueries; i++)
+			pbResults[i] = cPotentiallyVisibleSet.IsVisible(pQueries[i].observerPos, pQueries[i].targetPos);
+		return;
+	}
 
-		// If the targetPos was reached, then quit this loop
-		if (currentPos == m_targetPos)
-		{
-			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-			while (m_openList.size() != 0)
-				m_openList.pop();
-			break;
-		}///
+	CLineOfSight& cLineOfSight = arrLinesOfSight[uiCurLevel];
+	if (!cLineOfSight.IsValid(arrMapInfo[uiCurLevel]))
+		cLineOfSight.Build(arrMapInfo[uiCurLevel]);
+	cLineOfSight.HasLineOfSight(pQueries, uiNumQueries, arrMapVersions[uiCurLevel], pbResults);
+}
 
-		m_openList.pop();
-		m_closedList[ConvertTo1D(currentPos)] = true;
+/**
+ @brief Get the flow field towards a target tile on the current level
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+const CFlowField& CMap2D::GetFlowField(const glm::vec2& targetPos)
+{
+	const CMapLevel& cLevel = arrMapInfo[uiCurLevel];
+	const unsigned int uiNrOfDirections = cPathFinder.GetDiagonalMovement() ? 8 : 4;
+	uiFlowFieldClock++;
 
-		// Check the neighbors of the current node
-		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
+	// Reuse the flow field towards this target if it is still up to date
+	unsigned int uiOldest = 0;
+	for (unsigned int i = 0; i < arrFlowFields.size(); i++)
+	{
+		if (arrFlowFields[i].IsValid(cLevel, targetPos, uiNrOfDirections))
 		{
-			const auto neighborPos = currentPos + m_directions[i];
-			const auto neighborIndex = ConvertTo1D(neighborPos);
+			arrFlowFieldUses[i] = uiFlowFieldClock;
+			return arrFlowFields[i];
+		}
+		if (arrFlowFieldUses[i] < arrFlowFieldUses[uiOldest])
+			uiOldest = i;
+	}
 
-			//cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
-			if (!isValid(neighborPos) ||
-				isBlocked(neighborPos.y, neighborPos.x) ||
-				m_closedList[neighborIndex] == true)
-			{
-				//cout << "This position is not valid. Going to next neighbour." << endl;
-				continue;
-			}
+	// Otherwise compute it in place of the least recently used flow field
+	arrFlowFields[uiOldest].Compute(cLevel, targetPos, uiNrOfDirections);
+	arrFlowFieldUses[uiOldest] = uiFlowFieldClock;
+	return arrFlowFields[uiOldest];
+}
+
+/**
+ @brief Update an agent's incremental planner towards a target on the current level
+ @param cPlanner A CIncrementalPlanner& variable containing the planner of the agent
+ @param startPos A const glm::vec2& variable containing the position of the agent
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+bool CMap2D::Replan(CIncrementalPlanner& cPlanner, const glm::vec2& startPos, const glm::vec2& targetPos)
+{
+	// The planner keeps the tiles which changed meanwhile, so it can skip the frames in which the target cannot be reached
+	if (!IsReachable(startPos, targetPos))
+		return false;
 
-			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1;
-			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
-			fNew = gNew + hNew;
+	return cPlanner.Replan(arrMapInfo[uiCurLevel], startPos, targetPos, cPathFinder.GetDiagonalMovement() ? 8 : 4);
+}
 
-			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
-			{
-				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
-				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
-				m_openList.push(Grid(neighborPos, fNew));
-				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
-			}
-			else
-			{
-				//cout << "Not adding this" << endl;
-			}
-		}
-		//system("pause");
-	}
+/**
+ @brief Add an incremental planner which is told about every blocking tile that changes
+ @param pPlanner A CIncrementalPlanner* variable containing the planner
+ */
+void CMap2D::AddIncrementalPlanner(CIncrementalPlanner* pPlanner)
+{
+	if (std::find(arrIncrementalPlanners.begin(), arrIncrementalPlanners.end(), pPlanner) == arrIncrementalPlanners.end())
+		arrIncrementalPlanners.push_back(pPlanner);
+}
 
-	return BuildPath();
+/**
+ @brief Remove an incremental planner
+ @param pPlanner A CIncrementalPlanner* variable containing the planner
+ */
+void CMap2D::RemoveIncrementalPlanner(CIncrementalPlanner* pPlanner)
+{
+	arrIncrementalPlanners.erase(std::remove(arrIncrementalPlanners.begin(), arrIncrementalPlanners.end(), pPlanner),
+								arrIncrementalPlanners.end());
 }
 
 /**
- @brief Build a path
+ @brief Queue a path search on the worker threads, over a snapshot of the current level
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ @param callback A PathCallback variable containing the function which receives the path
  */
-std::vector<glm::vec2> CMap2D::BuildPath() const
+unsigned int CMap2D::RequestPath(const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	int weight,
+	PathCallback callback)
 {
+	// A path found before, or no path if the target cannot be reached,
+	// is handed to the callback at the next sync point without searching
 	std::vector<glm::vec2> path;
-	auto currentPos = m_targetPos;
-	auto currentIndex = ConvertTo1D(currentPos);
-
-	while (!(m_cameFromList[currentIndex].parent == currentPos))
+	if (!IsReachable(startPos, targetPos))
+		return cPathRequestQueue.Request(path, callback);
+	const CPathCache::Key sKey = GetPathCacheKey(startPos, targetPos, heuristicFunc, weight);
+	if (cPathCache.Find(sKey, path))
 	{
-		path.push_back(currentPos);
-		currentPos = m_cameFromList[currentIndex].parent;
-		currentIndex = ConvertTo1D(currentPos);
+		SmoothPath(startPos, path);
+		return cPathRequestQueue.Request(path, callback);
 	}
 
-	// If the path has only 1 entry, then it is the the target position
-	if (path.size() == 1)
+	// Copy the level only when it has changed since the last snapshot. The workers may still be reading older ones
+	if (!arrSnapshots[uiCurLevel] || (arrSnapshotVersions[uiCurLevel] != arrMapVersions[uiCurLevel]))
 	{
-		// if m_startPos is next to m_targetPos, then having 1 path point is OK
-		if (m_nrOfDirections == 4)
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
-		else
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
-				path.clear();
-			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
+		arrSnapshots[uiCurLevel] = std::make_shared<const CMapLevel>(arrMapInfo[uiCurLevel]);
+		arrSnapshotVersions[uiCurLevel] = arrMapVersions[uiCurLevel];
 	}
-	else
-		std::reverse(path.begin(), path.end());
 
-	return path;
+	return cPathRequestQueue.Request(arrSnapshots[uiCurLevel], &arrMapInfo[uiCurLevel], arrMapVersions[uiCurLevel],
+									startPos, targetPos, heuristicFunc, weight,
+									cPathFinder.GetDiagonalMovement() ? 8 : 4, cPathFinder.GetSearchMode(),
+									[this, sKey, startPos, callback](const unsigned int uiRequestID, const std::vector<glm::vec2>& path)
+									{
+										cPathCache.Store(sKey, path);
+										if (callback)
+										{
+											std::vector<glm::vec2> smoothedPath = path;
+											SmoothPath(startPos, smoothedPath);
+											callback(uiRequestID, smoothedPath);
+										}
+									});
 }
 
 /**
- @brief Toggle the checks for diagonal movements
+ @brief Cancel a path request
+ @param uiRequestID A const unsigned int variable containing the ID of the request
  */
-void CMap2D::SetDiagonalMovement(const bool bEnable)
+void CMap2D::CancelPathRequest(const unsigned int uiRequestID)
 {
-	m_nrOfDirections = (bEnable) ? 8 : 4;
+	cPathRequestQueue.Cancel(uiRequestID);
 }
 
 /**
- @brief Print out the details about this class instance in the console
+ @brief The sync point for the path requests
  */
-void CMap2D::PrintSelf(void) const
+void CMap2D::SyncPathRequests(void)
 {
-	cout << endl << "AStar::PrintSelf()" << endl;
+	cPathRequestQueue.DeliverResults();
+}
 
-	cout << "Level: 1" << endl;
-	for (unsigned uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+/**
+ @brief Get the version of the current level
+ */
+unsigned int CMap2D::GetMapVersion(void) const
+{
+	return arrMapVersions[uiCurLevel];
+}
+
+/**
+ @brief Start a time sliced search on the current level
+ @param pSearch A CTimeSlicedSearch* variable containing the search, owned by the caller
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ */
+void CMap2D::StartTimeSlicedSearch(CTimeSlicedSearch* pSearch,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	int weight)
+{
+	pSearch->Begin(arrMapInfo[uiCurLevel], startPos, targetPos, cPathFinder.GetDiagonalMovement() ? 8 : 4, heuristicFunc, weight);
+
+	// A path found before, or a target which cannot be reached, finishes the search at once
+	const CPathCache::Key sKey = GetPathCacheKey(startPos, targetPos, heuristicFunc, weight);
+	std::vector<glm::vec2> path;
+	if ((!IsReachable(startPos, targetPos)) || cPathCache.Find(sKey, path))
 	{
-		for (unsigned uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		StopTimeSlicedSearch(pSearch);
+		pSearch->Finish(path);
+		return;
+	}
+
+	const unsigned int uiIndex = (unsigned int)(std::find(arrTimeSlicedSearches.begin(), arrTimeSlicedSearches.end(), pSearch)
+												- arrTimeSlicedSearches.begin());
+	if (uiIndex == arrTimeSlicedSearches.size())
+	{
+		arrTimeSlicedSearches.push_back(pSearch);
+		arrTimeSlicedKeys.push_back(sKey);
+	}
+	else
+		arrTimeSlicedKeys[uiIndex] = sKey;
+}
+
+/**
+ @brief Stop a time sliced search before it has finished
+ @param pSearch A CTimeSlicedSearch* variable containing the search
+ */
+void CMap2D::StopTimeSlicedSearch(CTimeSlicedSearch* pSearch)
+{
+	pSearch->Stop();
+	for (unsigned int i = 0; i < arrTimeSlicedSearches.size(); i++)
+	{
+		if (arrTimeSlicedSearches[i] == pSearch)
 		{
-			cout.fill('0');
-			cout.width(3);
-			cout << arrMapInfo[0][uiRow][uiCol].value;
-			if (uiCol != cSettings->NUM_TILES_XAXIS - 1)
-				cout << ", ";
-			else
-				cout << endl;
+			arrTimeSlicedSearches.erase(arrTimeSlicedSearches.begin() + i);
+			arrTimeSlicedKeys.erase(arrTimeSlicedKeys.begin() + i);
+			break;
 		}
 	}
+}
 
-	cout << "m_openList: " << m_openList.size() << endl;
-	cout << "m_cameFromList: " << m_cameFromList.size() << endl;
-	cout << "m_closedList: " << m_closedList.size() << endl;
-
-	cout << "===== AStar::PrintSelf() =====" << endl;
+/**
+ @brief Get the cache of the paths found before
+ */
+const CPathCache& CMap2D::GetPathCache(void) const
+{
+	return cPathCache;
 }
 
 /**
- @brief Check if a position is valid
+ @brief Get the path cache key of a search on the current level
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A const HeuristicFunction& variable containing the heuristic to use
+ @param weight A const int variable containing the weight of the heuristic
  */
-bool CMap2D::isValid(const glm::vec2& pos) const
+CPathCache::Key CMap2D::GetPathCacheKey(const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	const HeuristicFunction& heuristicFunc,
+	const int weight) const
 {
-	//return (pos.x >= 0) && (pos.x < m_dimensions.x) &&
-	//	(pos.y >= 0) && (pos.y < m_dimensions.y);
-	return (pos.x >= 0) && (pos.x < cSettings->NUM_TILES_XAXIS) &&
-		(pos.y >= 0) && (pos.y < cSettings->NUM_TILES_YAXIS);
+	CPathCache::Key sKey;
+	sKey.pLevelID = &arrMapInfo[uiCurLevel];
+	sKey.uiMapVersion = arrMapVersions[uiCurLevel];
+	sKey.startPos = startPos;
+	sKey.targetPos = targetPos;
+	sKey.pHeuristicID = CPathCache::GetHeuristicID(heuristicFunc);
+	sKey.weight = weight;
+	sKey.uiNrOfDirections = cPathFinder.GetDiagonalMovement() ? 8 : 4;
+	return sKey;
 }
 
 /**
- @brief Check if a grid is blocked
+ @brief Set the number of nodes which all the time sliced searches may expand in one frame
+ @param uiNodesPerFrame A const unsigned int variable containing the number of nodes
  */
-bool CMap2D::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
+void CMap2D::SetPathFindBudget(const unsigned int uiNodesPerFrame)
 {
-	if (bInvert == true)
-	{
-		if ((arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
-	else
-	{
-		if ((arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
+	uiPathFindBudget = uiNodesPerFrame;
 }
 
 /**
- @brief Returns a 1D index based on a 2D coordinate using row-major layout
+ @brief Get the number of nodes which all the time sliced searches may expand in one frame
  */
-int CMap2D::ConvertTo1D(const glm::vec2& pos) const
+unsigned int CMap2D::GetPathFindBudget(void) const
 {
-	//return (pos.y * m_dimensions.x) + pos.x;
-	return (pos.y * cSettings->NUM_TILES_XAXIS) + pos.x;
+	return uiPathFindBudget;
 }
 
 /**
- @brief Delete AStar lists
+ @brief Toggle the checks for diagonal movements
  */
-bool CMap2D::DeleteAStarLists(void)
+void CMap2D::SetDiagonalMovement(const bool bEnable)
 {
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Delete m_cameFromList
-	m_cameFromList.clear();
-	// Delete m_closedList
-	m_closedList.clear();
+	cPathFinder.SetDiagonalMovement(bEnable);
+}
 
-	return true;
+/**
+ @brief Set the search algorithm used by PathFind
+ @param eSearchMode A const CPathFinder::SEARCHMODE variable containing the search algorithm
+ */
+void CMap2D::SetSearchMode(const CPathFinder::SEARCHMODE eSearchMode)
+{
+	cPathFinder.SetSearchMode(eSearchMode);
 }
 
 /**
- @brief Reset AStar lists
+ @brief Set the smoothing applied to the paths of PathFind, HierarchicalPathFind and RequestPath
+ @param ePathSmoothing A const pathsmoothing::SMOOTHINGMODE variable containing the smoothing
  */
-bool CMap2D::ResetAStarLists(void)
+void CMap2D::SetPathSmoothing(const pathsmoothing::SMOOTHINGMODE ePathSmoothing)
 {
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Reset m_cameFromList
-	for (int i = 0; i < m_cameFromList.size(); i++)
-	{
-		m_cameFromList[i].pos = glm::vec2(0, 0);
-		m_cameFromList[i].parent = glm::vec2(0, 0);
-		m_cameFromList[i].f = 0;
-		m_cameFromList[i].g = 0;
-		m_cameFromList[i].h = 0;
-	}
-	// Reset m_closedList
-	for (int i = 0; i < m_closedList.size(); i++)
-	{
-		m_closedList[i] = false;
-	}
+	this->ePathSmoothing = ePathSmoothing;
+}
 
-	return true;
+/**
+ @brief Get the smoothing applied to the paths of PathFind, HierarchicalPathFind and RequestPath
+ */
+pathsmoothing::SMOOTHINGMODE CMap2D::GetPathSmoothing(void) const
+{
+	return ePathSmoothing;
 }
 
 /**
- @brief manhattan calculation method for calculation of h
+ @brief Print out the details about this class instance in the console
  */
-unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
+void CMap2D::PrintSelf(void) const
 {
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+	cout << endl << "AStar::PrintSelf()" << endl;
+
+	cout << "Level: 1" << endl;
+	for (unsigned uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	{
+		for (unsigned uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		{
+			cout.fill('0');
+			cout.width(3);
+			cout << arrMapInfo[0].GetTile(uiRow, uiCol, false);
+			if (uiCol != cSettings->NUM_TILES_XAXIS - 1)
+				cout << ", ";
+			else
+				cout << endl;
+		}
+	}
+
+	cPathFinder.PrintSelf();
+	cPathRequestQueue.PrintSelf();
+	cPathCache.PrintSelf();
+	cout << "Visible set bytes: " << arrPotentiallyVisibleSets[uiCurLevel].GetMemorySize() << endl;
+
+	cout << "uiPathFindBudget: " << uiPathFindBudget << endl;
+	cout << "Time sliced searches running: " << arrTimeSlicedSearches.size() << endl;
+	cout << "Time sliced searches finished: " << uiNumTimeSlicedFinished << endl;
+	if (uiNumTimeSlicedFinished > 0)
+	{
+		cout << "Frames per time sliced search: " << (float)uiTimeSlicedFrames / uiNumTimeSlicedFinished
+			<< " (max " << uiMaxTimeSlicedFrames << ")" << endl;
+	}
+
+	cout << "===== AStar::PrintSelf() =====" << endl;
 }
 
 /**
- @brief euclidean calculation method for calculation of h
+ @brief Check if a grid is blocked
  */
-unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight)
+bool CMap2D::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
 {
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
+	if (arrStreamedLevels[uiCurLevel])
+		return arrStreamedLevels[uiCurLevel]->IsBlocked(uiRow, uiCol, bInvert);
+	return arrMapInfo[uiCurLevel].IsBlocked(uiRow, uiCol, bInvert);
 }
 
 /**
@@ -476,6 +601,14 @@ unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int
 */
 void CMap2D::Update(const double dElapsedTime)
 {
+	// Read the chunks around the focus of a streamed level before they are needed
+	if (arrStreamedLevels[uiCurLevel])
+		arrStreamedLevels[uiCurLevel]->Update();
+
+	RunTimeSlicedSearches();
+
+	// Tell the callbacks of the saves which have been written
+	cMapSaver.DeliverResults();
 }
 
 /**
@@ -619,10 +752,56 @@ void CMap2D::SetNumSteps(const CSettings::AXIS sAxis, const unsigned int uiValue
  */
 void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
 {
-	if (bInvert)
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value = iValue;
-	else
-		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
+	// Nothing is built from the tiles of a streamed level, so only its version has to follow the blocking tiles
+	if (arrStreamedLevels[uiCurLevel])
+	{
+		CStreamedLevel& cStreamedLevel = *arrStreamedLevels[uiCurLevel];
+		const bool bWasBlocked = cStreamedLevel.IsBlocked(uiRow, uiCol, bInvert);
+		cStreamedLevel.SetTile(uiRow, uiCol, iValue, bInvert);
+		if (cStreamedLevel.IsBlocked(uiRow, uiCol, bInvert) != bWasBlocked)
+			arrMapVersions[uiCurLevel]++;
+		return;
+	}
+
+	const bool bWasBlocked = arrMapInfo[uiCurLevel].IsBlocked(uiRow, uiCol, bInvert);
+	const int iOldValue = arrMapInfo[uiCurLevel].GetTile(uiRow, uiCol, bInvert);
+	arrMapInfo[uiCurLevel].SetTile(uiRow, uiCol, iValue, bInvert);
+	// The row counted from the bottom, flipped with the rows of this level like CMapLevel::ConvertTo1D
+	const unsigned int uiInvertedRow = bInvert ? uiRow : arrMapInfo[uiCurLevel].GetNumRows() - uiRow - 1;
+
+	// The jump distances and clusters only depend on which tiles are blocked
+	if (arrMapInfo[uiCurLevel].IsBlocked(uiRow, uiCol, bInvert) != bWasBlocked)
+	{
+		arrMapVersions[uiCurLevel]++;
+		arrJumpTables[uiCurLevel].Invalidate();
+		arrClusterGraphs[uiCurLevel].OnTileChanged(uiInvertedRow, uiCol);
+		arrReachabilityIndices[uiCurLevel].OnTileChanged(arrMapInfo[uiCurLevel], uiInvertedRow, uiCol);
+		arrLinesOfSight[uiCurLevel].OnTileChanged(arrMapInfo[uiCurLevel], uiInvertedRow, uiCol);
+		InvalidateFlowFields(uiCurLevel);
+		for (unsigned int i = 0; i < arrIncrementalPlanners.size(); i++)
+		{
+			if (arrIncrementalPlanners[i]->GetLevel() == &arrMapInfo[uiCurLevel])
+				arrIncrementalPlanners[i]->OnTileChanged(uiInvertedRow, uiCol);
+		}
+		for (unsigned int i = 0; i < arrTimeSlicedSearches.size(); i++)
+		{
+			if (arrTimeSlicedSearches[i]->GetLevel() == &arrMapInfo[uiCurLevel])
+			{
+				arrTimeSlicedSearches[i]->Restart();
+				arrTimeSlicedKeys[i].uiMapVersion = arrMapVersions[uiCurLevel];
+			}
+		}
+	}
+
+	// Move the tile to the list of its new value, and tell the listeners last, once everything else knows about it
+	if (iValue != iOldValue)
+	{
+		const unsigned int uiIndex = arrMapInfo[uiCurLevel].ConvertTo1D(uiRow, uiCol, bInvert);
+		arrChangeJournals[uiCurLevel].Record(uiInvertedRow, uiCol, iOldValue, iValue);
+		arrValueIndices[uiCurLevel].OnTileChanged(uiIndex, iOldValue, iValue);
+		NotifyValueListeners(arrMapInfo[uiCurLevel], iOldValue, uiIndex, false);
+		NotifyValueListeners(arrMapInfo[uiCurLevel], iValue, uiIndex, true);
+	}
 }
 
 /**
@@ -633,10 +812,26 @@ void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, cons
  */
 int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
 {
-	if (bInvert)
-		return arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value;
-	else
-		return arrMapInfo[uiCurLevel][uiRow][uiCol].value;
+	if (arrStreamedLevels[uiCurLevel])
+		return arrStreamedLevels[uiCurLevel]->GetTile(uiRow, uiCol, bInvert);
+	return arrMapInfo[uiCurLevel].GetTile(uiRow, uiCol, bInvert);
+}
+
+/**
+ @brief Get the item or trigger at certain indices from the item layer of the current level
+ @param uiRow A const unsigned int variable containing the row index of the tile
+ @param uiCol A const unsigned int variable containing the column index of the tile
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+int CMap2D::GetMapItem(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
+{
+	// A streamed level has no layers, so its value is checked instead
+	if (arrStreamedLevels[uiCurLevel])
+	{
+		const int iValue = arrStreamedLevels[uiCurLevel]->GetTile(uiRow, uiCol, bInvert);
+		return tiletype::IsItem(iValue) ? iValue : 0;
+	}
+	return arrMapInfo[uiCurLevel].GetItem(uiRow, uiCol, bInvert);
 }
 
 /**
@@ -644,54 +839,193 @@ int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const
  */
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
-	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
+	const string csvFilename = FileSystem::getPath(filename);
 
-	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
-	if ((cSettings->NUM_TILES_XAXIS != (unsigned int)doc.GetColumnCount()) ||
-		(cSettings->NUM_TILES_YAXIS != (unsigned int)doc.GetRowCount()))
+	// The level is no longer streamed, so write its edited chunks back
+	arrStreamedLevels[uiCurLevel].reset();
+
+	// A level preloaded from the same file is swapped in rather than read again, and a level preloaded from another file is dropped
+	LoadedLevel sLevel;
+	bool bLoaded = false;
+	if ((uiPreloadLevel == uiCurLevel) && (cLevelLoader.GetFilename() == csvFilename))
+		bLoaded = cLevelLoader.Take(sLevel);
+	else
 	{
-		cout << "Sizes of CSV map does not match declared arrMapInfo sizes." << endl;
-		return false;
+		if (uiPreloadLevel == uiCurLevel)
+			cLevelLoader.Cancel();
+		bLoaded = CLevelLoader::Load(csvFilename, cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS, sLevel, arrCsvText);
 	}
+	if (!bLoaded)
+		return false;
 
-	// Read the rows and columns of CSV data into arrMapInfo
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		// Read a row from the CSV file
-		std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+	InstallLevel(sLevel, uiCurLevel);
+	return true;
+}
+
+/**
+ @brief Start loading a map on a worker thread, while another level is played
+ @param filename A string variable containing the name of the CSV file of the map
+ @param uiLevel A const unsigned int variable containing the level
+ */
+bool CMap2D::PreloadMap(string filename, const unsigned int uiLevel)
+{
+	if (uiLevel >= uiNumLevels)
+		return false;
 
-		// Load a particular CSV value into the arrMapInfo
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; ++uiCol)
+	cLevelLoader.Preload(FileSystem::getPath(filename), cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+	uiPreloadLevel = uiLevel;
+	return true;
+}
+
+/**
+ @brief Check if a level has been preloaded, so that switching to it will not wait for the worker thread
+ @param uiLevel A const unsigned int variable containing the level
+ */
+bool CMap2D::IsMapPreloaded(const unsigned int uiLevel) const
+{
+	return (uiPreloadLevel == uiLevel) && !cLevelLoader.GetFilename().empty() && cLevelLoader.IsReady();
+}
+
+/**
+ @brief Free the tiles, and everything built from them, of a level which will not be played again
+ @param uiLevel A const unsigned int variable containing the level
+ */
+bool CMap2D::UnloadMap(const unsigned int uiLevel)
+{
+	if ((uiLevel >= uiNumLevels) || (uiLevel == uiCurLevel))
+		return false;
+
+	if (uiPreloadLevel == uiLevel)
+		cLevelLoader.Cancel();
+	arrStreamedLevels[uiLevel].reset();
+	arrSnapshots[uiLevel].reset();
+	arrSaveSnapshots[uiLevel].reset();
+
+	// The old level is swapped into sEmptyLevel, which frees it
+	LoadedLevel sEmptyLevel;
+	InstallLevel(sEmptyLevel, uiLevel);
+	return true;
+}
+
+/**
+ @brief Swap a loaded level into place, and mark everything else built from the old level as out of date
+ @param sLevel A LoadedLevel& variable containing the level, which will store the old level
+ @param uiLevel A const unsigned int variable containing the level
+ */
+void CMap2D::InstallLevel(LoadedLevel& sLevel, const unsigned int uiLevel)
+{
+	arrMapInfo[uiLevel].Swap(sLevel.cLevel);
+	arrColumnLabels[uiLevel].swap(sLevel.columnLabels);
+
+	arrMapVersions[uiLevel]++;
+	arrJumpTables[uiLevel].Invalidate();
+	arrClusterGraphs[uiLevel].Invalidate();
+	arrReachabilityIndices[uiLevel].Invalidate();
+	arrLinesOfSight[uiLevel].Invalidate();
+	InvalidateFlowFields(uiLevel);
+	arrChangeJournals[uiLevel].Reset(arrMapInfo[uiLevel]);
+	// The old level and its index are left in sLevel, to tell the listeners which tiles changed
+	arrValueIndices[uiLevel].Swap(sLevel.cValueIndex);
+	if ((uiLevel == uiCurLevel) && !arrValueListeners.empty())
+		NotifyValueListeners(sLevel.cLevel, sLevel.cValueIndex, arrMapInfo[uiLevel], arrValueIndices[uiLevel]);
+	arrPotentiallyVisibleSets[uiLevel].Swap(sLevel.cVisibleSet);
+	arrPotentiallyVisibleSets[uiLevel].SetMapVersion(arrMapVersions[uiLevel]);
+	for (unsigned int i = 0; i < arrIncrementalPlanners.size(); i++)
+	{
+		if (arrIncrementalPlanners[i]->GetLevel() == &arrMapInfo[uiLevel])
+			arrIncrementalPlanners[i]->Invalidate();
+	}
+	for (unsigned int i = 0; i < arrTimeSlicedSearches.size(); i++)
+	{
+		if (arrTimeSlicedSearches[i]->GetLevel() == &arrMapInfo[uiLevel])
 		{
-			arrMapInfo[uiCurLevel][uiRow][uiCol].value = (int)stoi(row[uiCol]);
+			arrTimeSlicedSearches[i]->Restart();
+			arrTimeSlicedKeys[i].uiMapVersion = arrMapVersions[uiLevel];
 		}
 	}
+}
 
+/**
+ @brief Save the tilemap to a text file. The tiles are copied into a snapshot, which the I/O thread writes
+ @param filename A string variable containing the name of the text file to save the map to
+ @param uiCurLevel A const unsigned int variable containing the level
+ @param callback A SaveCallback variable containing the function which is told if the map was written
+ */
+bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel, SaveCallback callback)
+{
+	if (uiCurLevel >= uiNumLevels)
+		return false;
+
+	// A streamed level is not all in memory, so it is kept in its chunk file rather than written as a CSV file
+	if (arrStreamedLevels[uiCurLevel])
+		return arrStreamedLevels[uiCurLevel]->Flush();
+
+	cMapSaver.Save(GetSaveSnapshot(uiCurLevel), arrColumnLabels[uiCurLevel], FileSystem::getPath(filename), callback);
 	return true;
 }
 
 /**
- @brief Save the tilemap to a text file
- @param filename A string variable containing the name of the text file to save the map to
+ @brief Wait until every save has been written, then call their callbacks
  */
-bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
+void CMap2D::WaitForSaves(void)
 {
-	// Update the rapidcsv::Document from arrMapInfo
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	cMapSaver.Wait();
+}
+
+/**
+ @brief Load a map as a streamed level
+ @param filename A string variable containing the name of the CSV file of the map
+ @param uiLevel A const unsigned int variable containing the level
+ @param uiMemoryBudget A const size_t variable containing the number of bytes of chunks which may be kept in memory
+ */
+bool CMap2D::LoadStreamedMap(string filename, const unsigned int uiLevel, const size_t uiMemoryBudget)
+{
+	const string csvFilename = FileSystem::getPath(filename);
+	const string chunkFilename = CStreamedLevel::GetFilename(csvFilename);
+	arrStreamedLevels[uiLevel].reset();
+
+	// Writing the chunk file needs the whole level in memory, but only until the chunk file is up to date
+	if (!CStreamedLevel::IsUpToDate(chunkFilename, csvFilename))
 	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		size_t uiCsvSize = 0;
+		unsigned int uiNumRows = 0, uiNumCols = 0;
+		CMapLevel cLevel;
+		if ((!tilecsv::ReadFile(csvFilename, arrCsvText, uiCsvSize)) ||
+			(!tilecsv::GetSize(arrCsvText.data(), uiCsvSize, uiNumRows, uiNumCols)))
 		{
-			doc.SetCell(uiCol, uiRow, arrMapInfo[uiCurLevel][uiRow][uiCol].value);
+			cout << "Unable to read the CSV map " << csvFilename << endl;
+			return false;
+		}
+		cLevel.Init(uiNumRows, uiNumCols);
+		if ((!tilecsv::Parse(arrCsvText.data(), uiCsvSize, uiNumRows, uiNumCols, cLevel.GetTiles())) ||
+			(!CStreamedLevel::Save(chunkFilename, cLevel, 32, CStreamedLevel::MORTON, CLevelFile::GetSourceStamp(arrCsvText.data(), uiCsvSize))))
+		{
+			cout << "Unable to write the chunk file " << chunkFilename << endl;
+			return false;
 		}
-		cout << endl;
 	}
 
-	// Save the rapidcsv::Document to a file
-	doc.Save(FileSystem::getPath(filename).c_str());
-
+	std::unique_ptr<CStreamedLevel> pStreamedLevel(new CStreamedLevel());
+	if (!pStreamedLevel->Open(chunkFilename, uiMemoryBudget))
+	{
+		cout << "Unable to open the chunk file " << chunkFilename << endl;
+		return false;
+	}
+	arrStreamedLevels[uiLevel] = std::move(pStreamedLevel);
+	arrMapVersions[uiLevel]++;
 	return true;
 }
 
+/**
+ @brief Set the tile around which the chunks of the current level are kept in memory, if it is a streamed level
+ @param position A const glm::vec2& variable containing the column and inverted row of the tile
+ */
+void CMap2D::SetStreamingFocus(const glm::vec2& position)
+{
+	if (arrStreamedLevels[uiCurLevel])
+		arrStreamedLevels[uiCurLevel]->SetFocus((unsigned int)position.y, (unsigned int)position.x);
+}
+
 /**
 @brief Find the indices of a certain value in arrMapInfo
 @param iValue A const int variable containing the row index of the found element
@@ -701,33 +1035,100 @@ bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
 */
 bool CMap2D::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert)
 {
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	unsigned int uiIndex = 0;
+	if (!arrValueIndices[uiCurLevel].Find(iValue, uiIndex))
+		return false;
+
+	const unsigned int uiRow = uiIndex / arrMapInfo[uiCurLevel].GetNumCols();
+	if (bInvert)
+		uirRow = arrMapInfo[uiCurLevel].GetNumRows() - uiRow - 1;
+	else
+		uirRow = uiRow;
+	uirCol = uiIndex % arrMapInfo[uiCurLevel].GetNumCols();
+	return true;
+}
+
+/**
+ @brief Get the number of tiles holding a certain value in arrMapInfo
+ @param iValue A const int variable containing the value
+ */
+unsigned int CMap2D::GetValueCount(const int iValue) const
+{
+	return arrValueIndices[uiCurLevel].GetCount(iValue);
+}
+
+/**
+ @brief Call a function whenever a value appears on, or disappears from, a tile of the current level
+ @param iValue A const int variable containing the value
+ @param callback A ValueCallback variable containing the function
+ */
+unsigned int CMap2D::AddValueListener(const int iValue, ValueCallback callback)
+{
+	ValueListener sListener;
+	sListener.uiID = uiNextValueListenerID++;
+	sListener.iValue = iValue;
+	sListener.callback = callback;
+	arrValueListeners.push_back(sListener);
+	return sListener.uiID;
+}
+
+/**
+ @brief Stop calling a listener
+ @param uiListenerID A const unsigned int variable containing the ID returned by AddValueListener
+ */
+void CMap2D::RemoveValueListener(const unsigned int uiListenerID)
+{
+	for (unsigned int i = 0; i < arrValueListeners.size(); i++)
 	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		if (arrValueListeners[i].uiID == uiListenerID)
 		{
-			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == iValue)
-			{
-				if (bInvert)
-					uirRow = cSettings->NUM_TILES_YAXIS - uiRow - 1;
-				else
-					uirRow = uiRow;
-				uirCol = uiCol;
-				return true;	// Return true immediately if the value has been found
-			}
+			arrValueListeners.erase(arrValueListeners.begin() + i);
+			return;
 		}
 	}
-	return false;
 }
 
 /**
- @brief Set current level
+ @brief Get the journal of the edits made to a level
+ @param uiLevel A const unsigned int variable containing the level
+ */
+const CChangeJournal& CMap2D::GetChangeJournal(const unsigned int uiLevel) const
+{
+	return arrChangeJournals[uiLevel];
+}
+
+/**
+ @brief Set current level. A level which was preloaded is swapped in. The current level is kept if the preload failed,
+		as loading the level again here would fail the same way, or if the level has been unloaded
+ @param uiCurLevel A unsigned int variable containing the level
  */
-void CMap2D::SetCurrentLevel(unsigned int uiCurLevel)
+bool CMap2D::SetCurrentLevel(unsigned int uiCurLevel)
 {
-	if (uiCurLevel < uiNumLevels)
+	if (uiCurLevel >= uiNumLevels)
+		return false;
+
+	// Swap in the level preloaded for this level, waiting for the worker thread if it has not finished yet
+	if ((uiPreloadLevel == uiCurLevel) && !cLevelLoader.GetFilename().empty())
 	{
-		this->uiCurLevel = uiCurLevel;
+		const string csvFilename = cLevelLoader.GetFilename();
+		LoadedLevel sLevel;
+		if (!cLevelLoader.Take(sLevel))
+		{
+			cout << "Unable to load the map " << csvFilename << endl;
+			return false;
+		}
+		InstallLevel(sLevel, uiCurLevel);
 	}
+
+	// A level which has been unloaded has no tiles to play
+	if (!arrStreamedLevels[uiCurLevel] && (arrMapInfo[uiCurLevel].GetNumRows() == 0))
+		return false;
+
+	const unsigned int uiOldLevel = this->uiCurLevel;
+	this->uiCurLevel = uiCurLevel;
+	if (uiOldLevel != uiCurLevel)
+		NotifyValueListeners(arrMapInfo[uiOldLevel], arrValueIndices[uiOldLevel], arrMapInfo[uiCurLevel], arrValueIndices[uiCurLevel]);
+	return true;
 }
 /**
  @brief Get current level
@@ -737,6 +1138,184 @@ unsigned int CMap2D::GetCurrentLevel(void) const
 	return uiCurLevel;
 }
 
+/**
+ @brief Apply the path smoothing to a path found on the current level
+ @param startPos A const glm::vec2& variable containing the position the path starts from
+ @param path A std::vector<glm::vec2>& variable containing the path, which is shrunk in place
+ */
+void CMap2D::SmoothPath(const glm::vec2& startPos, std::vector<glm::vec2>& path)
+{
+	if (ePathSmoothing == pathsmoothing::NONE)
+		return;
+
+	CLineOfSight& cLineOfSight = arrLinesOfSight[uiCurLevel];
+	if ((ePathSmoothing == pathsmoothing::STRINGPULL) && !cLineOfSight.IsValid(arrMapInfo[uiCurLevel]))
+		cLineOfSight.Build(arrMapInfo[uiCurLevel]);
+	pathsmoothing::Smooth(ePathSmoothing, startPos, path, cLineOfSight);
+}
+
+/**
+ @brief Call the listeners of a value about one tile of a level
+ @param cLevel A const CMapLevel& variable containing the level which the tile index belongs to
+ @param iValue A const int variable containing the value
+ @param uiIndex A const unsigned int variable containing the index of the tile, with the rows in CSV order
+ @param bAdded A const bool variable which is true if the value appeared, or false if it disappeared
+ */
+void CMap2D::NotifyValueListeners(const CMapLevel& cLevel, const int iValue, const unsigned int uiIndex, const bool bAdded)
+{
+	const unsigned int uiRow = cLevel.GetNumRows() - uiIndex / cLevel.GetNumCols() - 1;
+	const unsigned int uiCol = uiIndex % cLevel.GetNumCols();
+
+	// Copy the callbacks first, since a listener may add or remove listeners
+	std::vector<ValueCallback> arrCallbacks;
+	for (unsigned int i = 0; i < arrValueListeners.size(); i++)
+	{
+		if (arrValueListeners[i].iValue == iValue)
+			arrCallbacks.push_back(arrValueListeners[i].callback);
+	}
+	for (unsigned int i = 0; i < arrCallbacks.size(); i++)
+		arrCallbacks[i](iValue, uiRow, uiCol, bAdded);
+}
+
+/**
+ @brief Call the listeners about the tiles of their values which differ between two levels. The tiles which left
+		are decoded with the size of the old level, and the tiles which appeared with the size of the new level.
+		The tile indices of levels of different sizes cannot be compared, so every old tile is removed and every
+		new tile is added then
+ @param cOldLevel A const CMapLevel& variable containing the level before the change
+ @param cOldIndex A const CTileValueIndex& variable containing the tiles of cOldLevel
+ @param cNewLevel A const CMapLevel& variable containing the level after the change
+ @param cNewIndex A const CTileValueIndex& variable containing the tiles of cNewLevel
+ */
+void CMap2D::NotifyValueListeners(const CMapLevel& cOldLevel, const CTileValueIndex& cOldIndex,
+								const CMapLevel& cNewLevel, const CTileValueIndex& cNewIndex)
+{
+	const bool bSameSize = (cOldLevel.GetNumRows() == cNewLevel.GetNumRows()) && (cOldLevel.GetNumCols() == cNewLevel.GetNumCols());
+
+	// Each value is compared once, however many listeners it has
+	std::vector<int> arrValues;
+	for (unsigned int i = 0; i < arrValueListeners.size(); i++)
+		arrValues.push_back(arrValueListeners[i].iValue);
+	std::sort(arrValues.begin(), arrValues.end());
+	arrValues.erase(std::unique(arrValues.begin(), arrValues.end()), arrValues.end());
+
+	for (unsigned int i = 0; i < arrValues.size(); i++)
+	{
+		std::vector<unsigned int> arrOldTiles = cOldIndex.GetTiles(arrValues[i]);
+		std::vector<unsigned int> arrNewTiles = cNewIndex.GetTiles(arrValues[i]);
+		if (!bSameSize)
+		{
+			for (unsigned int j = 0; j < arrOldTiles.size(); j++)
+				NotifyValueListeners(cOldLevel, arrValues[i], arrOldTiles[j], false);
+			for (unsigned int j = 0; j < arrNewTiles.size(); j++)
+				NotifyValueListeners(cNewLevel, arrValues[i], arrNewTiles[j], true);
+			continue;
+		}
+		std::sort(arrOldTiles.begin(), arrOldTiles.end());
+		std::sort(arrNewTiles.begin(), arrNewTiles.end());
+
+		std::vector<unsigned int> arrChangedTiles;
+		std::set_difference(arrOldTiles.begin(), arrOldTiles.end(), arrNewTiles.begin(), arrNewTiles.end(),
+							std::back_inserter(arrChangedTiles));
+		for (unsigned int j = 0; j < arrChangedTiles.size(); j++)
+			NotifyValueListeners(cOldLevel, arrValues[i], arrChangedTiles[j], false);
+
+		arrChangedTiles.clear();
+		std::set_difference(arrNewTiles.begin(), arrNewTiles.end(), arrOldTiles.begin(), arrOldTiles.end(),
+							std::back_inserter(arrChangedTiles));
+		for (unsigned int j = 0; j < arrChangedTiles.size(); j++)
+			NotifyValueListeners(cNewLevel, arrValues[i], arrChangedTiles[j], true);
+	}
+}
+
+/**
+ @brief Get a copy of a level for a save, which is up to date with its edits. Only the tiles edited since the last
+		save are copied, unless the I/O thread is still writing the last copy or the journal no longer has those edits
+ @param uiLevel A const unsigned int variable containing the level
+ */
+std::shared_ptr<const CMapLevel> CMap2D::GetSaveSnapshot(const unsigned int uiLevel)
+{
+	std::shared_ptr<CMapLevel>& pSnapshot = arrSaveSnapshots[uiLevel];
+	const CChangeJournal& cChangeJournal = arrChangeJournals[uiLevel];
+	// The I/O thread releases its copies on the main thread, so a copy only owned here is not being written
+	if (pSnapshot && (pSnapshot.use_count() == 1) &&
+		cChangeJournal.GetChangesSince(arrSaveSnapshotVersions[uiLevel], arrSaveChanges))
+	{
+		for (unsigned int i = 0; i < arrSaveChanges.size(); i++)
+			pSnapshot->SetTile(arrSaveChanges[i].uiRow, arrSaveChanges[i].uiCol, arrSaveChanges[i].iNewValue);
+	}
+	else
+		pSnapshot = std::make_shared<CMapLevel>(arrMapInfo[uiLevel]);
+	arrSaveSnapshotVersions[uiLevel] = cChangeJournal.GetVersion();
+	return pSnapshot;
+}
+
+/**
+ @brief Mark the flow fields of a level as out of date
+ @param uiLevel A const unsigned int variable containing the level
+ */
+void CMap2D::InvalidateFlowFields(const unsigned int uiLevel)
+{
+	for (unsigned int i = 0; i < arrFlowFields.size(); i++)
+	{
+		if (arrFlowFields[i].GetLevel() == &arrMapInfo[uiLevel])
+			arrFlowFields[i].Invalidate();
+	}
+}
+
+/**
+ @brief Share the per-frame node budget between the time sliced searches. Each running search gets an equal share,
+		and the share of a search which finishes early is given to the others. The first share goes to a different
+		search every frame, so the searches left over when the budget runs out take turns.
+ */
+void CMap2D::RunTimeSlicedSearches(void)
+{
+	const unsigned int uiNumSearches = (unsigned int)arrTimeSlicedSearches.size();
+	if (uiNumSearches == 0)
+		return;
+
+	unsigned int uiBudget = uiPathFindBudget;
+	while (uiBudget > 0)
+	{
+		unsigned int uiNumRunning = 0;
+		for (unsigned int i = 0; i < uiNumSearches; i++)
+		{
+			if (arrTimeSlicedSearches[i]->GetStatus() == CTimeSlicedSearch::RUNNING)
+				uiNumRunning++;
+		}
+		if (uiNumRunning == 0)
+			break;
+
+		const unsigned int uiShare = std::max(uiBudget / uiNumRunning, 1u);
+		for (unsigned int i = 0; (i < uiNumSearches) && (uiBudget > 0); i++)
+		{
+			CTimeSlicedSearch* pSearch = arrTimeSlicedSearches[(uiTimeSlicedRotation + i) % uiNumSearches];
+			uiBudget -= pSearch->Run(std::min(uiShare, uiBudget));
+		}
+	}
+	uiTimeSlicedRotation++;
+
+	// Count this frame for every search, and take out the ones which have finished
+	for (unsigned int i = 0; i < arrTimeSlicedSearches.size();)
+	{
+		CTimeSlicedSearch* pSearch = arrTimeSlicedSearches[i];
+		pSearch->NextFrame();
+		if (pSearch->GetStatus() == CTimeSlicedSearch::RUNNING)
+		{
+			i++;
+			continue;
+		}
+
+		uiNumTimeSlicedFinished++;
+		uiTimeSlicedFrames += pSearch->GetNumFrames();
+		uiMaxTimeSlicedFrames = std::max(uiMaxTimeSlicedFrames, pSearch->GetNumFrames());
+		cPathCache.Store(arrTimeSlicedKeys[i],
+						pSearch->GetStatus() == CTimeSlicedSearch::FOUND ? pSearch->GetPath() : std::vector<glm::vec2>());
+		arrTimeSlicedSearches.erase(arrTimeSlicedSearches.begin() + i);
+		arrTimeSlicedKeys.erase(arrTimeSlicedKeys.begin() + i);
+	}
+}
+
 /**
  @brief Render a tile at a position based on its tile index
  @param iRow A const int variable containing the row index of the tile
@@ -744,10 +1323,11 @@ unsigned int CMap2D::GetCurrentLevel(void) const
  */
 void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
 {
-	if (arrMapInfo[uiCurLevel][uiRow][uiCol].value != 0)
+	// The values without a texture, and the values which are not in the tile registry, are not drawn
+	const unsigned int uiTextureID = arrTextureIDs[tiletype::GetType(GetMapInfo(uiRow, uiCol, false))];
+	if (uiTextureID != 0)
 	{
-		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+		glBindTexture(GL_TEXTURE_2D, uiTextureID);
 
 		glBindVertexArray(VAO);
 		//CS: Render the tile
@@ -20,8 +20,8 @@
 #include <includes/gtc/matrix_transform.hpp>
 #include <includes/gtc/type_ptr.hpp>
 
-// Include the RapidCSV
-#include "System/rapidcsv.h"
+// Include TileCsv for reading and writing the CSV files of the levels
+#include "TileCsv.h"
 // Include map storage
 #include <map>
 
@@ -31,42 +31,50 @@
 // Include Entity2D
 #include "Primitives/Entity2D.h"
 
+// Include MapLevel
+#include "MapLevel.h"
+
+// Include PathFinder for AStar
+#include "PathFinder.h"
+// Include ClusterGraph for Hierarchical Path Finding
+#include "ClusterGraph.h"
+// Include FlowField for the shared distance fields towards a target
+#include "FlowField.h"
+// Include IncrementalPlanner for the searches which agents keep between frames
+#include "IncrementalPlanner.h"
+// Include PathRequestQueue for the searches run on worker threads
+#include "PathRequestQueue.h"
+// Include TimeSlicedSearch for the searches spread over several frames
+#include "TimeSlicedSearch.h"
+// Include PathCache for reusing the paths found before
+#include "PathCache.h"
+// Include ReachabilityIndex for rejecting searches for targets which cannot be reached
+#include "ReachabilityIndex.h"
+// Include PathWorkspace for the batches of path queries
+#include "PathWorkspace.h"
+// Include LineOfSight for what the enemies can see
+#include "LineOfSight.h"
+// Include PotentiallyVisibleSet for the visibility precomputed when a map is loaded
+#include "PotentiallyVisibleSet.h"
+// Include PathSmoothing for shrinking the paths into turn points
+#include "PathSmoothing.h"
+// Include TileValueIndex for finding the tiles which hold a value without scanning the level
+#include "TileValueIndex.h"
+// Include ChangeJournal for telling what changed in a level since a version
+#include "ChangeJournal.h"
+// Include LevelFile for loading the compiled levels
+#include "LevelFile.h"
+// Include StreamedLevel for the levels which are read chunk by chunk around the player
+#include "StreamedLevel.h"
+// Include LevelLoader for loading the levels, and preloading the next level while one is played
+#include "LevelLoader.h"
+// Include MapSaver for saving the levels on an I/O thread
+#include "MapSaver.h"
 
-// Include files for AStar
-#include <queue>
 #include <functional>
 
-// A structure storing information about Map Sizes
-struct MapSize {
-	unsigned int uiRowSize;
-	unsigned int uiColSize;
-};
-
-// A structure storing information about a map grid
-// It includes data to be used for A* Path Finding
-struct Grid {
-	unsigned int value;
-
-	Grid() : value(0), pos(0, 0), parent(-1, -1), f(0), g(0), h(0) {}
-	Grid(const glm::vec2& pos, unsigned int f) : value(0), pos(pos), parent(-1, 1), f(f), g(0), h(0) {}
-	Grid(const glm::vec2& pos, const glm::vec2& parent, unsigned int f, unsigned int g, unsigned int h) : value(0), pos(pos), parent(parent), f(f), g(g), h(h) {}
-
-	glm::vec2 pos;
-	glm::vec2 parent;
-	unsigned int f;
-	unsigned int g;
-	unsigned int h;
-};
-
-using HeuristicFunction = std::function<unsigned int(const glm::vec2&, const glm::vec2&, int)>;
-// Reverse std::priority_queue to get the smallest element on top
-inline bool operator< (const Grid& a, const Grid& b) { return b.f < a.f; }
-
-namespace heuristic
-{
-	unsigned int manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight);
-	unsigned int euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight);
-}
+// The function called when a value appears on, or disappears from, a tile of the current level. The row is inverted
+using ValueCallback = std::function<void(const int iValue, const unsigned int uiRow, const unsigned int uiCol, const bool bAdded)>;
 
 
 class CMap2D : public CSingletonTemplate<CMap2D>, public CEntity2D
@@ -99,18 +107,55 @@ public:
 
 	// Get the value at certain indices in the arrMapInfo
 	int GetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+	// Get the item or trigger at certain indices from the item layer of the current level, or 0 if there is none
+	int GetMapItem(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+
+	// Check if a grid is blocked, by reading one bit of the collision layer of the current level
+	bool isBlocked( const unsigned int uiRow,
+					const unsigned int uiCol,
+					const bool bInvert = true) const;
 
-	// Load a map
+	// Load a map. The level file compiled from the CSV file is used instead, if it is up to date.
+	// A level which is preloaded from the same file is swapped in instead, once the worker thread has finished it
 	bool LoadMap(string filename, const unsigned int uiLevel = 0);
+	// Start loading a map into a level on a worker thread, while another level is played.
+	// SetCurrentLevel swaps it in, so switching to the level does not read or build anything
+	bool PreloadMap(string filename, const unsigned int uiLevel);
+	// Check if the worker thread has finished preloading a level
+	bool IsMapPreloaded(const unsigned int uiLevel) const;
+	// Free the tiles, and everything built from them, of a level which will not be played again. It cannot be the current level
+	bool UnloadMap(const unsigned int uiLevel);
+
+	// Save a tilemap. A snapshot of the level is written by the I/O thread, and the callback is told if it was written
+	// at a later call to Update(). A streamed level is saved by writing its edited chunks back into its chunk file at once.
+	// Returns false if the save could not be queued
+	bool SaveMap(string filename, const unsigned int uiLevel = 0, SaveCallback callback = SaveCallback());
+	// Wait until every save has been written, then call their callbacks
+	void WaitForSaves(void);
+
+	// Load a map as a streamed level, which keeps at most uiMemoryBudget bytes of its chunks in memory, around the focus.
+	// Its chunk file is written from the CSV file first if it is older. GetMapInfo, SetMapInfo and isBlocked read and
+	// write the chunks, while the path finding, line of sight and value index only cover the levels loaded by LoadMap
+	bool LoadStreamedMap(string filename, const unsigned int uiLevel, const size_t uiMemoryBudget);
+	// Set the tile around which the chunks of the current level are kept in memory, if it is a streamed level
+	void SetStreamingFocus(const glm::vec2& position);
+
+	// Find the indices of a certain value in arrMapInfo, in O(1)
+	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true);
+	// Get the number of tiles holding a certain value in arrMapInfo, in O(1)
+	unsigned int GetValueCount(const int iValue) const;
 
-	// Save a tilemap
-	bool SaveMap(string filename, const unsigned int uiLevel = 0);
+	// Call a function whenever a value appears on, or disappears from, a tile of the current level,
+	// including when a map is loaded or the current level changes. Returns the ID of the listener
+	unsigned int AddValueListener(const int iValue, ValueCallback callback);
+	// Stop calling a listener
+	void RemoveValueListener(const unsigned int uiListenerID);
 
-	// Find the indices of a certain value in arrMapInfo
-	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true);
+	// Get the journal of the edits made to a level, to ask which tiles or chunks changed since a version
+	const CChangeJournal& GetChangeJournal(const unsigned int uiLevel) const;
 
-	// Set current level
-	void SetCurrentLevel(unsigned int uiCurLevel);
+	// Set current level. Returns false, and keeps the current level, if the level cannot be loaded
+	bool SetCurrentLevel(unsigned int uiCurLevel);
 	// Get current level
 	unsigned int GetCurrentLevel(void) const;
 
@@ -120,68 +165,180 @@ public:
 										const glm::vec2& targetPos, 
 										HeuristicFunction heuristicFunc, 
 										int weight = 1);
+	// For Hierarchical PathFinding (HPA*) on large maps. Returns the same path shape as PathFind
+	std::vector<glm::vec2> HierarchicalPathFind(const glm::vec2& startPos,
+												const glm::vec2& targetPos,
+												HeuristicFunction heuristicFunc,
+												int weight = 1);
+	// Find the paths of a batch of queries on the current level with the caller's search lists, and store them in cArena.
+	// Queries which share a target are answered by one search
+	void PathFindBatch(const PathQuery* pQueries,
+						const unsigned int uiNumQueries,
+						CPathWorkspace& cWorkspace,
+						CPathArena& cArena);
+	// Check if a path exists from startPos to targetPos on the current level, in O(1)
+	bool IsReachable(const glm::vec2& startPos, const glm::vec2& targetPos);
+	// Check if no blocking tile lies between two tiles of the current level. While no blocking tile has changed since LoadMap,
+	// this is a bit test in the precomputed visible sets. Otherwise the results are cached until a blocking tile changes
+	bool HasLineOfSight(const glm::vec2& observerPos, const glm::vec2& targetPos);
+	// Check many (observer, target) pairs on the current level at once, and store the result of each query in pbResults
+	void HasLineOfSight(const LineOfSightQuery* pQueries, const unsigned int uiNumQueries, bool* pbResults);
+	// Get the flow field towards a target tile on the current level. It is only computed again
+	// when a new target is asked for or a blocking tile changes, so all agents chasing the same target share it
+	const CFlowField& GetFlowField(const glm::vec2& targetPos);
+	// Update an agent's incremental planner from startPos towards targetPos on the current level.
+	// Returns true if the target can be reached
+	bool Replan(CIncrementalPlanner& cPlanner, const glm::vec2& startPos, const glm::vec2& targetPos);
+	// Add or remove an incremental planner which is told about every blocking tile that changes
+	void AddIncrementalPlanner(CIncrementalPlanner* pPlanner);
+	void RemoveIncrementalPlanner(CIncrementalPlanner* pPlanner);
+
+	// Queue a path search on the worker threads, over a snapshot of the current level.
+	// The callback receives the path at the next call to SyncPathRequests(). Returns the ID of the request
+	unsigned int RequestPath(const glm::vec2& startPos,
+							const glm::vec2& targetPos,
+							HeuristicFunction heuristicFunc,
+							int weight,
+							PathCallback callback);
+	// Cancel a path request, so that its callback is not called
+	void CancelPathRequest(const unsigned int uiRequestID);
+	// The sync point, called once at the start of each frame: hand the paths requested last frame to their callbacks
+	void SyncPathRequests(void);
+	// Get the version of the current level, which goes up whenever a blocking tile changes
+	unsigned int GetMapVersion(void) const;
+
+	// Start a search on the current level which is run a share of the per-frame node budget at a time, in Update()
+	void StartTimeSlicedSearch(CTimeSlicedSearch* pSearch,
+								const glm::vec2& startPos,
+								const glm::vec2& targetPos,
+								HeuristicFunction heuristicFunc,
+								int weight = 1);
+	// Stop a time sliced search before it has finished
+	void StopTimeSlicedSearch(CTimeSlicedSearch* pSearch);
+	// Set the number of nodes which all the time sliced searches may expand in one frame
+	void SetPathFindBudget(const unsigned int uiNodesPerFrame);
+	// Get the number of nodes which all the time sliced searches may expand in one frame
+	unsigned int GetPathFindBudget(void) const;
+
+	// Get the cache of the paths found by PathFind, RequestPath and the time sliced searches, e.g. for its hit counters
+	const CPathCache& GetPathCache(void) const;
+
 	// Set if AStar PathFinding will consider diagonal movements
 	void SetDiagonalMovement(const bool bEnable);
+	// Set the search algorithm used by PathFind: A*, Jump Point Search or JPS+
+	void SetSearchMode(const CPathFinder::SEARCHMODE eSearchMode);
+	// Set the smoothing applied to the paths of PathFind, HierarchicalPathFind and RequestPath
+	void SetPathSmoothing(const pathsmoothing::SMOOTHINGMODE ePathSmoothing);
+	// Get the smoothing applied to the paths of PathFind, HierarchicalPathFind and RequestPath
+	pathsmoothing::SMOOTHINGMODE GetPathSmoothing(void) const;
 
 	// Print out details about this class instance in the console window
 	void PrintSelf(void) const;
 
 protected:
-	// The variable containing the rapidcsv::Document
-	// We will load the CSV file's content into this Document
-	rapidcsv::Document doc;
-
-	// A 3-D array which stores the values of the tile map
-	Grid*** arrMapInfo;
+	// The column labels in the first line of the CSV file of each level, written back by SaveMap
+	std::vector<std::string> arrColumnLabels;
+	// The text of the last CSV file read or written, kept so that its memory is reused by the next one
+	std::vector<char> arrCsvText;
+	// The worker thread which preloads a level, and the level it is for
+	CLevelLoader cLevelLoader;
+	unsigned int uiPreloadLevel;
+
+	// A 1-D array of levels, each storing its tile values in a flat array
+	std::vector<CMapLevel> arrMapInfo;
+	// The levels loaded by LoadStreamedMap, which are used instead of arrMapInfo, or NULL for the other levels
+	std::vector<std::unique_ptr<CStreamedLevel>> arrStreamedLevels;
 
 	// The current level
 	unsigned int uiCurLevel;
 	// The number of levels
 	unsigned int uiNumLevels;
 
-	// A 1-D array which stores the map sizes for each level
-	MapSize* arrMapSizes;
-
-	// Map containing texture IDs
-	map<int, int> MapOfTextureIDs;
+	// The texture ID of each tile type, by its row in tiletype::arrTileTypes, or 0 if it is not drawn
+	unsigned int arrTextureIDs[tiletype::NUM_TILETYPES];
 
 	//CS: The quadMesh for drawing the tiles
 	CMesh* quadMesh;
 
-	// For A-Star PathFinding
-	// Build a path from m_cameFromList after calling PathFind()
-	std::vector<glm::vec2> BuildPath() const;
-	// Check if a grid is valid
-	bool isValid(const glm::vec2& pos) const;
-	// Check if a grid is blocked
-	bool isBlocked( const unsigned int uiRow,
-					const unsigned int uiCol,
-					const bool bInvert = true) const;
-	// Convert a position to a 1D position in the array
-	int ConvertTo1D(const glm::vec2& pos) const;
-
-	// Delete AStar lists
-	bool DeleteAStarLists(void);
-	// Reset AStar lists
-	bool ResetAStarLists(void);
-
-
-	// Variables for A-Star PathFinding
-	int m_weight;
-	//int m_size;
-	unsigned int m_nrOfDirections;
-	//glm::vec2 m_dimensions;
-	glm::vec2 m_startPos;
-	glm::vec2 m_targetPos;
-
-	// the handle for heuristic functions
-	HeuristicFunction m_heuristic;
-
-	//Lists for A-Star PathFinding
-	std::priority_queue<Grid> m_openList;
-	std::vector<bool> m_closedList;
-	std::vector<Grid> m_cameFromList;
-	std::vector<glm::vec2> m_directions;
+	// The A-Star PathFinding search lists, shared by all levels
+	CPathFinder cPathFinder;
+	// The JPS+ jump distances of each level, rebuilt when a blocking tile changes
+	std::vector<CJumpTable> arrJumpTables;
+	// The HPA* clusters of each level, rebuilt when a blocking tile changes
+	std::vector<CClusterGraph> arrClusterGraphs;
+	// The connected regions of each level, updated when a blocking tile changes
+	std::vector<CReachabilityIndex> arrReachabilityIndices;
+	// The blocking tiles of each level for the line of sight checks, updated when a blocking tile changes
+	std::vector<CLineOfSight> arrLinesOfSight;
+	// The visible sets of each level, loaded or built by LoadMap, and out of date once a blocking tile changes
+	std::vector<CPotentiallyVisibleSet> arrPotentiallyVisibleSets;
+	// The flow fields towards the most recently used targets, and when each was last used
+	std::vector<CFlowField> arrFlowFields;
+	std::vector<unsigned int> arrFlowFieldUses;
+	unsigned int uiFlowFieldClock;
+	// The incremental planners owned by the agents, which are not deleted here
+	std::vector<CIncrementalPlanner*> arrIncrementalPlanners;
+	// The worker threads for the path requests
+	CPathRequestQueue cPathRequestQueue;
+	// The version of each level, and the read-only copy of it which the path requests search
+	std::vector<unsigned int> arrMapVersions;
+	std::vector<std::shared_ptr<const CMapLevel>> arrSnapshots;
+	std::vector<unsigned int> arrSnapshotVersions;
+	// The I/O thread for the saves
+	CMapSaver cMapSaver;
+	// The copy of each level which the saves write, and the version of the change journal it is up to date with.
+	// It is brought up to date with the edits in the journal, unless the I/O thread is still writing it
+	std::vector<std::shared_ptr<CMapLevel>> arrSaveSnapshots;
+	std::vector<unsigned int> arrSaveSnapshotVersions;
+	std::vector<TileChange> arrSaveChanges;
+	// The time sliced searches which are still running, which are not deleted here, and the path cache key of each
+	std::vector<CTimeSlicedSearch*> arrTimeSlicedSearches;
+	std::vector<CPathCache::Key> arrTimeSlicedKeys;
+	// The number of nodes they may expand in one frame, and the search which gets the first share in the next frame
+	unsigned int uiPathFindBudget;
+	unsigned int uiTimeSlicedRotation;
+	// The number of time sliced searches which have finished, and the total and largest number of frames they took
+	unsigned int uiNumTimeSlicedFinished;
+	unsigned int uiTimeSlicedFrames;
+	unsigned int uiMaxTimeSlicedFrames;
+	// The tiles holding each value, for each level
+	std::vector<CTileValueIndex> arrValueIndices;
+	// A function which is called when its value appears or disappears
+	struct ValueListener
+	{
+		unsigned int uiID;
+		int iValue;
+		ValueCallback callback;
+	};
+	std::vector<ValueListener> arrValueListeners;
+	unsigned int uiNextValueListenerID;
+	// The edits made to each level
+	std::vector<CChangeJournal> arrChangeJournals;
+	// The most recently found paths, stored tile by tile
+	CPathCache cPathCache;
+	// The smoothing applied to the paths handed out
+	pathsmoothing::SMOOTHINGMODE ePathSmoothing;
+
+	// Apply the path smoothing to a path found on the current level
+	void SmoothPath(const glm::vec2& startPos, std::vector<glm::vec2>& path);
+	// Call the listeners of a value about one tile of a level
+	void NotifyValueListeners(const CMapLevel& cLevel, const int iValue, const unsigned int uiIndex, const bool bAdded);
+	// Call the listeners about the tiles of their values which differ between two levels, each with its own index
+	void NotifyValueListeners(const CMapLevel& cOldLevel, const CTileValueIndex& cOldIndex,
+							const CMapLevel& cNewLevel, const CTileValueIndex& cNewIndex);
+	// Swap a loaded level into place, leaving the old level in sLevel, and mark everything else built from the old level as out of date
+	void InstallLevel(LoadedLevel& sLevel, const unsigned int uiLevel);
+	// Mark the flow fields of a level as out of date
+	void InvalidateFlowFields(const unsigned int uiLevel);
+	// Get a copy of a level for a save, which is up to date with its edits
+	std::shared_ptr<const CMapLevel> GetSaveSnapshot(const unsigned int uiLevel);
+	// Share the per-frame node budget between the time sliced searches
+	void RunTimeSlicedSearches(void);
+	// Get the path cache key of a search on the current level
+	CPathCache::Key GetPathCacheKey(const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									const HeuristicFunction& heuristicFunc,
+									const int weight) const;
 
 
 	// Constructor
@@ -0,0 +1,163 @@
+/**
+ CMapLevel
+ @brief A class which stores one level of the map in layers. The art layer holds the value of every tile in a
+		flat array, for rendering and saving. The collision layer packs whether each tile is blocked into bits,
+		64 tiles per word, and the item layer holds only the tiles with items and triggers, in a hash map
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ @brief Constructor
+ */
+CMapLevel::CMapLevel(void)
+	: uiNumCollisionWords(0)
+	, uiCollisionVersion(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CMapLevel::~CMapLevel(void)
+{
+}
+
+/**
+ @brief Init Allocate the tile array for this level and initialise every tile to 0
+ @param uiNumRows A const unsigned int variable containing the number of rows in this level
+ @param uiNumCols A const unsigned int variable containing the number of columns in this level
+ */
+void CMapLevel::Init(const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	sMapSize.uiRowSize = uiNumRows;
+	sMapSize.uiColSize = uiNumCols;
+	arrTiles.assign(uiNumRows * uiNumCols, 0);
+	uiNumCollisionWords = (uiNumCols + 63) / 64;
+	arrCollisionBits.assign((size_t)uiNumRows * uiNumCollisionWords, 0);
+	mapItems.clear();
+	uiCollisionVersion++;
+}
+
+/**
+ @brief Swap the size and tiles with another level
+ @param cLevel A CMapLevel& variable containing the other level
+ */
+void CMapLevel::Swap(CMapLevel& cLevel)
+{
+	std::swap(sMapSize, cLevel.sMapSize);
+	arrTiles.swap(cLevel.arrTiles);
+	arrCollisionBits.swap(cLevel.arrCollisionBits);
+	std::swap(uiNumCollisionWords, cLevel.uiNumCollisionWords);
+	mapItems.swap(cLevel.mapItems);
+
+	// Both levels now hold other walls, so move both past every version either of them had
+	const unsigned int uiVersion = std::max(uiCollisionVersion, cLevel.uiCollisionVersion) + 1;
+	uiCollisionVersion = uiVersion;
+	cLevel.uiCollisionVersion = uiVersion;
+}
+
+/**
+ @brief Set the value of a tile, in every layer
+ @param uiRow A const unsigned int variable containing the row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param iValue A const int variable containing the value
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+void CMapLevel::SetTile(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
+{
+	const unsigned int uiTileRow = bInvert ? sMapSize.uiRowSize - uiRow - 1 : uiRow;
+	arrTiles[uiTileRow * sMapSize.uiColSize + uiCol] = iValue;
+	SetLayers(uiTileRow, uiCol, iValue);
+}
+
+/**
+ @brief Get the item or trigger on a tile from the item layer
+ @param uiRow A const unsigned int variable containing the row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+int CMapLevel::GetItem(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
+{
+	std::unordered_map<unsigned int, int>::const_iterator it = mapItems.find(ConvertTo1D(uiRow, uiCol, bInvert));
+	return (it != mapItems.end()) ? it->second : 0;
+}
+
+/**
+ @brief Split the values in the art layer into the collision and item layers
+ */
+void CMapLevel::UpdateLayers(void)
+{
+	arrCollisionBits.assign((size_t)sMapSize.uiRowSize * uiNumCollisionWords, 0);
+	mapItems.clear();
+	for (unsigned int uiRow = 0; uiRow < sMapSize.uiRowSize; uiRow++)
+	{
+		const int* pRow = &arrTiles[uiRow * sMapSize.uiColSize];
+		uint64_t* pBits = &arrCollisionBits[uiRow * uiNumCollisionWords];
+		for (unsigned int uiCol = 0; uiCol < sMapSize.uiColSize; uiCol++)
+		{
+			if (tiletype::IsBlocking(pRow[uiCol]))
+				pBits[uiCol >> 6] |= (uint64_t)1 << (uiCol & 63);
+			else if (tiletype::IsItem(pRow[uiCol]))
+				mapItems[uiRow * sMapSize.uiColSize + uiCol] = pRow[uiCol];
+		}
+	}
+	uiCollisionVersion++;
+}
+
+/**
+ @brief Find the indices of a certain value in this level
+ @param iValue A const int variable containing the value to search for
+ @param uirRow An unsigned int variable which will store the row index of the found element
+ @param uirCol An unsigned int variable which will store the column index of the found element
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+bool CMapLevel::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert) const
+{
+	const unsigned int uiSize = (unsigned int)arrTiles.size();
+	for (unsigned int uiIndex = 0; uiIndex < uiSize; uiIndex++)
+	{
+		if (arrTiles[uiIndex] == iValue)
+		{
+			const unsigned int uiRow = uiIndex / sMapSize.uiColSize;
+			if (bInvert)
+				uirRow = sMapSize.uiRowSize - uiRow - 1;
+			else
+				uirRow = uiRow;
+			uirCol = uiIndex % sMapSize.uiColSize;
+			return true;	// Return true immediately if the value has been found
+		}
+	}
+	return false;
+}
+
+/**
+ @brief Set the collision and item layers of a tile to a value
+ @param uiRow A const unsigned int variable containing the row of the tile, in CSV order
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param iValue A const int variable containing the value
+ */
+void CMapLevel::SetLayers(const unsigned int uiRow, const unsigned int uiCol, const int iValue)
+{
+	const unsigned int uiIndex = uiRow * sMapSize.uiColSize + uiCol;
+	uint64_t& uiWord = arrCollisionBits[uiRow * uiNumCollisionWords + (uiCol >> 6)];
+	const uint64_t uiBit = (uint64_t)1 << (uiCol & 63);
+	const uint64_t uiOldWord = uiWord;
+	if (tiletype::IsBlocking(iValue))
+		uiWord |= uiBit;
+	else
+		uiWord &= ~uiBit;
+	if (uiWord != uiOldWord)
+		uiCollisionVersion++;
+
+	if (tiletype::IsItem(iValue))
+		mapItems[uiIndex] = iValue;
+	else
+		mapItems.erase(uiIndex);
+}
@@ -0,0 +1,112 @@
+/**
+ CMapLevel
+ @brief A class which stores one level of the map in layers. The art layer holds the value of every tile in a
+		flat array, for rendering and saving. The collision layer packs whether each tile is blocked into bits,
+		64 tiles per word, and the item layer holds only the tiles with items and triggers, in a hash map
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include TileRegistry for the values which go into the collision and item layers
+#include "TileRegistry.h"
+
+// Include vector for the flat tile storage
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// A structure storing information about Map Sizes
+struct MapSize {
+	unsigned int uiRowSize;
+	unsigned int uiColSize;
+};
+
+class CMapLevel
+{
+public:
+	// Constructor
+	CMapLevel(void);
+
+	// Destructor
+	~CMapLevel(void);
+
+	// Init
+	void Init(const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Swap the size and tiles with another level, e.g. to put a level loaded elsewhere in place without copying it
+	void Swap(CMapLevel& cLevel);
+
+	// Get the number of rows in this level
+	unsigned int GetNumRows(void) const { return sMapSize.uiRowSize; }
+	// Get the number of columns in this level
+	unsigned int GetNumCols(void) const { return sMapSize.uiColSize; }
+
+	// Convert a row and column into an index into arrTiles. Rows are stored in CSV order,
+	// so an inverted row (row 0 at the bottom of the screen) is flipped here and nowhere else.
+	unsigned int ConvertTo1D(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const
+	{
+		if (bInvert)
+			return (sMapSize.uiRowSize - uiRow - 1) * sMapSize.uiColSize + uiCol;
+		return uiRow * sMapSize.uiColSize + uiCol;
+	}
+
+	// Get the value of a tile
+	int GetTile(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const
+	{
+		return arrTiles[ConvertTo1D(uiRow, uiCol, bInvert)];
+	}
+
+	// Set the value of a tile, in every layer
+	void SetTile(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert = true);
+
+	// Check if a tile is blocked, by reading its bit in the collision layer
+	bool IsBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const
+	{
+		const unsigned int uiTileRow = bInvert ? sMapSize.uiRowSize - uiRow - 1 : uiRow;
+		return ((arrCollisionBits[uiTileRow * uiNumCollisionWords + (uiCol >> 6)] >> (uiCol & 63)) & 1) != 0;
+	}
+
+	// Get the item or trigger on a tile from the item layer, or 0 if there is none
+	int GetItem(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+	// Get the item layer, which maps the index of each tile with an item or trigger to its value
+	const std::unordered_map<unsigned int, int>& GetItems(void) const { return mapItems; }
+
+	// Get the collision layer, with bit (column % 64) of word (row * GetNumCollisionWords() + column / 64) set
+	// for each blocked tile. The rows are in CSV order, and each row starts at a new word
+	const uint64_t* GetCollisionBits(void) const { return arrCollisionBits.data(); }
+	// Get the number of words in each row of the collision layer
+	unsigned int GetNumCollisionWords(void) const { return uiNumCollisionWords; }
+	// Get the version of the collision layer, which changes whenever a tile becomes blocked or free
+	unsigned int GetCollisionVersion(void) const { return uiCollisionVersion; }
+
+	// Split the values in the art layer into the collision and item layers.
+	// It has to be called after writing the values through GetTiles(), e.g. when a map was read
+	void UpdateLayers(void);
+
+	// Find the indices of a certain value in this level
+	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true) const;
+
+	// Get the art layer, which is the flat array of tile values, stored row by row in CSV order.
+	// UpdateLayers() has to be called after writing through it
+	const int* GetTiles(void) const { return arrTiles.data(); }
+	int* GetTiles(void) { return arrTiles.data(); }
+
+protected:
+	// The size of this level
+	MapSize sMapSize;
+
+	// The art layer: the tile values of this level, stored row by row in CSV order
+	std::vector<int> arrTiles;
+	// The collision layer: one bit for each tile, set if it is blocked, with each row starting at a new word
+	std::vector<uint64_t> arrCollisionBits;
+	unsigned int uiNumCollisionWords;
+	// Counts the changes to the collision layer, so that what was built from it can tell that it is out of date
+	unsigned int uiCollisionVersion;
+	// The item layer: the value of each tile with an item or trigger, by its index into arrTiles
+	std::unordered_map<unsigned int, int> mapItems;
+
+	// Set the collision and item layers of a tile, whose row is in CSV order, to a value
+	void SetLayers(const unsigned int uiRow, const unsigned int uiCol, const int iValue);
+};
@@ -0,0 +1,295 @@
+/**
+ CMapSaver
+ @brief A class which writes snapshots of levels into CSV and level files on an I/O thread, so that saving a level
+		does not stall the frame. Each file is written into a temporary file, flushed to the disk and then
+		renamed over the old file, so a file is never left half written. The results are handed to the callbacks
+		of the saves on the main thread.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapSaver.h"
+
+// Include TileCsv and LevelFile for writing the files
+#include "TileCsv.h"
+#include "LevelFile.h"
+
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CMapSaver::CMapSaver(void)
+	: m_bWriting(false)
+	, m_bStop(false)
+	, uiNextSaveID(1)
+	, uiNumPending(0)
+	, uiNumSaves(0)
+	, uiNumFailures(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CMapSaver::~CMapSaver(void)
+{
+	Destroy();
+}
+
+/**
+ @brief Start the I/O thread
+ */
+void CMapSaver::Init(void)
+{
+	Destroy();
+
+	m_bStop = false;
+	cWorker = std::thread(&CMapSaver::WorkerLoop, this);
+}
+
+/**
+ @brief Finish writing the queued saves, then stop the I/O thread and drop the callbacks which have not been called.
+		Unlike the path requests, the queued saves are not dropped, as the game may be closing right after a save
+ */
+void CMapSaver::Destroy(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+	}
+	m_cvWork.notify_all();
+	if (cWorker.joinable())
+		cWorker.join();
+
+	m_finishedSaves.clear();
+	uiNumPending = 0;
+}
+
+/**
+ @brief Queue a save of a snapshot of a level
+ @param pSnapshot A const std::shared_ptr<const CMapLevel>& variable containing the level snapshot. It must not be changed afterwards
+ @param columnLabels A const std::string& variable containing the line of column labels of the CSV file
+ @param csvFilename A const std::string& variable containing the full path of the CSV file
+ @param callback A SaveCallback variable containing the function which is told if the save was written
+ */
+unsigned int CMapSaver::Save(const std::shared_ptr<const CMapLevel>& pSnapshot,
+	const std::string& columnLabels,
+	const std::string& csvFilename,
+	SaveCallback callback)
+{
+	std::unique_ptr<SaveJob> pJob(new SaveJob());
+	pJob->uiSaveID = uiNextSaveID++;
+	if (uiNextSaveID == 0)
+		uiNextSaveID = 1;
+	pJob->pSnapshot = pSnapshot;
+	pJob->columnLabels = columnLabels;
+	pJob->csvFilename = csvFilename;
+	pJob->callback = callback;
+	pJob->bSaved = false;
+
+	const unsigned int uiSaveID = pJob->uiSaveID;
+	uiNumSaves++;
+	uiNumPending++;
+
+	if (!cWorker.joinable())
+	{
+		// Without the I/O thread, the save is written here instead, and delivered like the others
+		pJob->bSaved = Write(*pJob);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_finishedSaves.push_back(std::move(pJob));
+		return uiSaveID;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pendingSaves.push_back(std::move(pJob));
+	}
+	m_cvWork.notify_one();
+	return uiSaveID;
+}
+
+/**
+ @brief Call the callbacks of the saves which have been written, without waiting for the others
+ */
+void CMapSaver::DeliverResults(void)
+{
+	std::vector<std::unique_ptr<SaveJob>> arrFinishedSaves;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		arrFinishedSaves.swap(m_finishedSaves);
+	}
+
+	for (unsigned int i = 0; i < arrFinishedSaves.size(); i++)
+	{
+		SaveJob& sJob = *arrFinishedSaves[i];
+		uiNumPending--;
+		if (!sJob.bSaved)
+			uiNumFailures++;
+		// Release the snapshot before the callback, so that the callback sees it as free again
+		sJob.pSnapshot.reset();
+		if (sJob.callback)
+			sJob.callback(sJob.uiSaveID, sJob.bSaved);
+	}
+}
+
+/**
+ @brief Wait until every queued save has been written, then call their callbacks
+ */
+void CMapSaver::Wait(void)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cvDone.wait(lock, [this] { return m_pendingSaves.empty() && !m_bWriting; });
+	}
+	DeliverResults();
+}
+
+/**
+ @brief Get the number of saves which have not been delivered yet
+ */
+unsigned int CMapSaver::GetNumPending(void) const
+{
+	return uiNumPending;
+}
+
+/**
+ @brief Get the number of saves queued so far
+ */
+unsigned int CMapSaver::GetNumSaves(void) const
+{
+	return uiNumSaves;
+}
+
+/**
+ @brief Get the number of saves which could not be written so far
+ */
+unsigned int CMapSaver::GetNumFailures(void) const
+{
+	return uiNumFailures;
+}
+
+/**
+ @brief Write a file into a temporary file, flush it to the disk and rename it over the file
+ @param filename A const std::string& variable containing the name of the file
+ @param pText A const char* variable containing the text to write
+ @param uiSize A const size_t variable containing the number of characters to write
+ */
+bool CMapSaver::WriteFileAtomically(const std::string& filename, const char* pText, const size_t uiSize)
+{
+	const string tempFilename = filename + ".tmp";
+	if (!tilecsv::WriteFile(tempFilename, pText, uiSize))
+	{
+		remove(tempFilename.c_str());
+		return false;
+	}
+	return CommitFile(tempFilename, filename);
+}
+
+/**
+ @brief Flush a temporary file to the disk and rename it over a file. The temporary file is removed if this fails
+ @param tempFilename A const std::string& variable containing the name of the temporary file
+ @param filename A const std::string& variable containing the name of the file
+ */
+bool CMapSaver::CommitFile(const std::string& tempFilename, const std::string& filename)
+{
+	bool bResult = false;
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(tempFilename.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile != INVALID_HANDLE_VALUE)
+	{
+		const bool bFlushed = (FlushFileBuffers(hFile) != 0);
+		CloseHandle(hFile);
+		bResult = bFlushed &&
+			(MoveFileExA(tempFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+	}
+#else
+	const int iFile = open(tempFilename.c_str(), O_WRONLY);
+	if (iFile >= 0)
+	{
+		const bool bFlushed = (fsync(iFile) == 0);
+		close(iFile);
+		bResult = bFlushed && (rename(tempFilename.c_str(), filename.c_str()) == 0);
+	}
+#endif
+	if (!bResult)
+		remove(tempFilename.c_str());
+	return bResult;
+}
+
+/**
+ @brief Print out details about this class instance in the console window
+ */
+void CMapSaver::PrintSelf(void) const
+{
+	cout << "CMapSaver::PrintSelf()" << endl;
+	cout << "cWorker: " << (cWorker.joinable() ? "running" : "none") << endl;
+	cout << "uiNumSaves: " << uiNumSaves << endl;
+	cout << "uiNumPending: " << uiNumPending << endl;
+	cout << "uiNumFailures: " << uiNumFailures << endl;
+}
+
+/**
+ @brief The loop run by the I/O thread. It writes the queued saves in order, and only stops once they are all written
+ */
+void CMapSaver::WorkerLoop(void)
+{
+	while (true)
+	{
+		std::unique_ptr<SaveJob> pJob;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cvWork.wait(lock, [this] { return m_bStop || !m_pendingSaves.empty(); });
+			if (m_pendingSaves.empty())
+				return;
+			pJob = std::move(m_pendingSaves.front());
+			m_pendingSaves.pop_front();
+			m_bWriting = true;
+		}
+
+		pJob->bSaved = Write(*pJob);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bWriting = false;
+			m_finishedSaves.push_back(std::move(pJob));
+		}
+		m_cvDone.notify_all();
+	}
+}
+
+/**
+ @brief Write a save into its CSV file, then into the level file compiled from it, stamped with the CSV text written.
+		The save fails if either file cannot be written
+ @param sJob A const SaveJob& variable containing the save
+ */
+bool CMapSaver::Write(const SaveJob& sJob)
+{
+	const CMapLevel& cLevel = *sJob.pSnapshot;
+	const size_t uiCsvSize = tilecsv::Format(cLevel.GetTiles(), cLevel.GetNumRows(), cLevel.GetNumCols(), sJob.columnLabels, arrCsvText);
+	if (!WriteFileAtomically(sJob.csvFilename, arrCsvText.data(), uiCsvSize))
+	{
+		cout << "Unable to save the map to " << sJob.csvFilename << endl;
+		return false;
+	}
+
+	// Compile the saved map too, so that loading it does not parse the CSV
+	const string levelFilename = CLevelFile::GetFilename(sJob.csvFilename);
+	if (!CLevelFile::Save(levelFilename, cLevel, sJob.columnLabels, CLevelFile::GetSourceStamp(arrCsvText.data(), uiCsvSize)))
+	{
+		// The old level file holds the level before this save, so it must not be loaded instead of the CSV file
+		remove(levelFilename.c_str());
+		cout << "Unable to save the level file " << levelFilename << endl;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+/**
+ CMapSaver
+ @brief A class which writes snapshots of levels into CSV and level files on an I/O thread, so that saving a level
+		does not stall the frame. Each file is written into a temporary file, flushed to the disk and then
+		renamed over the old file, so a file is never left half written. The results are handed to the callbacks
+		of the saves on the main thread.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The function which is told if a save was written. It is called on the main thread
+using SaveCallback = std::function<void(const unsigned int uiSaveID, const bool bSaved)>;
+
+class CMapSaver
+{
+public:
+	// Constructor
+	CMapSaver(void);
+
+	// Destructor, which finishes writing the queued saves
+	~CMapSaver(void);
+
+	// Start the I/O thread. Without it, the saves are written by Save() on the calling thread
+	void Init(void);
+	// Finish writing the queued saves, then stop the I/O thread and drop the callbacks which have not been called
+	void Destroy(void);
+
+	// Queue a save of a snapshot of a level into a CSV file, and into the level file compiled from it.
+	// The snapshot must not be changed until its callback was called. Returns the ID of this save
+	unsigned int Save(const std::shared_ptr<const CMapLevel>& pSnapshot,
+					const std::string& columnLabels,
+					const std::string& csvFilename,
+					SaveCallback callback);
+
+	// Call the callbacks of the saves which have been written. It does not wait for the others
+	void DeliverResults(void);
+	// Wait until every queued save has been written, then call their callbacks
+	void Wait(void);
+
+	// Get the number of saves which have not been delivered yet
+	unsigned int GetNumPending(void) const;
+	// Get the number of saves queued, and the number which could not be written, so far
+	unsigned int GetNumSaves(void) const;
+	unsigned int GetNumFailures(void) const;
+
+	// Write a file into a temporary file, flush it to the disk and rename it over the file
+	static bool WriteFileAtomically(const std::string& filename, const char* pText, const size_t uiSize);
+	// Flush a temporary file to the disk and rename it over a file
+	static bool CommitFile(const std::string& tempFilename, const std::string& filename);
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// A save. It is only destroyed on the main thread, so that the owner of a snapshot can tell when it is free again
+	struct SaveJob
+	{
+		unsigned int uiSaveID;
+		std::shared_ptr<const CMapLevel> pSnapshot;
+		std::string columnLabels;
+		std::string csvFilename;
+		SaveCallback callback;
+		// The result, written by the I/O thread
+		bool bSaved;
+	};
+
+	// The I/O thread
+	std::thread cWorker;
+
+	// Guards m_pendingSaves, m_finishedSaves, m_bWriting and m_bStop
+	std::mutex m_mutex;
+	// Wakes the I/O thread when a save is queued
+	std::condition_variable m_cvWork;
+	// Wakes the main thread when a save has been written
+	std::condition_variable m_cvDone;
+	std::deque<std::unique_ptr<SaveJob>> m_pendingSaves;
+	std::vector<std::unique_ptr<SaveJob>> m_finishedSaves;
+	bool m_bWriting;
+	bool m_bStop;
+
+	// The CSV text of the I/O thread, kept so that its memory is reused by the next save
+	std::vector<char> arrCsvText;
+
+	// Only used by the main thread
+	unsigned int uiNextSaveID;
+	unsigned int uiNumPending;
+	unsigned int uiNumSaves;
+	unsigned int uiNumFailures;
+
+	// The loop run by the I/O thread
+	void WorkerLoop(void);
+	// Write a save into its files
+	bool Write(const SaveJob& sJob);
+};
@@ -0,0 +1,230 @@
+/**
+ CPathCache
+ @brief A class which keeps the most recently found paths, so that a search which was done before
+		on the same version of a level is answered without searching again.
+		A stored path which passes through the start of a query also answers it, with the rest of that path.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+/**
+ @brief Constructor
+ @param uiCapacity A const unsigned int variable containing the number of paths which are kept
+ */
+CPathCache::CPathCache(const unsigned int uiCapacity)
+	: uiCapacity(uiCapacity)
+	, uiClock(0)
+	, uiNumHits(0)
+	, uiNumSuffixHits(0)
+	, uiNumMisses(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathCache::~CPathCache(void)
+{
+}
+
+/**
+ @brief Get the built-in heuristic function wrapped by heuristicFunc
+ @param heuristicFunc A const HeuristicFunction& variable containing the heuristic
+ */
+const void* CPathCache::GetHeuristicID(const HeuristicFunction& heuristicFunc)
+{
+	typedef unsigned int (*HeuristicPointer)(const glm::vec2&, const glm::vec2&, int);
+	const HeuristicPointer* pFunction = heuristicFunc.target<HeuristicPointer>();
+	return pFunction ? (const void*)*pFunction : NULL;
+}
+
+/**
+ @brief Look up the path for a key. A path stored for the same key is used first,
+		else the rest of a path to the same target which passes through the start of the key
+ @param sKey A const Key& variable containing the key
+ @param path A std::vector<glm::vec2>& variable which will store the path
+ */
+bool CPathCache::Find(const Key& sKey, std::vector<glm::vec2>& path)
+{
+	if (!IsCacheable(sKey))
+	{
+		uiNumMisses++;
+		return false;
+	}
+
+	uiClock++;
+	int iSuffixEntry = -1;
+	unsigned int uiSuffixStart = 0;
+	for (unsigned int i = 0; i < arrEntries.size(); i++)
+	{
+		Entry& entry = arrEntries[i];
+		if (!IsSameSearch(entry.sKey, sKey))
+			continue;
+
+		if (entry.sKey.startPos == sKey.startPos)
+		{
+			entry.uiLastUse = uiClock;
+			path = entry.path;
+			uiNumHits++;
+			return true;
+		}
+
+		if (iSuffixEntry >= 0)
+			continue;
+		std::vector<glm::vec2>::const_iterator it = std::find(entry.path.begin(), entry.path.end(), sKey.startPos);
+		if (it == entry.path.end())
+			continue;
+		// Keep the shape of the paths of CPathFinder::PathFind, which only has 1 entry if the target is next to the start
+		const unsigned int uiStart = (unsigned int)(it - entry.path.begin()) + 1;
+		if ((entry.path.size() - uiStart == 1) &&
+			(abs(sKey.targetPos.y - sKey.startPos.y) + abs(sKey.targetPos.x - sKey.startPos.x) > 1))
+			continue;
+		iSuffixEntry = (int)i;
+		uiSuffixStart = uiStart;
+	}
+
+	if (iSuffixEntry >= 0)
+	{
+		Entry& entry = arrEntries[iSuffixEntry];
+		entry.uiLastUse = uiClock;
+		path.assign(entry.path.begin() + uiSuffixStart, entry.path.end());
+		uiNumHits++;
+		uiNumSuffixHits++;
+		return true;
+	}
+
+	uiNumMisses++;
+	return false;
+}
+
+/**
+ @brief Store the path found for a key
+ @param sKey A const Key& variable containing the key
+ @param path A const std::vector<glm::vec2>& variable containing the path, which is empty if the target cannot be reached
+ */
+void CPathCache::Store(const Key& sKey, const std::vector<glm::vec2>& path)
+{
+	if ((!IsCacheable(sKey)) || (uiCapacity == 0))
+		return;
+
+	uiClock++;
+	// Replace the path stored for this key, else add one, else replace the least recently used one
+	unsigned int uiEntry = 0;
+	while ((uiEntry < arrEntries.size()) &&
+		!(IsSameSearch(arrEntries[uiEntry].sKey, sKey) && (arrEntries[uiEntry].sKey.startPos == sKey.startPos)))
+		uiEntry++;
+	if ((uiEntry == arrEntries.size()) && (arrEntries.size() < uiCapacity))
+	{
+		arrEntries.push_back(Entry());
+	}
+	else if (uiEntry == arrEntries.size())
+	{
+		uiEntry = 0;
+		for (unsigned int i = 1; i < arrEntries.size(); i++)
+		{
+			if (arrEntries[i].uiLastUse < arrEntries[uiEntry].uiLastUse)
+				uiEntry = i;
+		}
+	}
+	Entry& entry = arrEntries[uiEntry];
+	entry.sKey = sKey;
+	entry.path = path;
+	entry.uiLastUse = uiClock;
+}
+
+/**
+ @brief Remove every stored path
+ */
+void CPathCache::Clear(void)
+{
+	arrEntries.clear();
+}
+
+/**
+ @brief Set the number of paths which are kept. The least recently used paths are removed if there are too many
+ @param uiCapacity A const unsigned int variable containing the number of paths
+ */
+void CPathCache::SetCapacity(const unsigned int uiCapacity)
+{
+	this->uiCapacity = uiCapacity;
+	if (arrEntries.size() <= uiCapacity)
+		return;
+
+	std::sort(arrEntries.begin(), arrEntries.end(),
+		[](const Entry& a, const Entry& b) { return a.uiLastUse > b.uiLastUse; });
+	arrEntries.resize(uiCapacity);
+}
+
+/**
+ @brief Get the number of paths which are kept
+ */
+unsigned int CPathCache::GetCapacity(void) const
+{
+	return uiCapacity;
+}
+
+/**
+ @brief Get the number of queries answered by a stored path
+ */
+unsigned int CPathCache::GetNumHits(void) const
+{
+	return uiNumHits;
+}
+
+/**
+ @brief Get the number of queries answered by the rest of a stored path
+ */
+unsigned int CPathCache::GetNumSuffixHits(void) const
+{
+	return uiNumSuffixHits;
+}
+
+/**
+ @brief Get the number of queries which had to be searched for
+ */
+unsigned int CPathCache::GetNumMisses(void) const
+{
+	return uiNumMisses;
+}
+
+/**
+ @brief Print out details about this class instance in the console window
+ */
+void CPathCache::PrintSelf(void) const
+{
+	cout << "CPathCache::PrintSelf()" << endl;
+	cout << "arrEntries: " << arrEntries.size() << " / " << uiCapacity << endl;
+	cout << "uiNumHits: " << uiNumHits << " (" << uiNumSuffixHits << " from the rest of a path)" << endl;
+	cout << "uiNumMisses: " << uiNumMisses << endl;
+}
+
+/**
+ @brief Check if a key can be stored
+ @param sKey A const Key& variable containing the key
+ */
+bool CPathCache::IsCacheable(const Key& sKey)
+{
+	return (sKey.pHeuristicID != NULL) && (sKey.startPos != sKey.targetPos);
+}
+
+/**
+ @brief Check if two keys are the same apart from the start position
+ @param sKey A const Key& variable containing a key
+ @param sOtherKey A const Key& variable containing the other key
+ */
+bool CPathCache::IsSameSearch(const Key& sKey, const Key& sOtherKey)
+{
+	return (sKey.pLevelID == sOtherKey.pLevelID) &&
+		(sKey.uiMapVersion == sOtherKey.uiMapVersion) &&
+		(sKey.targetPos == sOtherKey.targetPos) &&
+		(sKey.pHeuristicID == sOtherKey.pHeuristicID) &&
+		(sKey.weight == sOtherKey.weight) &&
+		(sKey.uiNrOfDirections == sOtherKey.uiNrOfDirections);
+}
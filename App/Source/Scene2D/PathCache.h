@@ -0,0 +1,88 @@
+/**
+ CPathCache
+ @brief A class which keeps the most recently found paths, so that a search which was done before
+		on the same version of a level is answered without searching again.
+		A stored path which passes through the start of a query also answers it, with the rest of that path.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include PathFinder for the heuristics
+#include "PathFinder.h"
+
+#include <vector>
+
+class CPathCache
+{
+public:
+	// What a path was searched for. Two searches with the same key return the same path
+	struct Key
+	{
+		// The level and its version
+		const void* pLevelID;
+		unsigned int uiMapVersion;
+
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+		// The built-in heuristic function, or NULL if it cannot be compared with others
+		const void* pHeuristicID;
+		int weight;
+		unsigned int uiNrOfDirections;
+	};
+
+	// Constructor
+	CPathCache(const unsigned int uiCapacity = 64);
+
+	// Destructor
+	~CPathCache(void);
+
+	// Get the built-in heuristic function wrapped by heuristicFunc, or NULL if it is not one of them
+	static const void* GetHeuristicID(const HeuristicFunction& heuristicFunc);
+
+	// Look up the path for a key, and count a hit or a miss. Returns false if it has to be searched for
+	bool Find(const Key& sKey, std::vector<glm::vec2>& path);
+	// Store the path found for a key, replacing the least recently used path if the cache is full
+	void Store(const Key& sKey, const std::vector<glm::vec2>& path);
+	// Remove every stored path
+	void Clear(void);
+
+	// Set the number of paths which are kept
+	void SetCapacity(const unsigned int uiCapacity);
+	// Get the number of paths which are kept
+	unsigned int GetCapacity(void) const;
+
+	// Get the number of queries answered by a stored path, including those answered by the rest of one
+	unsigned int GetNumHits(void) const;
+	// Get the number of queries answered by the rest of a stored path
+	unsigned int GetNumSuffixHits(void) const;
+	// Get the number of queries which had to be searched for
+	unsigned int GetNumMisses(void) const;
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// A stored path, and when it was last used
+	struct Entry
+	{
+		Key sKey;
+		std::vector<glm::vec2> path;
+		unsigned int uiLastUse;
+	};
+
+	// The stored paths
+	std::vector<Entry> arrEntries;
+	unsigned int uiCapacity;
+	unsigned int uiClock;
+
+	// Counters
+	unsigned int uiNumHits;
+	unsigned int uiNumSuffixHits;
+	unsigned int uiNumMisses;
+
+	// Check if a key can be stored. Searches with an unknown heuristic, or from a tile to itself, are not
+	static bool IsCacheable(const Key& sKey);
+	// Check if two keys are the same apart from the start position
+	static bool IsSameSearch(const Key& sKey, const Key& sOtherKey);
+};
@@ -0,0 +1,632 @@
+/**
+ CPathFinder
+ @brief A class which runs A* Path Finding or Jump Point Search over the tiles of a CMapLevel
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Get the directions which Jump Point Search continues in from a jump point
+ @param cLevel A const CMapLevel& variable containing the level being searched
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param iX A const int variable containing the column of the jump point
+ @param iY A const int variable containing the inverted row of the jump point
+ @param iDirection A const int variable containing the direction the jump point was reached in, or -1 for the start
+ @param arrDirections An unsigned int array which will store up to 8 directions
+ @return The number of directions stored in arrDirections
+ */
+static unsigned int GetJumpDirections(const CMapLevel& cLevel,
+	const unsigned int uiNrOfDirections,
+	const int iX,
+	const int iY,
+	const int iDirection,
+	unsigned int* arrDirections)
+{
+	unsigned int uiNumDirections = 0;
+
+	// The start node continues in every direction
+	if (iDirection < 0)
+	{
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+			arrDirections[uiNumDirections++] = i;
+		return uiNumDirections;
+	}
+
+	const int iDeltaX = iDirectionX[iDirection];
+	const int iDeltaY = iDirectionY[iDirection];
+	arrDirections[uiNumDirections++] = iDirection;
+
+	if (uiNrOfDirections == 4)
+	{
+		if (iDeltaY == 0)
+		{
+			// Turning from a horizontal move to a vertical move is always allowed
+			arrDirections[uiNumDirections++] = 2;
+			arrDirections[uiNumDirections++] = 3;
+		}
+		else
+		{
+			// Turning from a vertical move is only needed where the horizontal move was blocked a tile earlier
+			for (int iSide = -1; iSide <= 1; iSide += 2)
+			{
+				if (!CJumpTable::IsFree(cLevel, iX + iSide, iY - iDeltaY) && CJumpTable::IsFree(cLevel, iX + iSide, iY))
+					arrDirections[uiNumDirections++] = GetDirectionIndex(iSide, 0);
+			}
+		}
+	}
+	else if ((iDeltaX == 0) || (iDeltaY == 0))
+	{
+		// Turning diagonally from a straight move is only needed around a blocked tile beside it
+		for (int iSide = -1; iSide <= 1; iSide += 2)
+		{
+			const int iSideX = iDeltaY * iSide;
+			const int iSideY = iDeltaX * iSide;
+			if (!CJumpTable::IsFree(cLevel, iX + iSideX, iY + iSideY) &&
+				CJumpTable::IsFree(cLevel, iX + iSideX + iDeltaX, iY + iSideY + iDeltaY))
+				arrDirections[uiNumDirections++] = GetDirectionIndex(iSideX + iDeltaX, iSideY + iDeltaY);
+		}
+	}
+	else
+	{
+		// A diagonal move continues straight along both of its parts,
+		// and turns to the other diagonals around the blocked tiles behind it
+		arrDirections[uiNumDirections++] = GetDirectionIndex(iDeltaX, 0);
+		arrDirections[uiNumDirections++] = GetDirectionIndex(0, iDeltaY);
+		if (!CJumpTable::IsFree(cLevel, iX - iDeltaX, iY) && CJumpTable::IsFree(cLevel, iX - iDeltaX, iY + iDeltaY))
+			arrDirections[uiNumDirections++] = GetDirectionIndex(-iDeltaX, iDeltaY);
+		if (!CJumpTable::IsFree(cLevel, iX, iY - iDeltaY) && CJumpTable::IsFree(cLevel, iX + iDeltaX, iY - iDeltaY))
+			arrDirections[uiNumDirections++] = GetDirectionIndex(iDeltaX, -iDeltaY);
+	}
+
+	return uiNumDirections;
+}
+
+/**
+ @brief Get the number of steps in a direction to the target, or to the tile which lines up with the target.
+		Straight directions only reach the target itself. The directions which sweep for jump points
+		(diagonal with 8 directions, horizontal with 4 directions) stop in line with the target.
+ @return The number of steps, or 0 if the target is not ahead in this direction
+ */
+static int GetStepsToTarget(const unsigned int uiNrOfDirections,
+	const int iX,
+	const int iY,
+	const int iTargetX,
+	const int iTargetY,
+	const unsigned int uiDirection)
+{
+	const int iDeltaX = iDirectionX[uiDirection];
+	const int iDeltaY = iDirectionY[uiDirection];
+	const int iToTargetX = iTargetX - iX;
+	const int iToTargetY = iTargetY - iY;
+	const int iSignX = (iToTargetX > 0) - (iToTargetX < 0);
+	const int iSignY = (iToTargetY > 0) - (iToTargetY < 0);
+
+	if ((uiNrOfDirections == 8) && (iDeltaX != 0) && (iDeltaY != 0))
+	{
+		if ((iSignX != iDeltaX) || (iSignY != iDeltaY))
+			return 0;
+		return std::min(abs(iToTargetX), abs(iToTargetY));
+	}
+	if ((uiNrOfDirections == 4) && (iDeltaY == 0))
+		return (iSignX == iDeltaX) ? abs(iToTargetX) : 0;
+	if ((iSignX != iDeltaX) || (iSignY != iDeltaY))
+		return 0;
+	return abs(iToTargetX) + abs(iToTargetY);
+}
+
+/**
+ @brief Constructor
+ */
+CPathFinder::CPathFinder(void)
+	: m_weight(1)
+	, m_nrOfDirections(4)
+	, m_searchMode(ASTAR)
+	, m_startPos(0, 0)
+	, m_targetPos(0, 0)
+	, m_uiGeneration(0)
+	, m_uiNumNodesExpanded(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CPathFinder::~CPathFinder(void)
+{
+}
+
+/**
+ @brief Init the search lists for levels of this size
+ @param uiNumRows A const unsigned int variable containing the number of rows in the level
+ @param uiNumCols A const unsigned int variable containing the number of columns in the level
+ */
+void CPathFinder::Init(const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	sMapSize.uiRowSize = uiNumRows;
+	sMapSize.uiColSize = uiNumCols;
+
+	Node node;
+	node.uiGeneration = 0;
+	node.g = 0;
+	node.iParent = -1;
+	node.iDirection = -1;
+	node.bClosed = false;
+	m_nodes.assign(uiNumRows * uiNumCols, node);
+	m_openList.Init(uiNumRows * uiNumCols);
+	m_uiGeneration = 0;
+}
+
+/**
+ @brief Find a path
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ @param pJumpTable A CJumpTable* variable containing the jump distances of cLevel for JPSPLUS, or NULL
+ */
+std::vector<glm::vec2> CPathFinder::PathFind(const CMapLevel& cLevel,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	int weight,
+	CJumpTable* pJumpTable)
+{
+	// Use the inlined heuristic policy for the built-in heuristic functions
+	typedef unsigned int (*HeuristicPointer)(const glm::vec2&, const glm::vec2&, int);
+	const HeuristicPointer* pFunction = heuristicFunc.target<HeuristicPointer>();
+	if (pFunction && (*pFunction == &heuristic::manhattan))
+		return DispatchPathFind(cLevel, startPos, targetPos, heuristic::Manhattan(), weight, pJumpTable);
+	if (pFunction && (*pFunction == &heuristic::euclidean))
+		return DispatchPathFind(cLevel, startPos, targetPos, heuristic::Euclidean(), weight, pJumpTable);
+
+	return DispatchPathFind(cLevel, startPos, targetPos, heuristic::Function(heuristicFunc), weight, pJumpTable);
+}
+
+/**
+ @brief Find a path with a heuristic policy and a fixed number of directions
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A const Heuristic& variable containing the heuristic policy to use
+ @param weight An int variable containing the weight of the heuristic
+ */
+template <unsigned int NrOfDirections, typename Heuristic>
+std::vector<glm::vec2> CPathFinder::PathFind(const CMapLevel& cLevel,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	const Heuristic& heuristicFunc,
+	int weight)
+{
+	static_assert((NrOfDirections == 4) || (NrOfDirections == 8), "PathFind supports 4 or 8 directions");
+
+	if (!BeginSearch(cLevel, startPos, targetPos, weight))
+		return std::vector<glm::vec2>();
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iNumRows = (int)sMapSize.uiRowSize;
+	const int iTargetX = (int)m_targetPos.x;
+	const int iTargetY = (int)m_targetPos.y;
+
+	// Add the start pos to the open list
+	const int iStart = ConvertTo1D(m_startPos);
+	const int iTarget = ConvertTo1D(m_targetPos);
+	Node& startNode = GetNode(iStart);
+	startNode.iParent = iStart;
+	m_openList.Push(iStart, 0);
+
+	// Start the path finding...
+	while (!m_openList.Empty())
+	{
+		// Get the node with the least f value
+		const int iCurrent = m_openList.Top();
+
+		// If the targetPos was reached, then quit this loop
+		if (iCurrent == iTarget)
+		{
+			m_openList.Clear();
+			break;
+		}
+
+		m_openList.Pop();
+		Node& currentNode = m_nodes[iCurrent];
+		currentNode.bClosed = true;
+		m_uiNumNodesExpanded++;
+
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		const unsigned int gNew = currentNode.g + 1;
+
+		// Check the neighbors of the current node
+		for (unsigned int i = 0; i < NrOfDirections; ++i)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if ((iNeighborX < 0) || (iNeighborX >= iNumCols) ||
+				(iNeighborY < 0) || (iNeighborY >= iNumRows) ||
+				cLevel.IsBlocked(iNeighborY, iNeighborX))
+				continue;
+
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			const bool bSeen = (m_nodes[iNeighbor].uiGeneration == m_uiGeneration);
+			Node& neighborNode = GetNode(iNeighbor);
+			if (neighborNode.bClosed)
+				continue;
+
+			// Only update the neighbor if it is new or this path to it is shorter
+			if (!bSeen || gNew < neighborNode.g)
+			{
+				neighborNode.g = gNew;
+				neighborNode.iParent = iCurrent;
+				m_openList.Push(iNeighbor, gNew + heuristicFunc(iNeighborX, iNeighborY, iTargetX, iTargetY, m_weight));
+			}
+		}
+	}
+
+	return BuildPath();
+}
+
+// The heuristic policies and neighbourhoods which PathFind is compiled for
+template std::vector<glm::vec2> CPathFinder::PathFind<4, heuristic::Manhattan>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Manhattan&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<8, heuristic::Manhattan>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Manhattan&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<4, heuristic::Octile>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Octile&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<8, heuristic::Octile>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Octile&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<4, heuristic::Euclidean>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Euclidean&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<8, heuristic::Euclidean>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Euclidean&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<4, heuristic::Zero>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Zero&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<8, heuristic::Zero>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Zero&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<4, heuristic::Function>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Function&, int);
+template std::vector<glm::vec2> CPathFinder::PathFind<8, heuristic::Function>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Function&, int);
+
+/**
+ @brief Find a path with Jump Point Search. Instead of every neighbour, only the jump points are added to
+		the open list: the tiles where an optimal path may have to turn. BuildPath fills in the tiles between them.
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A const Heuristic& variable containing the heuristic policy to use
+ @param weight An int variable containing the weight of the heuristic
+ @param pJumpTable A CJumpTable* variable containing the precomputed jump distances of cLevel, or NULL to scan the tiles
+ */
+template <unsigned int NrOfDirections, typename Heuristic>
+std::vector<glm::vec2> CPathFinder::JumpPointSearch(const CMapLevel& cLevel,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	const Heuristic& heuristicFunc,
+	int weight,
+	CJumpTable* pJumpTable)
+{
+	static_assert((NrOfDirections == 4) || (NrOfDirections == 8), "JumpPointSearch supports 4 or 8 directions");
+
+	if (!BeginSearch(cLevel, startPos, targetPos, weight))
+		return std::vector<glm::vec2>();
+
+	// Rebuild the jump distances if a blocking tile has changed since they were built
+	if (pJumpTable && !pJumpTable->IsValid(cLevel, NrOfDirections))
+		pJumpTable->Build(cLevel, NrOfDirections);
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iTargetX = (int)m_targetPos.x;
+	const int iTargetY = (int)m_targetPos.y;
+
+	// Add the start pos to the open list
+	const int iStart = ConvertTo1D(m_startPos);
+	const int iTarget = ConvertTo1D(m_targetPos);
+	Node& startNode = GetNode(iStart);
+	startNode.iParent = iStart;
+	startNode.iDirection = -1;
+	m_openList.Push(iStart, 0);
+
+	unsigned int arrDirections[8];
+
+	// Start the path finding...
+	while (!m_openList.Empty())
+	{
+		// Get the node with the least f value
+		const int iCurrent = m_openList.Top();
+
+		// If the targetPos was reached, then quit this loop
+		if (iCurrent == iTarget)
+		{
+			m_openList.Clear();
+			break;
+		}
+
+		m_openList.Pop();
+		Node& currentNode = m_nodes[iCurrent];
+		currentNode.bClosed = true;
+		m_uiNumNodesExpanded++;
+
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		const unsigned int uiNumDirections = GetJumpDirections(cLevel, NrOfDirections, iCurrentX, iCurrentY,
+																currentNode.iDirection, arrDirections);
+
+		// Jump from the current node in each direction
+		for (unsigned int i = 0; i < uiNumDirections; ++i)
+		{
+			const unsigned int uiDirection = arrDirections[i];
+			const int iDistance = pJumpTable ?
+				pJumpTable->GetJumpDistance(iCurrent, uiDirection) :
+				CJumpTable::ComputeJumpDistance(cLevel, NrOfDirections, iCurrentX, iCurrentY, uiDirection);
+			const int iFreeSteps = (iDistance > 0) ? iDistance : -iDistance;
+
+			// Stop at the target, or in line with it, if it comes before the next jump point or wall.
+			// Otherwise go to the next jump point, if there is one
+			int iSteps = GetStepsToTarget(NrOfDirections, iCurrentX, iCurrentY, iTargetX, iTargetY, uiDirection);
+			if ((iSteps == 0) || (iSteps > iFreeSteps))
+				iSteps = (iDistance > 0) ? iDistance : 0;
+			if (iSteps == 0)
+				continue;
+
+			const int iNeighborX = iCurrentX + iSteps * iDirectionX[uiDirection];
+			const int iNeighborY = iCurrentY + iSteps * iDirectionY[uiDirection];
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			const bool bSeen = (m_nodes[iNeighbor].uiGeneration == m_uiGeneration);
+			Node& neighborNode = GetNode(iNeighbor);
+
+			// Only update the neighbor if it is new or this path to it is shorter.
+			// A jump point only continues in the directions allowed by the way it was reached,
+			// so a closed one is opened again when a weighted heuristic finds a shorter path to it later
+			const unsigned int gNew = currentNode.g + iSteps;
+			if (!bSeen || gNew < neighborNode.g)
+			{
+				neighborNode.bClosed = false;
+				neighborNode.g = gNew;
+				neighborNode.iParent = iCurrent;
+				neighborNode.iDirection = (int)uiDirection;
+				m_openList.Push(iNeighbor, gNew + heuristicFunc(iNeighborX, iNeighborY, iTargetX, iTargetY, m_weight));
+			}
+		}
+	}
+
+	return BuildPath();
+}
+
+// The heuristic policies and neighbourhoods which JumpPointSearch is compiled for
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<4, heuristic::Manhattan>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Manhattan&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<8, heuristic::Manhattan>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Manhattan&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<4, heuristic::Octile>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Octile&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<8, heuristic::Octile>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Octile&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<4, heuristic::Euclidean>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Euclidean&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<8, heuristic::Euclidean>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Euclidean&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<4, heuristic::Zero>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Zero&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<8, heuristic::Zero>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Zero&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<4, heuristic::Function>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Function&, int, CJumpTable*);
+template std::vector<glm::vec2> CPathFinder::JumpPointSearch<8, heuristic::Function>(const CMapLevel&, const glm::vec2&, const glm::vec2&, const heuristic::Function&, int, CJumpTable*);
+
+/**
+ @brief Run PathFind() or JumpPointSearch() with a heuristic policy, using the current search mode and diagonal movement setting
+ */
+template <typename Heuristic>
+std::vector<glm::vec2> CPathFinder::DispatchPathFind(const CMapLevel& cLevel,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	const Heuristic& heuristicFunc,
+	int weight,
+	CJumpTable* pJumpTable)
+{
+	if (m_searchMode != ASTAR)
+	{
+		// JPS scans the tiles itself, while JPSPLUS reads them from the jump table if there is one
+		if (m_searchMode != JPSPLUS)
+			pJumpTable = NULL;
+		if (m_nrOfDirections == 8)
+			return JumpPointSearch<8>(cLevel, startPos, targetPos, heuristicFunc, weight, pJumpTable);
+		return JumpPointSearch<4>(cLevel, startPos, targetPos, heuristicFunc, weight, pJumpTable);
+	}
+
+	if (m_nrOfDirections == 8)
+		return PathFind<8>(cLevel, startPos, targetPos, heuristicFunc, weight);
+	return PathFind<4>(cLevel, startPos, targetPos, heuristicFunc, weight);
+}
+
+/**
+ @brief Check if the start and target positions can be searched, and set up a new search if they can
+ */
+bool CPathFinder::BeginSearch(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, int weight)
+{
+	// Make sure that the lists are big enough for this level
+	if ((cLevel.GetNumRows() != sMapSize.uiRowSize) || (cLevel.GetNumCols() != sMapSize.uiColSize))
+		Init(cLevel.GetNumRows(), cLevel.GetNumCols());
+
+	// Check if the startPos and targetPost are blocked
+	if (!isValid(startPos) || !isValid(targetPos) ||
+		cLevel.IsBlocked((unsigned int)startPos.y, (unsigned int)startPos.x) ||
+		cLevel.IsBlocked((unsigned int)targetPos.y, (unsigned int)targetPos.x))
+	{
+		cout << "Invalid start or target position." << endl;
+		m_uiNumNodesExpanded = 0;
+		return false;
+	}
+
+	// Set up the variables and lists
+	m_startPos = startPos;
+	m_targetPos = targetPos;
+	m_weight = weight;
+	NewSearch();
+
+	return true;
+}
+
+/**
+ @brief Set the search algorithm used by the non-templated PathFind
+ @param eSearchMode A const SEARCHMODE variable containing the search algorithm
+ */
+void CPathFinder::SetSearchMode(const SEARCHMODE eSearchMode)
+{
+	m_searchMode = eSearchMode;
+}
+
+/**
+ @brief Get the search algorithm used by the non-templated PathFind
+ */
+CPathFinder::SEARCHMODE CPathFinder::GetSearchMode(void) const
+{
+	return m_searchMode;
+}
+
+/**
+ @brief Toggle the checks for diagonal movements
+ */
+void CPathFinder::SetDiagonalMovement(const bool bEnable)
+{
+	m_nrOfDirections = (bEnable) ? 8 : 4;
+}
+
+/**
+ @brief Get if AStar PathFinding will consider diagonal movements
+ */
+bool CPathFinder::GetDiagonalMovement(void) const
+{
+	return m_nrOfDirections == 8;
+}
+
+/**
+ @brief Get the number of nodes expanded by the last call to PathFind()
+ */
+unsigned int CPathFinder::GetNumNodesExpanded(void) const
+{
+	return m_uiNumNodesExpanded;
+}
+
+/**
+ @brief Print out the details about this class instance in the console
+ */
+void CPathFinder::PrintSelf(void) const
+{
+	cout << "m_searchMode: " << m_searchMode << endl;
+	cout << "m_openList: " << m_openList.Size() << endl;
+	cout << "m_nodes: " << m_nodes.size() << endl;
+	cout << "m_uiGeneration: " << m_uiGeneration << endl;
+	cout << "m_uiNumNodesExpanded: " << m_uiNumNodesExpanded << endl;
+}
+
+/**
+ @brief Start a new search, invalidating the data of every node
+ */
+void CPathFinder::NewSearch(void)
+{
+	m_openList.Clear();
+	m_uiNumNodesExpanded = 0;
+	m_uiGeneration++;
+
+	// If the generation counter wrapped around, then the old stamps could match again
+	if (m_uiGeneration == 0)
+	{
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			m_nodes[i].uiGeneration = 0;
+		m_uiGeneration = 1;
+	}
+}
+
+/**
+ @brief Get a node, resetting it if it was last touched by an older search
+ @param iNode A const int variable containing the 1D position of the node
+ */
+CPathFinder::Node& CPathFinder::GetNode(const int iNode)
+{
+	Node& node = m_nodes[iNode];
+	if (node.uiGeneration != m_uiGeneration)
+	{
+		node.uiGeneration = m_uiGeneration;
+		node.g = 0;
+		node.iParent = -1;
+		node.iDirection = -1;
+		node.bClosed = false;
+	}
+	return node;
+}
+
+/**
+ @brief Build a path
+ */
+std::vector<glm::vec2> CPathFinder::BuildPath(void) const
+{
+	std::vector<glm::vec2> path;
+	const int iStart = ConvertTo1D(m_startPos);
+	int iCurrent = ConvertTo1D(m_targetPos);
+
+	// If the target was not reached in this search, then there is no path
+	if ((m_nodes[iCurrent].uiGeneration != m_uiGeneration) || (m_nodes[iCurrent].iParent < 0))
+		return path;
+
+	while (iCurrent != iStart)
+	{
+		// The parent of a Jump Point Search node can be several tiles away in a straight or diagonal line,
+		// so step back towards it one tile at a time
+		const int iParent = m_nodes[iCurrent].iParent;
+		glm::vec2 pos = ConvertTo2D(iCurrent);
+		const glm::vec2 parentPos = ConvertTo2D(iParent);
+		const glm::vec2 step = glm::sign(parentPos - pos);
+		while (pos != parentPos)
+		{
+			path.push_back(pos);
+			pos += step;
+		}
+		iCurrent = iParent;
+	}
+
+	// If the path has only 1 entry, then it is the the target position
+	// This is only OK if m_startPos is next to m_targetPos
+	if (path.size() == 1)
+	{
+		if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+			path.clear();
+	}
+	else
+		std::reverse(path.begin(), path.end());
+
+	return path;
+}
+
+/**
+ @brief Check if a position is valid
+ */
+bool CPathFinder::isValid(const glm::vec2& pos) const
+{
+	return (pos.x >= 0) && (pos.x < sMapSize.uiColSize) &&
+		(pos.y >= 0) && (pos.y < sMapSize.uiRowSize);
+}
+
+/**
+ @brief Returns a 1D index based on a 2D coordinate using row-major layout
+ */
+int CPathFinder::ConvertTo1D(const glm::vec2& pos) const
+{
+	return ((int)pos.y * sMapSize.uiColSize) + (int)pos.x;
+}
+
+/**
+ @brief Returns a 2D coordinate based on a 1D index using row-major layout
+ */
+glm::vec2 CPathFinder::ConvertTo2D(const int iNode) const
+{
+	return glm::vec2(iNode % sMapSize.uiColSize, iNode / sMapSize.uiColSize);
+}
+
+/**
+ @brief manhattan calculation method for calculation of h
+ */
+unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
+{
+	glm::vec2 delta = glm::abs(v2 - v1);
+	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+}
+
+/**
+ @brief euclidean calculation method for calculation of h
+ */
+unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight)
+{
+	glm::vec2 delta = v2 - v1;
+	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
+}
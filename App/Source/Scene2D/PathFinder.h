@@ -0,0 +1,206 @@
+/**
+ CPathFinder
+ @brief A class which runs A* Path Finding or Jump Point Search over the tiles of a CMapLevel
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include MapLevel
+#include "MapLevel.h"
+// Include IndexedHeap for the open list
+#include "IndexedHeap.h"
+// Include JumpTable for Jump Point Search
+#include "JumpTable.h"
+
+#include <vector>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+
+using HeuristicFunction = std::function<unsigned int(const glm::vec2&, const glm::vec2&, int)>;
+
+namespace heuristic
+{
+	unsigned int manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight);
+	unsigned int euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight);
+
+	// Heuristic policies for the templated CPathFinder::PathFind.
+	// The compiler can inline these, unlike a call through a HeuristicFunction.
+	struct Manhattan
+	{
+		unsigned int operator()(const int iX, const int iY, const int iTargetX, const int iTargetY, const int weight) const
+		{
+			return weight * (std::abs(iTargetX - iX) + std::abs(iTargetY - iY));
+		}
+	};
+
+	// Diagonal steps cost the same as straight steps in CPathFinder,
+	// so the octile distance reduces to the larger of the 2 deltas
+	struct Octile
+	{
+		unsigned int operator()(const int iX, const int iY, const int iTargetX, const int iTargetY, const int weight) const
+		{
+			const int iDeltaX = std::abs(iTargetX - iX);
+			const int iDeltaY = std::abs(iTargetY - iY);
+			return weight * (iDeltaX > iDeltaY ? iDeltaX : iDeltaY);
+		}
+	};
+
+	struct Euclidean
+	{
+		unsigned int operator()(const int iX, const int iY, const int iTargetX, const int iTargetY, const int weight) const
+		{
+			const float fDeltaX = (float)(iTargetX - iX);
+			const float fDeltaY = (float)(iTargetY - iY);
+			return static_cast<unsigned int>(weight * std::sqrt(fDeltaX * fDeltaX + fDeltaY * fDeltaY));
+		}
+	};
+
+	// No heuristic, which turns the search into Dijkstra's algorithm
+	struct Zero
+	{
+		unsigned int operator()(const int, const int, const int, const int, const int) const
+		{
+			return 0;
+		}
+	};
+
+	// Wraps any other HeuristicFunction, for callers which pass their own function
+	struct Function
+	{
+		Function(const HeuristicFunction& heuristicFunc) : heuristicFunc(heuristicFunc) {}
+
+		unsigned int operator()(const int iX, const int iY, const int iTargetX, const int iTargetY, const int weight) const
+		{
+			return heuristicFunc(glm::vec2(iX, iY), glm::vec2(iTargetX, iTargetY), weight);
+		}
+
+		HeuristicFunction heuristicFunc;
+	};
+}
+
+class CPathFinder
+{
+public:
+	// The search algorithms which PathFind can use
+	enum SEARCHMODE
+	{
+		ASTAR = 0,	// A* over every tile
+		JPS,		// Jump Point Search, scanning the tiles during the search
+		JPSPLUS,	// Jump Point Search, reading precomputed jump distances from a CJumpTable
+		NUM_SEARCHMODES
+	};
+
+	// Constructor
+	CPathFinder(void);
+
+	// Destructor
+	~CPathFinder(void);
+
+	// Init the search lists for levels of this size
+	void Init(const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Find a path in cLevel from startPos to targetPos. Positions are (column, inverted row)
+	// This picks the templated search below which matches heuristicFunc, the search mode and the diagonal movement setting.
+	// pJumpTable holds the jump distances of cLevel for JPSPLUS; without it, JPSPLUS runs as JPS
+	std::vector<glm::vec2> PathFind(const CMapLevel& cLevel,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									HeuristicFunction heuristicFunc,
+									int weight = 1,
+									CJumpTable* pJumpTable = NULL);
+
+	// Find a path with a heuristic policy from the heuristic namespace and a fixed number of directions (4 or 8)
+	template <unsigned int NrOfDirections, typename Heuristic>
+	std::vector<glm::vec2> PathFind(const CMapLevel& cLevel,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									const Heuristic& heuristicFunc,
+									int weight = 1);
+
+	// Find a path with Jump Point Search. It returns the same tile by tile paths as PathFind.
+	// If pJumpTable is not NULL, then the jump distances are read from it (JPS+), rebuilding it first if it is out of date
+	template <unsigned int NrOfDirections, typename Heuristic>
+	std::vector<glm::vec2> JumpPointSearch(const CMapLevel& cLevel,
+											const glm::vec2& startPos,
+											const glm::vec2& targetPos,
+											const Heuristic& heuristicFunc,
+											int weight = 1,
+											CJumpTable* pJumpTable = NULL);
+
+	// Set the search algorithm used by the non-templated PathFind
+	void SetSearchMode(const SEARCHMODE eSearchMode);
+	// Get the search algorithm used by the non-templated PathFind
+	SEARCHMODE GetSearchMode(void) const;
+
+	// Set if AStar PathFinding will consider diagonal movements
+	void SetDiagonalMovement(const bool bEnable);
+	// Get if AStar PathFinding will consider diagonal movements
+	bool GetDiagonalMovement(void) const;
+
+	// Get the number of nodes expanded by the last call to PathFind()
+	unsigned int GetNumNodesExpanded(void) const;
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// The A* data of a map grid. A node only holds valid data if its
+	// uiGeneration matches m_uiGeneration, so a new search resets every node in O(1)
+	struct Node
+	{
+		unsigned int uiGeneration;
+		unsigned int g;
+		int iParent;
+		// The direction which Jump Point Search reached this node in, or -1 for the start node
+		int iDirection;
+		bool bClosed;
+	};
+
+	// The size of the level being searched
+	MapSize sMapSize;
+
+	// Variables for A-Star PathFinding
+	int m_weight;
+	unsigned int m_nrOfDirections;
+	SEARCHMODE m_searchMode;
+	glm::vec2 m_startPos;
+	glm::vec2 m_targetPos;
+
+	// The search which is currently running. Incremented by every call to PathFind()
+	unsigned int m_uiGeneration;
+	// The number of nodes expanded by the last call to PathFind()
+	unsigned int m_uiNumNodesExpanded;
+
+	// Lists for A-Star PathFinding
+	CIndexedHeap<unsigned int> m_openList;
+	std::vector<Node> m_nodes;
+
+	// Run PathFind() or JumpPointSearch() with a heuristic policy, using the current search mode and diagonal movement setting
+	template <typename Heuristic>
+	std::vector<glm::vec2> DispatchPathFind(const CMapLevel& cLevel,
+											const glm::vec2& startPos,
+											const glm::vec2& targetPos,
+											const Heuristic& heuristicFunc,
+											int weight,
+											CJumpTable* pJumpTable);
+
+	// Check if the start and target positions can be searched, and set up a new search if they can
+	bool BeginSearch(const CMapLevel& cLevel, const glm::vec2& startPos, const glm::vec2& targetPos, int weight);
+	// Start a new search, invalidating the data of every node
+	void NewSearch(void);
+	// Get a node, resetting it if it was last touched by an older search
+	Node& GetNode(const int iNode);
+	// Build a path from the nodes after calling PathFind() or JumpPointSearch()
+	std::vector<glm::vec2> BuildPath(void) const;
+	// Check if a grid is valid
+	bool isValid(const glm::vec2& pos) const;
+	// Convert a position to a 1D position in the array
+	int ConvertTo1D(const glm::vec2& pos) const;
+	// Convert a 1D position in the array to a position
+	glm::vec2 ConvertTo2D(const int iNode) const;
+};
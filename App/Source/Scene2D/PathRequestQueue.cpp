@@ -0,0 +1,355 @@
+/**
+ CPathRequestQueue
+ @brief A class which runs path finding requests on a pool of worker threads.
+		Each search reads an immutable snapshot of a level, so the game can keep changing the level meanwhile.
+		The results are handed to the callbacks of the requests at a sync point on the main thread.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathRequestQueue.h"
+
+// Include PathCache to tell the built-in heuristics apart
+#include "PathCache.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CPathRequestQueue::CPathRequestQueue(void)
+	: m_uiNumActiveSearches(0)
+	, m_bStop(false)
+	, m_uiNextRequestID(1)
+	, m_uiNumRequests(0)
+	, m_uiNumSearches(0)
+	, m_uiNumCancelled(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathRequestQueue::~CPathRequestQueue(void)
+{
+	Destroy();
+}
+
+/**
+ @brief Start the worker threads
+ @param uiNumWorkers A const unsigned int variable containing the number of worker threads
+ */
+void CPathRequestQueue::Init(const unsigned int uiNumWorkers)
+{
+	Destroy();
+
+	m_bStop = false;
+	for (unsigned int i = 0; i < uiNumWorkers; i++)
+		arrWorkers.push_back(std::thread(&CPathRequestQueue::WorkerLoop, this));
+}
+
+/**
+ @brief Stop the worker threads and drop every request which has not been delivered
+ */
+void CPathRequestQueue::Destroy(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+		m_pendingSearches.clear();
+	}
+	m_cvWork.notify_all();
+	for (unsigned int i = 0; i < arrWorkers.size(); i++)
+		arrWorkers[i].join();
+	arrWorkers.clear();
+
+	m_finishedSearches.clear();
+	m_uiNumActiveSearches = 0;
+	arrOpenSearches.clear();
+	mapRequests.clear();
+}
+
+/**
+ @brief Queue a search over a snapshot of a level
+ @param pSnapshot A const std::shared_ptr<const CMapLevel>& variable containing the level snapshot. It must not be changed afterwards
+ @param pLevelID A const void* variable which identifies the level the snapshot was taken from
+ @param uiMapVersion A const unsigned int variable containing the version of the level when the snapshot was taken
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight A const int variable containing the weight of the heuristic
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param eSearchMode A const CPathFinder::SEARCHMODE variable containing the search algorithm
+ @param callback A PathCallback variable containing the function which receives the path
+ */
+unsigned int CPathRequestQueue::Request(const std::shared_ptr<const CMapLevel>& pSnapshot,
+	const void* pLevelID,
+	const unsigned int uiMapVersion,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	HeuristicFunction heuristicFunc,
+	const int weight,
+	const unsigned int uiNrOfDirections,
+	const CPathFinder::SEARCHMODE eSearchMode,
+	PathCallback callback)
+{
+	std::shared_ptr<Search> pSearch = std::make_shared<Search>();
+	pSearch->pSnapshot = pSnapshot;
+	pSearch->pLevelID = pLevelID;
+	pSearch->uiMapVersion = uiMapVersion;
+	pSearch->startPos = startPos;
+	pSearch->targetPos = targetPos;
+	pSearch->heuristicFunc = heuristicFunc;
+	pSearch->weight = weight;
+	pSearch->uiNrOfDirections = uiNrOfDirections;
+	pSearch->eSearchMode = eSearchMode;
+	pSearch->bCancelled = false;
+
+	// Only the built-in heuristics can be told apart, so only their searches are shared
+	pSearch->pHeuristicID = CPathCache::GetHeuristicID(heuristicFunc);
+
+	const unsigned int uiRequestID = m_uiNextRequestID++;
+	if (m_uiNextRequestID == 0)
+		m_uiNextRequestID = 1;
+	m_uiNumRequests++;
+
+	std::shared_ptr<Search> pOpenSearch = FindOpenSearch(*pSearch);
+	if (pOpenSearch)
+	{
+		pSearch = pOpenSearch;
+	}
+	else
+	{
+		m_uiNumSearches++;
+		arrOpenSearches.push_back(pSearch);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingSearches.push_back(pSearch);
+		}
+		m_cvWork.notify_one();
+	}
+
+	pSearch->arrRequestIDs.push_back(uiRequestID);
+	RequestInfo& requestInfo = mapRequests[uiRequestID];
+	requestInfo.pSearch = pSearch;
+	requestInfo.callback = callback;
+
+	return uiRequestID;
+}
+
+/**
+ @brief Queue a request whose path is already known, e.g. from a path cache.
+		Its callback is called at the next sync point, like those of the searched requests
+ @param path A const std::vector<glm::vec2>& variable containing the path
+ @param callback A PathCallback variable containing the function which receives the path
+ */
+unsigned int CPathRequestQueue::Request(const std::vector<glm::vec2>& path, PathCallback callback)
+{
+	std::shared_ptr<Search> pSearch = std::make_shared<Search>();
+	pSearch->bCancelled = false;
+	pSearch->path = path;
+
+	const unsigned int uiRequestID = m_uiNextRequestID++;
+	if (m_uiNextRequestID == 0)
+		m_uiNextRequestID = 1;
+	m_uiNumRequests++;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_finishedSearches.push_back(pSearch);
+	}
+
+	pSearch->arrRequestIDs.push_back(uiRequestID);
+	RequestInfo& requestInfo = mapRequests[uiRequestID];
+	requestInfo.pSearch = pSearch;
+	requestInfo.callback = callback;
+
+	return uiRequestID;
+}
+
+/**
+ @brief Cancel a request
+ @param uiRequestID A const unsigned int variable containing the ID of the request
+ */
+void CPathRequestQueue::Cancel(const unsigned int uiRequestID)
+{
+	std::map<unsigned int, RequestInfo>::iterator it = mapRequests.find(uiRequestID);
+	if (it == mapRequests.end())
+		return;
+
+	std::shared_ptr<Search> pSearch = it->second.pSearch;
+	mapRequests.erase(it);
+	m_uiNumCancelled++;
+
+	std::vector<unsigned int>& arrRequestIDs = pSearch->arrRequestIDs;
+	arrRequestIDs.erase(std::remove(arrRequestIDs.begin(), arrRequestIDs.end(), uiRequestID), arrRequestIDs.end());
+	if (arrRequestIDs.empty())
+	{
+		pSearch->bCancelled = true;
+		CloseSearch(pSearch);
+	}
+}
+
+/**
+ @brief The sync point: wait for the searches queued before this call, then call the callbacks of their requests.
+		Every request made during a frame is delivered at the sync point of the next frame, so the results
+		do not depend on how fast the worker threads were.
+ */
+void CPathRequestQueue::DeliverResults(void)
+{
+	std::vector<std::shared_ptr<Search>> arrFinishedSearches;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (arrWorkers.empty())
+		{
+			// Without worker threads, the searches are run here instead
+			while (!m_pendingSearches.empty())
+			{
+				if (!m_pendingSearches.front()->bCancelled)
+				{
+					RunSearch(cPathFinder, *m_pendingSearches.front());
+					m_finishedSearches.push_back(m_pendingSearches.front());
+				}
+				m_pendingSearches.pop_front();
+			}
+		}
+		else
+			m_cvDone.wait(lock, [this] { return m_pendingSearches.empty() && (m_uiNumActiveSearches == 0); });
+		arrFinishedSearches.swap(m_finishedSearches);
+	}
+
+	for (unsigned int i = 0; i < arrFinishedSearches.size(); i++)
+	{
+		const std::shared_ptr<Search>& pSearch = arrFinishedSearches[i];
+		CloseSearch(pSearch);
+
+		// A callback may cancel or make requests, so look each request up again
+		const std::vector<unsigned int> arrRequestIDs = pSearch->arrRequestIDs;
+		for (unsigned int j = 0; j < arrRequestIDs.size(); j++)
+		{
+			std::map<unsigned int, RequestInfo>::iterator it = mapRequests.find(arrRequestIDs[j]);
+			if (it == mapRequests.end())
+				continue;
+			PathCallback callback = it->second.callback;
+			mapRequests.erase(it);
+			if (callback)
+				callback(arrRequestIDs[j], pSearch->path);
+		}
+	}
+}
+
+/**
+ @brief Get the number of requests queued so far
+ */
+unsigned int CPathRequestQueue::GetNumRequests(void) const
+{
+	return m_uiNumRequests;
+}
+
+/**
+ @brief Get the number of searches queued so far
+ */
+unsigned int CPathRequestQueue::GetNumSearches(void) const
+{
+	return m_uiNumSearches;
+}
+
+/**
+ @brief Get the number of requests cancelled so far
+ */
+unsigned int CPathRequestQueue::GetNumCancelled(void) const
+{
+	return m_uiNumCancelled;
+}
+
+/**
+ @brief Print out details about this class instance in the console window
+ */
+void CPathRequestQueue::PrintSelf(void) const
+{
+	cout << "CPathRequestQueue::PrintSelf()" << endl;
+	cout << "arrWorkers: " << arrWorkers.size() << endl;
+	cout << "m_uiNumRequests: " << m_uiNumRequests << endl;
+	cout << "m_uiNumSearches: " << m_uiNumSearches << endl;
+	cout << "m_uiNumCancelled: " << m_uiNumCancelled << endl;
+}
+
+/**
+ @brief The loop run by each worker thread. Each worker has its own search lists
+ */
+void CPathRequestQueue::WorkerLoop(void)
+{
+	CPathFinder cPathFinder;
+	while (true)
+	{
+		std::shared_ptr<Search> pSearch;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cvWork.wait(lock, [this] { return m_bStop || !m_pendingSearches.empty(); });
+			if (m_bStop)
+				return;
+			pSearch = m_pendingSearches.front();
+			m_pendingSearches.pop_front();
+			m_uiNumActiveSearches++;
+		}
+
+		if (!pSearch->bCancelled)
+			RunSearch(cPathFinder, *pSearch);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_uiNumActiveSearches--;
+			if (!pSearch->bCancelled)
+				m_finishedSearches.push_back(pSearch);
+		}
+		m_cvDone.notify_all();
+	}
+}
+
+/**
+ @brief Run a search on the calling worker thread
+ @param cPathFinder A CPathFinder& variable containing the search lists of the worker
+ @param search A Search& variable containing the search
+ */
+void CPathRequestQueue::RunSearch(CPathFinder& cPathFinder, Search& search)
+{
+	cPathFinder.SetDiagonalMovement(search.uiNrOfDirections == 8);
+	cPathFinder.SetSearchMode(search.eSearchMode);
+	search.path = cPathFinder.PathFind(*search.pSnapshot, search.startPos, search.targetPos, search.heuristicFunc, search.weight);
+}
+
+/**
+ @brief Find an open search with the same snapshot, positions and settings
+ @param search A const Search& variable containing the search to compare with
+ */
+std::shared_ptr<CPathRequestQueue::Search> CPathRequestQueue::FindOpenSearch(const Search& search) const
+{
+	if (search.pHeuristicID == NULL)
+		return std::shared_ptr<Search>();
+
+	for (unsigned int i = 0; i < arrOpenSearches.size(); i++)
+	{
+		const Search& openSearch = *arrOpenSearches[i];
+		if ((openSearch.pLevelID == search.pLevelID) &&
+			(openSearch.uiMapVersion == search.uiMapVersion) &&
+			(openSearch.startPos == search.startPos) &&
+			(openSearch.targetPos == search.targetPos) &&
+			(openSearch.pHeuristicID == search.pHeuristicID) &&
+			(openSearch.weight == search.weight) &&
+			(openSearch.uiNrOfDirections == search.uiNrOfDirections) &&
+			(openSearch.eSearchMode == search.eSearchMode))
+			return arrOpenSearches[i];
+	}
+	return std::shared_ptr<Search>();
+}
+
+/**
+ @brief Take a search out of arrOpenSearches, so that no more requests share it
+ @param pSearch A const std::shared_ptr<Search>& variable containing the search
+ */
+void CPathRequestQueue::CloseSearch(const std::shared_ptr<Search>& pSearch)
+{
+	arrOpenSearches.erase(std::remove(arrOpenSearches.begin(), arrOpenSearches.end(), pSearch), arrOpenSearches.end());
+}
@@ -0,0 +1,142 @@
+/**
+ CPathRequestQueue
+ @brief A class which runs path finding requests on a pool of worker threads.
+		Each search reads an immutable snapshot of a level, so the game can keep changing the level meanwhile.
+		The results are handed to the callbacks of the requests at a sync point on the main thread.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include PathFinder for the searches
+#include "PathFinder.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The function which receives the path of a request. It is called on the main thread
+using PathCallback = std::function<void(const unsigned int uiRequestID, const std::vector<glm::vec2>& path)>;
+
+class CPathRequestQueue
+{
+public:
+	// Constructor
+	CPathRequestQueue(void);
+
+	// Destructor
+	~CPathRequestQueue(void);
+
+	// Start the worker threads. Without any, the searches are run by DeliverResults() on the main thread
+	void Init(const unsigned int uiNumWorkers);
+	// Stop the worker threads and drop every request which has not been delivered
+	void Destroy(void);
+
+	// Queue a search over a snapshot of a level, and return the ID of this request.
+	// pLevelID and uiMapVersion identify the snapshot. A request with the same snapshot, positions and settings
+	// as a search which has not been delivered yet shares the result of that search instead of queueing another one
+	unsigned int Request(const std::shared_ptr<const CMapLevel>& pSnapshot,
+						const void* pLevelID,
+						const unsigned int uiMapVersion,
+						const glm::vec2& startPos,
+						const glm::vec2& targetPos,
+						HeuristicFunction heuristicFunc,
+						const int weight,
+						const unsigned int uiNrOfDirections,
+						const CPathFinder::SEARCHMODE eSearchMode,
+						PathCallback callback);
+
+	// Queue a request whose path is already known, and return the ID of this request
+	unsigned int Request(const std::vector<glm::vec2>& path, PathCallback callback);
+
+	// Cancel a request, so that its callback is not called. The search is skipped if no other request shares it
+	void Cancel(const unsigned int uiRequestID);
+
+	// The sync point: wait for the searches queued before this call, then call the callbacks of their requests
+	void DeliverResults(void);
+
+	// Get the number of requests and searches queued so far. Requests which shared a search are not searched again
+	unsigned int GetNumRequests(void) const;
+	unsigned int GetNumSearches(void) const;
+	// Get the number of requests cancelled so far
+	unsigned int GetNumCancelled(void) const;
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// A search, and the requests waiting for its result
+	struct Search
+	{
+		// The level snapshot and what identifies it
+		std::shared_ptr<const CMapLevel> pSnapshot;
+		const void* pLevelID;
+		unsigned int uiMapVersion;
+
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+		HeuristicFunction heuristicFunc;
+		// The built-in heuristic function wrapped by heuristicFunc, or NULL if it cannot be compared with others
+		const void* pHeuristicID;
+		int weight;
+		unsigned int uiNrOfDirections;
+		CPathFinder::SEARCHMODE eSearchMode;
+
+		// The requests waiting for this search. Only used by the main thread
+		std::vector<unsigned int> arrRequestIDs;
+		// Set when every request was cancelled, so the workers can skip the search
+		std::atomic<bool> bCancelled;
+
+		// The result, written by a worker thread
+		std::vector<glm::vec2> path;
+	};
+
+	// A request, and the search which answers it. Only used by the main thread
+	struct RequestInfo
+	{
+		std::shared_ptr<Search> pSearch;
+		PathCallback callback;
+	};
+
+	// The worker threads
+	std::vector<std::thread> arrWorkers;
+	// The search lists used at the sync point when there are no worker threads
+	CPathFinder cPathFinder;
+
+	// Guards m_pendingSearches, m_finishedSearches, m_uiNumActiveSearches and m_bStop
+	std::mutex m_mutex;
+	// Wakes the workers when a search is queued
+	std::condition_variable m_cvWork;
+	// Wakes the main thread when a search has finished
+	std::condition_variable m_cvDone;
+	std::deque<std::shared_ptr<Search>> m_pendingSearches;
+	std::vector<std::shared_ptr<Search>> m_finishedSearches;
+	unsigned int m_uiNumActiveSearches;
+	bool m_bStop;
+
+	// The searches which have not been delivered yet, for sharing them between requests. Only used by the main thread
+	std::vector<std::shared_ptr<Search>> arrOpenSearches;
+	// The requests which have not been delivered or cancelled yet. Only used by the main thread
+	std::map<unsigned int, RequestInfo> mapRequests;
+	unsigned int m_uiNextRequestID;
+
+	// Counters
+	unsigned int m_uiNumRequests;
+	unsigned int m_uiNumSearches;
+	unsigned int m_uiNumCancelled;
+
+	// The loop run by each worker thread
+	void WorkerLoop(void);
+	// Run a search on the calling worker thread
+	static void RunSearch(CPathFinder& cPathFinder, Search& search);
+	// Find an open search with the same snapshot, positions and settings, or return NULL
+	std::shared_ptr<Search> FindOpenSearch(const Search& search) const;
+	// Take a search out of arrOpenSearches
+	void CloseSearch(const std::shared_ptr<Search>& pSearch);
+};
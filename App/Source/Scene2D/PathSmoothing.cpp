@@ -0,0 +1,86 @@
+/**
+ PathSmoothing
+ @brief Functions which shrink the tile by tile paths found by CPathFinder into short lists of turn points
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathSmoothing.h"
+
+/**
+ @brief Keep only the tiles where the path changes direction, and the target
+ @param startPos A const glm::vec2& variable containing the position the path starts from
+ @param path A std::vector<glm::vec2>& variable containing the path, which is shrunk in place
+ */
+void pathsmoothing::CollapseCollinear(const glm::vec2& startPos, std::vector<glm::vec2>& path)
+{
+	if (path.size() < 2)
+		return;
+
+	const unsigned int uiNumTiles = (unsigned int)path.size();
+	glm::vec2 previous = startPos;
+	unsigned int uiNumKept = 0;
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+	{
+		// A tile in the middle of a straight run is reached by walking on from the tile before it
+		const glm::vec2 current = path[i];
+		const bool bTurn = (i == uiNumTiles - 1) || ((path[i + 1] - current) != (current - previous));
+		if (bTurn)
+			path[uiNumKept++] = current;
+		previous = current;
+	}
+	path.resize(uiNumKept);
+}
+
+/**
+ @brief Keep only the tiles which cannot be skipped with a clear line of sight from the tile kept before them.
+		Each kept tile is the furthest one along the path which is still in sight of the kept tile before it
+ @param startPos A const glm::vec2& variable containing the position the path starts from
+ @param path A std::vector<glm::vec2>& variable containing the path, which is shrunk in place
+ @param cLineOfSight A const CLineOfSight& variable containing the blocking tiles of the level
+ */
+void pathsmoothing::StringPull(const glm::vec2& startPos, std::vector<glm::vec2>& path, const CLineOfSight& cLineOfSight)
+{
+	if (path.size() < 2)
+		return;
+
+	const unsigned int uiNumTiles = (unsigned int)path.size();
+	glm::vec2 anchor = startPos;
+	unsigned int uiNumKept = 0;
+	unsigned int i = 0;
+	while (i < uiNumTiles)
+	{
+		// The next tile of the path can always be skipped to, even where the path finder
+		// took a diagonal step between 2 blocking tiles which the line of sight does not pass
+		unsigned int uiFurthest = i;
+		while ((uiFurthest + 1 < uiNumTiles) &&
+			cLineOfSight.CastRay((int)anchor.x, (int)anchor.y, (int)path[uiFurthest + 1].x, (int)path[uiFurthest + 1].y))
+			uiFurthest++;
+
+		anchor = path[uiFurthest];
+		path[uiNumKept++] = anchor;
+		i = uiFurthest + 1;
+	}
+	path.resize(uiNumKept);
+}
+
+/**
+ @brief Apply a smoothing mode to a path
+ @param eMode A const SMOOTHINGMODE variable containing the smoothing to apply
+ @param startPos A const glm::vec2& variable containing the position the path starts from
+ @param path A std::vector<glm::vec2>& variable containing the path, which is shrunk in place
+ @param cLineOfSight A const CLineOfSight& variable containing the blocking tiles of the level
+ */
+void pathsmoothing::Smooth(const SMOOTHINGMODE eMode, const glm::vec2& startPos, std::vector<glm::vec2>& path, const CLineOfSight& cLineOfSight)
+{
+	switch (eMode)
+	{
+	case TURNPOINTS:
+		CollapseCollinear(startPos, path);
+		break;
+	case STRINGPULL:
+		StringPull(startPos, path, cLineOfSight);
+		break;
+	default:
+		break;
+	}
+}
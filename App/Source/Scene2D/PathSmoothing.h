@@ -0,0 +1,37 @@
+/**
+ PathSmoothing
+ @brief Functions which shrink the tile by tile paths found by CPathFinder into short lists of turn points
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include LineOfSight for the straight lines between turn points
+#include "LineOfSight.h"
+
+#include <vector>
+
+namespace pathsmoothing
+{
+	// The smoothing applied to a path
+	enum SMOOTHINGMODE
+	{
+		NONE = 0,		// Every tile of the path
+		TURNPOINTS,		// Only the tiles where the path changes direction, for agents which walk tile by tile
+		STRINGPULL,		// Only the tiles where a straight line from the last kept tile would cross a blocking tile
+		NUM_SMOOTHINGMODES
+	};
+
+	// Keep only the tiles where the path changes direction, and the target.
+	// The path does not include startPos, like the paths of CPathFinder
+	void CollapseCollinear(const glm::vec2& startPos, std::vector<glm::vec2>& path);
+
+	// Keep only the tiles which cannot be skipped with a clear line of sight from the tile kept before them, and the target
+	void StringPull(const glm::vec2& startPos, std::vector<glm::vec2>& path, const CLineOfSight& cLineOfSight);
+
+	// Apply a smoothing mode to a path. cLineOfSight is only used by STRINGPULL
+	void Smooth(const SMOOTHINGMODE eMode, const glm::vec2& startPos, std::vector<glm::vec2>& path, const CLineOfSight& cLineOfSight);
+}
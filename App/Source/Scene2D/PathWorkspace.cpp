@@ -0,0 +1,424 @@
+/**
+ CPathWorkspace
+ @brief A class which holds the search lists for answering a batch of path queries, so that each caller
+		can own one and run its batches without sharing the lists of CMap2D's CPathFinder.
+		The paths are written into a CPathArena, which is reused from batch to batch.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathWorkspace.h"
+
+// Include PathFinder for the heuristics
+#include "PathFinder.h"
+
+#include <algorithm>
+
+/**
+ @brief Constructor
+ */
+CPathArena::CPathArena(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathArena::~CPathArena(void)
+{
+}
+
+/**
+ @brief Remove every path, keeping the memory for the next batch
+ */
+void CPathArena::Clear(void)
+{
+	arrWaypoints.clear();
+	arrSpans.clear();
+}
+
+/**
+ @brief Get the number of paths
+ */
+unsigned int CPathArena::GetNumPaths(void) const
+{
+	return (unsigned int)arrSpans.size();
+}
+
+/**
+ @brief Get where the path of a query is stored
+ @param uiQuery A const unsigned int variable containing the index of the query in its batch
+ */
+const PathSpan& CPathArena::GetSpan(const unsigned int uiQuery) const
+{
+	return arrSpans[uiQuery];
+}
+
+/**
+ @brief Get the first waypoint of the path of a query
+ @param uiQuery A const unsigned int variable containing the index of the query in its batch
+ */
+const glm::vec2* CPathArena::GetPath(const unsigned int uiQuery) const
+{
+	return arrWaypoints.data() + arrSpans[uiQuery].uiOffset;
+}
+
+/**
+ @brief Get the number of waypoints in the path of a query
+ @param uiQuery A const unsigned int variable containing the index of the query in its batch
+ */
+unsigned int CPathArena::GetPathLength(const unsigned int uiQuery) const
+{
+	return arrSpans[uiQuery].uiLength;
+}
+
+/**
+ @brief Constructor
+ */
+CPathWorkspace::CPathWorkspace(void)
+	: uiNrOfDirections(4)
+	, m_uiGeneration(0)
+	, m_uiNumSearches(0)
+	, m_uiNumSharedSearches(0)
+	, m_uiNumNodesExpanded(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CPathWorkspace::~CPathWorkspace(void)
+{
+}
+
+/**
+ @brief Find the paths of a batch of queries
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param pQueries A const PathQuery* variable containing the queries
+ @param uiNumQueries A const unsigned int variable containing the number of queries
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param cArena A CPathArena& variable which will store the paths, in the order of the queries
+ @param pReachabilityIndex A CReachabilityIndex* variable containing the connected regions of cLevel, or NULL
+ */
+void CPathWorkspace::PathFindBatch(const CMapLevel& cLevel,
+	const PathQuery* pQueries,
+	const unsigned int uiNumQueries,
+	const unsigned int uiNrOfDirections,
+	CPathArena& cArena,
+	CReachabilityIndex* pReachabilityIndex)
+{
+	this->uiNrOfDirections = uiNrOfDirections;
+	m_uiNumSearches = 0;
+	m_uiNumSharedSearches = 0;
+	m_uiNumNodesExpanded = 0;
+
+	// Make sure that the lists are big enough for this level
+	if ((cLevel.GetNumRows() != sMapSize.uiRowSize) || (cLevel.GetNumCols() != sMapSize.uiColSize))
+	{
+		sMapSize.uiRowSize = cLevel.GetNumRows();
+		sMapSize.uiColSize = cLevel.GetNumCols();
+
+		Node node;
+		node.uiGeneration = 0;
+		node.g = 0;
+		node.iParent = -1;
+		node.bClosed = false;
+		node.bWanted = false;
+		m_nodes.assign(sMapSize.uiRowSize * sMapSize.uiColSize, node);
+		m_openList.Init(sMapSize.uiRowSize * sMapSize.uiColSize);
+		m_uiGeneration = 0;
+	}
+
+	cArena.Clear();
+	PathSpan emptySpan;
+	emptySpan.uiOffset = 0;
+	emptySpan.uiLength = 0;
+	cArena.arrSpans.assign(uiNumQueries, emptySpan);
+
+	// Leave out the queries which have no path, and order the others by their targets
+	arrOrder.clear();
+	for (unsigned int i = 0; i < uiNumQueries; i++)
+	{
+		const int iStart = ConvertTo1D(pQueries[i].startPos);
+		const int iTarget = ConvertTo1D(pQueries[i].targetPos);
+		if ((iStart < 0) || (iTarget < 0) || (iStart == iTarget))
+			continue;
+		if (cLevel.IsBlocked((unsigned int)pQueries[i].startPos.y, (unsigned int)pQueries[i].startPos.x) ||
+			cLevel.IsBlocked((unsigned int)pQueries[i].targetPos.y, (unsigned int)pQueries[i].targetPos.x))
+			continue;
+		if (pReachabilityIndex && !pReachabilityIndex->IsConnected(pQueries[i].startPos, pQueries[i].targetPos))
+			continue;
+		arrOrder.push_back(i);
+	}
+	std::sort(arrOrder.begin(), arrOrder.end(),
+		[this, pQueries](const unsigned int a, const unsigned int b)
+		{
+			return ConvertTo1D(pQueries[a].targetPos) < ConvertTo1D(pQueries[b].targetPos);
+		});
+
+	for (unsigned int uiFirst = 0; uiFirst < arrOrder.size();)
+	{
+		const int iTarget = ConvertTo1D(pQueries[arrOrder[uiFirst]].targetPos);
+		unsigned int uiLast = uiFirst + 1;
+		while ((uiLast < arrOrder.size()) && (ConvertTo1D(pQueries[arrOrder[uiLast]].targetPos) == iTarget))
+			uiLast++;
+
+		m_uiNumSearches++;
+		if (uiLast - uiFirst == 1)
+		{
+			SearchForward(cLevel, ConvertTo1D(pQueries[arrOrder[uiFirst]].startPos), iTarget,
+						cArena.arrSpans[arrOrder[uiFirst]], cArena);
+		}
+		else
+		{
+			m_uiNumSharedSearches++;
+			SearchBackward(cLevel, pQueries, uiFirst, uiLast, cArena);
+		}
+		uiFirst = uiLast;
+	}
+}
+
+/**
+ @brief Get the number of searches run by the last batch
+ */
+unsigned int CPathWorkspace::GetNumSearches(void) const
+{
+	return m_uiNumSearches;
+}
+
+/**
+ @brief Get the number of searches run backwards from a shared target by the last batch
+ */
+unsigned int CPathWorkspace::GetNumSharedSearches(void) const
+{
+	return m_uiNumSharedSearches;
+}
+
+/**
+ @brief Get the number of nodes expanded by the last batch
+ */
+unsigned int CPathWorkspace::GetNumNodesExpanded(void) const
+{
+	return m_uiNumNodesExpanded;
+}
+
+/**
+ @brief Start a new search, invalidating the data of every node
+ */
+void CPathWorkspace::NewSearch(void)
+{
+	m_openList.Clear();
+	m_uiGeneration++;
+	// If the generation counter wrapped around, then the old stamps could match again
+	if (m_uiGeneration == 0)
+	{
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			m_nodes[i].uiGeneration = 0;
+		m_uiGeneration = 1;
+	}
+}
+
+/**
+ @brief Get a node, resetting it if it was last touched by an older search
+ @param iNode A const int variable containing the 1D index of the node
+ */
+CPathWorkspace::Node& CPathWorkspace::GetNode(const int iNode)
+{
+	Node& node = m_nodes[iNode];
+	if (node.uiGeneration != m_uiGeneration)
+	{
+		node.uiGeneration = m_uiGeneration;
+		node.g = 0;
+		node.iParent = -1;
+		node.bClosed = false;
+		node.bWanted = false;
+	}
+	return node;
+}
+
+/**
+ @brief Find the path of one query with A*, and store it in cArena
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param iStart A const int variable containing the 1D index of the start
+ @param iTarget A const int variable containing the 1D index of the target
+ @param span A PathSpan& variable which will store where the path is
+ @param cArena A CPathArena& variable which will store the path
+ */
+void CPathWorkspace::SearchForward(const CMapLevel& cLevel, const int iStart, const int iTarget, PathSpan& span, CPathArena& cArena)
+{
+	NewSearch();
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iTargetX = iTarget % iNumCols;
+	const int iTargetY = iTarget / iNumCols;
+	const heuristic::Manhattan manhattan;
+	const heuristic::Octile octile;
+
+	Node& startNode = GetNode(iStart);
+	startNode.iParent = iStart;
+	m_openList.Push(iStart, 0);
+
+	bool bFound = false;
+	while (!m_openList.Empty())
+	{
+		// Get the node with the least f value
+		const int iCurrent = m_openList.Top();
+		if (iCurrent == iTarget)
+		{
+			bFound = true;
+			break;
+		}
+
+		m_openList.Pop();
+		Node& currentNode = m_nodes[iCurrent];
+		currentNode.bClosed = true;
+		m_uiNumNodesExpanded++;
+
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		const unsigned int gNew = currentNode.g + 1;
+		for (unsigned int i = 0; i < uiNrOfDirections; ++i)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+				continue;
+
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			const bool bSeen = m_nodes[iNeighbor].uiGeneration == m_uiGeneration;
+			Node& neighborNode = GetNode(iNeighbor);
+			if (neighborNode.bClosed)
+				continue;
+
+			// Only update the neighbor if it is new or this path to it is shorter
+			if (!bSeen || gNew < neighborNode.g)
+			{
+				neighborNode.g = gNew;
+				neighborNode.iParent = iCurrent;
+				const unsigned int h = (uiNrOfDirections == 8) ? octile(iNeighborX, iNeighborY, iTargetX, iTargetY, 1)
+																: manhattan(iNeighborX, iNeighborY, iTargetX, iTargetY, 1);
+				m_openList.Push(iNeighbor, gNew + h);
+			}
+		}
+	}
+	m_openList.Clear();
+	if (!bFound)
+		return;
+
+	// Store the path from the target back to the start, then turn it around
+	span.uiOffset = (unsigned int)cArena.arrWaypoints.size();
+	for (int iCurrent = iTarget; iCurrent != iStart; iCurrent = m_nodes[iCurrent].iParent)
+		cArena.arrWaypoints.push_back(glm::vec2(iCurrent % iNumCols, iCurrent / iNumCols));
+	span.uiLength = (unsigned int)cArena.arrWaypoints.size() - span.uiOffset;
+	std::reverse(cArena.arrWaypoints.begin() + span.uiOffset, cArena.arrWaypoints.end());
+	CheckSingleStep(iStart, iTarget, iNumCols, span);
+}
+
+/**
+ @brief Search backwards from a shared target with a breadth-first search, until the starts of its queries are reached.
+		Every step costs the same and can be taken both ways, so the parent of each tile is its next step towards the target
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param pQueries A const PathQuery* variable containing the queries
+ @param uiFirst A const unsigned int variable containing the first query in arrOrder with this target
+ @param uiLast A const unsigned int variable containing the query in arrOrder after the last one with this target
+ @param cArena A CPathArena& variable which will store the paths
+ */
+void CPathWorkspace::SearchBackward(const CMapLevel& cLevel,
+	const PathQuery* pQueries,
+	const unsigned int uiFirst,
+	const unsigned int uiLast,
+	CPathArena& cArena)
+{
+	NewSearch();
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iTarget = ConvertTo1D(pQueries[arrOrder[uiFirst]].targetPos);
+
+	// Mark the starts, so the search can stop once it has reached all of them
+	unsigned int uiNumWanted = 0;
+	for (unsigned int i = uiFirst; i < uiLast; i++)
+	{
+		Node& startNode = GetNode(ConvertTo1D(pQueries[arrOrder[i]].startPos));
+		if (!startNode.bWanted)
+		{
+			startNode.bWanted = true;
+			uiNumWanted++;
+		}
+	}
+
+	arrQueue.clear();
+	arrQueue.push_back(iTarget);
+	Node& targetNode = GetNode(iTarget);
+	targetNode.iParent = iTarget;
+	targetNode.bClosed = true;
+	for (unsigned int uiHead = 0; (uiHead < arrQueue.size()) && (uiNumWanted > 0); uiHead++)
+	{
+		const int iCurrent = arrQueue[uiHead];
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		m_uiNumNodesExpanded++;
+		for (unsigned int i = 0; i < uiNrOfDirections; ++i)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+				continue;
+
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			Node& neighborNode = GetNode(iNeighbor);
+			if (neighborNode.bClosed)
+				continue;
+			neighborNode.bClosed = true;
+			neighborNode.iParent = iCurrent;
+			arrQueue.push_back(iNeighbor);
+			if (neighborNode.bWanted)
+				uiNumWanted--;
+		}
+	}
+
+	// Follow the parents from each start, which gives the path in the order it is walked
+	for (unsigned int i = uiFirst; i < uiLast; i++)
+	{
+		const int iStart = ConvertTo1D(pQueries[arrOrder[i]].startPos);
+		if (!m_nodes[iStart].bClosed)
+			continue;
+
+		PathSpan& span = cArena.arrSpans[arrOrder[i]];
+		span.uiOffset = (unsigned int)cArena.arrWaypoints.size();
+		for (int iCurrent = m_nodes[iStart].iParent; ; iCurrent = m_nodes[iCurrent].iParent)
+		{
+			cArena.arrWaypoints.push_back(glm::vec2(iCurrent % iNumCols, iCurrent / iNumCols));
+			if (iCurrent == iTarget)
+				break;
+		}
+		span.uiLength = (unsigned int)cArena.arrWaypoints.size() - span.uiOffset;
+		CheckSingleStep(iStart, iTarget, iNumCols, span);
+	}
+}
+
+/**
+ @brief Keep the shape of the paths of CPathFinder::PathFind.
+		If the path has only 1 entry, then it is the the target position. This is only OK if the start is next to the target
+ @param iStart A const int variable containing the 1D index of the start
+ @param iTarget A const int variable containing the 1D index of the target
+ @param iNumCols A const int variable containing the number of columns of the level
+ @param span A PathSpan& variable containing where the path is
+ */
+void CPathWorkspace::CheckSingleStep(const int iStart, const int iTarget, const int iNumCols, PathSpan& span)
+{
+	if ((span.uiLength == 1) &&
+		(std::abs(iTarget % iNumCols - iStart % iNumCols) + std::abs(iTarget / iNumCols - iStart / iNumCols) > 1))
+		span.uiLength = 0;
+}
+
+/**
+ @brief Convert a position to a 1D index
+ @param pos A const glm::vec2& variable containing the position
+ */
+int CPathWorkspace::ConvertTo1D(const glm::vec2& pos) const
+{
+	if ((pos.x < 0) || (pos.x >= sMapSize.uiColSize) || (pos.y < 0) || (pos.y >= sMapSize.uiRowSize))
+		return -1;
+	return (int)pos.y * (int)sMapSize.uiColSize + (int)pos.x;
+}
@@ -0,0 +1,138 @@
+/**
+ CPathWorkspace
+ @brief A class which holds the search lists for answering a batch of path queries, so that each caller
+		can own one and run its batches without sharing the lists of CMap2D's CPathFinder.
+		The paths are written into a CPathArena, which is reused from batch to batch.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include IndexedHeap for the open list
+#include "IndexedHeap.h"
+// Include JumpTable for the directions and the free tile check
+#include "JumpTable.h"
+// Include ReachabilityIndex for skipping the queries which cannot be answered
+#include "ReachabilityIndex.h"
+
+#include <vector>
+
+// A path query. Positions are (column, inverted row)
+struct PathQuery
+{
+	glm::vec2 startPos;
+	glm::vec2 targetPos;
+};
+
+// Where the path of a query is stored in a CPathArena
+struct PathSpan
+{
+	unsigned int uiOffset;
+	unsigned int uiLength;
+};
+
+class CPathArena
+{
+	friend class CPathWorkspace;
+public:
+	// Constructor
+	CPathArena(void);
+
+	// Destructor
+	~CPathArena(void);
+
+	// Remove every path, keeping the memory for the next batch
+	void Clear(void);
+
+	// Get the number of paths
+	unsigned int GetNumPaths(void) const;
+	// Get where the path of a query is stored
+	const PathSpan& GetSpan(const unsigned int uiQuery) const;
+	// Get the first waypoint of the path of a query. It has the same shape as the paths of CPathFinder::PathFind
+	const glm::vec2* GetPath(const unsigned int uiQuery) const;
+	// Get the number of waypoints in the path of a query
+	unsigned int GetPathLength(const unsigned int uiQuery) const;
+
+protected:
+	// The waypoints of every path, one after another
+	std::vector<glm::vec2> arrWaypoints;
+	// The waypoints of each query
+	std::vector<PathSpan> arrSpans;
+};
+
+class CPathWorkspace
+{
+public:
+	// Constructor
+	CPathWorkspace(void);
+
+	// Destructor
+	~CPathWorkspace(void);
+
+	// Find the paths of uiNumQueries queries in cLevel, moving in 4 or 8 directions, and store them in cArena.
+	// Queries which share a target are answered by one search backwards from the target.
+	// If pReachabilityIndex is not NULL, then it must be up to date, and no search is run for a target which cannot be reached
+	void PathFindBatch(const CMapLevel& cLevel,
+						const PathQuery* pQueries,
+						const unsigned int uiNumQueries,
+						const unsigned int uiNrOfDirections,
+						CPathArena& cArena,
+						CReachabilityIndex* pReachabilityIndex = NULL);
+
+	// Get the number of searches run by the last batch, and how many of them were backwards from a shared target
+	unsigned int GetNumSearches(void) const;
+	unsigned int GetNumSharedSearches(void) const;
+	// Get the number of nodes expanded by the last batch
+	unsigned int GetNumNodesExpanded(void) const;
+
+protected:
+	// The search data of a map grid. A node only holds valid data if its
+	// uiGeneration matches m_uiGeneration, so a new search resets every node in O(1)
+	struct Node
+	{
+		unsigned int uiGeneration;
+		unsigned int g;
+		int iParent;
+		bool bClosed;
+		// Set on the start tiles which a backward search is looking for
+		bool bWanted;
+	};
+
+	// The size of the level being searched
+	MapSize sMapSize;
+	unsigned int uiNrOfDirections;
+
+	// Lists for the searches
+	CIndexedHeap<unsigned int> m_openList;
+	std::vector<Node> m_nodes;
+	unsigned int m_uiGeneration;
+	std::vector<int> arrQueue;
+	// The queries, ordered by their targets
+	std::vector<unsigned int> arrOrder;
+
+	// Counters
+	unsigned int m_uiNumSearches;
+	unsigned int m_uiNumSharedSearches;
+	unsigned int m_uiNumNodesExpanded;
+
+	// Make the lists big enough for a level, and start a new search
+	void NewSearch(void);
+	// Get a node, resetting it if it was last touched by an older search
+	Node& GetNode(const int iNode);
+	// Find the path of one query with A*, and store it in cArena
+	void SearchForward(const CMapLevel& cLevel, const int iStart, const int iTarget, PathSpan& span, CPathArena& cArena);
+	// Search backwards from a target until the starts of the queries arrOrder[uiFirst] to arrOrder[uiLast - 1] are reached,
+	// and store their paths in cArena
+	void SearchBackward(const CMapLevel& cLevel,
+						const PathQuery* pQueries,
+						const unsigned int uiFirst,
+						const unsigned int uiLast,
+						CPathArena& cArena);
+	// Keep the shape of the paths of CPathFinder::PathFind, which only has 1 entry if the target is next to the start
+	static void CheckSingleStep(const int iStart, const int iTarget, const int iNumCols, PathSpan& span);
+	// Convert a position to a 1D index, or -1 if it is outside the level
+	int ConvertTo1D(const glm::vec2& pos) const;
+};
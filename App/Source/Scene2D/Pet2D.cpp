@@ -103,11 +103,11 @@ bool CPet2D::Init(void)
 	// Find the indices for the player in arrMapInfo, and assign it to cPlayer2D
 	unsigned int uiRow = -1;
 	unsigned int uiCol = -1; 
-	if (cMap2D->FindValue(400, uiRow, uiCol) == false)
+	if (cMap2D->FindValue(tiletype::PET_SPAWN, uiRow, uiCol) == false)
 		return false;	// Unable to find the start position of the player, so quit this game
 
 	// Erase the value of the player in the arrMapInfo
-	cMap2D->SetMapInfo(uiRow, uiCol, 0);
+	cMap2D->SetMapInfo(uiRow, uiCol, tiletype::EMPTY);
 
 	// Set the start position of the Player to iRow and iCol
 	vec2Index = glm::vec2(uiCol, uiRow);
@@ -159,11 +159,8 @@ void CPet2D::Update(const double dElapsedTime)
 		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f)
 		{
 			cout << "Calculating pet path..." << endl;
-			//Calculate a path to the player
-			path = cMap2D->PathFind(vec2Index,
-				playerLast,
-				heuristic::manhattan,
-				10);
+			// Prepare the flow field towards the player for FOLLOW
+			cMap2D->GetFlowField(playerLast);
 			sCurrentFSM = FOLLOW;
 		}
 
@@ -190,34 +187,8 @@ void CPet2D::Update(const double dElapsedTime)
 
 		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 8.0f)
 		{
-			path = cMap2D->PathFind(vec2Index,
-				playerLast,
-				heuristic::euclidean,
-				10);
-
-			// Calculate new destination
-			bool bFirstPosition = true;
-			for (const auto& coord : path)
-			{
-				if (vec2Index != playerLast)
-				{
-					// Set a destination
-					i32vec2Destination = coord;
-					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
-				}
-				else
-				{
-					if ((coord - i32vec2Destination) == i32vec2Direction)
-					{
-						// Set a destination
-						i32vec2Destination = coord;
-					}
-					else
-						break;
-				}
-			}
-			 
+			// Follow the flow field towards where the whistle was blown
+			cMap2D->GetFlowField(playerLast).GetDestination(vec2Index, i32vec2Destination, i32vec2Direction);
 
 			// Update the Enemy2D's position for attack
 			UpdatePosition();
@@ -348,11 +319,8 @@ void CPet2D::HiHzWhistle()
 	if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f)
 	{
 		cout << "Calculating pet path..." << endl;
-		//Calculate a path to the player
-		path = cMap2D->PathFind(vec2Index,
-			playerLast,
-			heuristic::manhattan,
-			10);
+		// Prepare the flow field towards the player for FOLLOW
+		cMap2D->GetFlowField(playerLast);
 		sCurrentFSM = FOLLOW;
 	}
 }
@@ -414,7 +382,7 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -423,8 +391,8 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) == 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -443,7 +411,7 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) == 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -452,8 +420,8 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) == 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) == 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -473,7 +441,7 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -482,8 +450,8 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -495,7 +463,7 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -504,8 +472,8 @@ bool CPet2D::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -526,9 +494,9 @@ void CPet2D::InteractWithMap(void)
 {
 	glm::vec2 i32vec2PlayerPos = cPlayer2D->vec2Index;
 
-	switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x))
+	switch (tiletype::GetHandler(cMap2D->GetMapItem(vec2Index.y, vec2Index.x)))
 	{
-	case 99:
+	case tiletype::HANDLER_WIN:
 		//Player loses the game
 		CGameManager::GetInstance()->bPlayerWon = true;
 		if (cSettings->MuteAudio == false)
@@ -163,9 +163,6 @@ protected:
 	// Max count in a state
 	const int iMaxFSMCounter = 120;
 
-	// Current generated A* pathfinding route
-	vector<glm::vec2> path;
-
 	// Constraint the enemy2D's position within a boundary
 	void Constraint(DIRECTION eDirection = LEFT);
 
@@ -82,11 +82,11 @@ bool CPlayer2D::Init(void)
 	// Find the indices for the player in arrMapInfo, and assign it to cPlayer2D
 	unsigned int uiRow = -1;
 	unsigned int uiCol = -1;
-	if (cMap2D->FindValue(200, uiRow, uiCol) == false)
+	if (cMap2D->FindValue(tiletype::PLAYER_SPAWN, uiRow, uiCol) == false)
 		return false;	// Unable to find the start position of the player, so quit this game
 
 	// Erase the value of the player in the arrMapInfo
-	cMap2D->SetMapInfo(uiRow, uiCol, 0);
+	cMap2D->SetMapInfo(uiRow, uiCol, tiletype::EMPTY);
 
 	// Set the start position of the Player to iRow and iCol
 	vec2Index = glm::i32vec2(uiCol, uiRow);
@@ -154,11 +154,11 @@ bool CPlayer2D::Reset()
 {
 	unsigned int uiRow = -1;
 	unsigned int uiCol = -1;
-	if (cMap2D->FindValue(200, uiRow, uiCol) == false)
+	if (cMap2D->FindValue(tiletype::PLAYER_SPAWN, uiRow, uiCol) == false)
 		return false;	// Unable to find the start position of the player, so quit this game
 
 	// Erase the value of the player in the arrMapInfo
-	cMap2D->SetMapInfo(uiRow, uiCol, 0);
+	cMap2D->SetMapInfo(uiRow, uiCol, tiletype::EMPTY);
 
 	// Set the start position of the Player to iRow and iCol
 	vec2Index = glm::i32vec2(uiCol, uiRow);
@@ -348,9 +348,9 @@ void CPlayer2D::Update(const double dElapsedTime)
 		if (flareCollected)
 		{
 			cInventoryItem = cInventoryManager->GetItem("Item");
-			if (cInventoryItem->GetCount() > 0 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == 0)
+			if (cInventoryItem->GetCount() > 0 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == tiletype::EMPTY)
 			{
-				cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 3);
+				cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::FLARE_DROPPED);
 				flareIndex = vec2Index;
 				cInventoryItem->Remove(1);
 				itemCollected = false;
@@ -364,9 +364,9 @@ void CPlayer2D::Update(const double dElapsedTime)
 		if (cerealCollected)
 		{
 			cInventoryItem = cInventoryManager->GetItem("Item");
-			if (cInventoryItem->GetCount() > 0 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == 0)
+			if (cInventoryItem->GetCount() > 0 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) == tiletype::EMPTY)
 			{
-				cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 5);
+				cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::CEREAL_DROPPED);
 				cInventoryItem->Remove(1);
 				itemCollected = false;
 				cerealCollected = false;
@@ -514,7 +514,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -523,8 +523,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -543,7 +543,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -552,8 +552,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -573,7 +573,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -582,8 +582,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -595,7 +595,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -604,8 +604,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->isBlocked(vec2Index.y, vec2Index.x) ||
+				cMap2D->isBlocked(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -647,13 +647,13 @@ void CPlayer2D::UpdateHealthLives(void)
  */
 void CPlayer2D::InteractWithMap(void)
 {
-	switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x))
+	switch (tiletype::GetHandler(cMap2D->GetMapItem(vec2Index.y, vec2Index.x)))
 	{
-	case 2:
+	case tiletype::HANDLER_PICK_UP_FLARE:
 		if (!itemCollected)
 		{
 			// Erase the flare from this position
-			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 0);
+			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::EMPTY);
 			cInventoryItem = cInventoryManager->GetItem("Item");
 			cInventoryItem->Add(1);
 			flareCollected = true;
@@ -667,11 +667,11 @@ void CPlayer2D::InteractWithMap(void)
 			}
 		}
 		break;
-	case 4:
+	case tiletype::HANDLER_PICK_UP_CEREAL:
 		if (!itemCollected)
 		{
 			// Erase the cereal from this position
-			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 0);
+			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::EMPTY);
 			cInventoryItem = cInventoryManager->GetItem("Item");
 			cInventoryItem->Add(1);
 			cerealCollected = true;
@@ -685,19 +685,19 @@ void CPlayer2D::InteractWithMap(void)
 			}
 		}
 		break;
-	case 10:
+	case tiletype::HANDLER_ADD_LIFE:
 		// Increase the lives by 1
 		cInventoryItem = cInventoryManager->GetItem("Lives");
 		cInventoryItem->Add(1);
 		// Erase the life from this position
-		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 0);
+		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, tiletype::EMPTY);
 		break;
-	case 20:
+	case tiletype::HANDLER_DAMAGE:
 		// Decrease health by 1 (Spikes)
 		cInventoryItem = cInventoryManager->GetItem("Health");
 		cInventoryItem->Remove(1);
 		break;
-	case 21:
+	case tiletype::HANDLER_HEAL:
 		// Increase health by 1 (Spa)
 		cInventoryItem = cInventoryManager->GetItem("Health");
 		cInventoryItem->Add(1);
@@ -0,0 +1,292 @@
+/**
+ CPotentiallyVisibleSet
+ @brief A class which stores, for every free tile of a CMapLevel, the set of tiles which can be seen from it.
+		Each set is a bitset over the smallest rectangle holding its visible tiles, so a check is a single bit test.
+		The sets can be saved to and loaded from a file next to the CSV of the level.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PotentiallyVisibleSet.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace std;
+
+// The first 4 bytes of a visible set file, and the version of its layout
+static const unsigned int uiFileMagic = 0x31535650;	// "PVS1"
+static const unsigned int uiFileVersion = 1;
+
+/**
+ @brief Constructor
+ */
+CPotentiallyVisibleSet::CPotentiallyVisibleSet(void)
+	: bValid(false)
+	, uiMapVersion(0)
+	, uiBlockedHash(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CPotentiallyVisibleSet::~CPotentiallyVisibleSet(void)
+{
+}
+
+/**
+ @brief Build the visible sets of a level. A line of sight is the same in both directions,
+		so a tile checks the tiles before it in its own row of the sets built already, and only casts rays to the rest
+ @param cLevel A const CMapLevel& variable containing the level
+ @param cLineOfSight A const CLineOfSight& variable containing the blocking tiles of cLevel
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ */
+void CPotentiallyVisibleSet::Build(const CMapLevel& cLevel, const CLineOfSight& cLineOfSight, const unsigned int uiMapVersion)
+{
+	sMapSize.uiRowSize = cLevel.GetNumRows();
+	sMapSize.uiColSize = cLevel.GetNumCols();
+	uiBlockedHash = HashBlockedTiles(cLevel);
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const unsigned int uiNumTiles = sMapSize.uiRowSize * sMapSize.uiColSize;
+
+	TileSet emptySet;
+	emptySet.usMinX = 0;
+	emptySet.usMinY = 0;
+	emptySet.usWidth = 0;
+	emptySet.usHeight = 0;
+	emptySet.uiOffset = 0;
+	arrTileSets.assign(uiNumTiles, emptySet);
+	arrBits.clear();
+
+	std::vector<unsigned int> arrVisible;
+	arrVisible.reserve(uiNumTiles);
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+	{
+		if (cLevel.IsBlocked(i / iNumCols, i % iNumCols))
+			continue;
+
+		const int iX = (int)(i % iNumCols);
+		const int iY = (int)(i / iNumCols);
+
+		// Find the visible tiles and the rectangle around them
+		arrVisible.clear();
+		int iMinX = iX, iMaxX = iX, iMinY = iY, iMaxY = iY;
+		for (unsigned int j = 0; j < uiNumTiles; j++)
+		{
+			const int iTargetX = (int)(j % iNumCols);
+			const int iTargetY = (int)(j / iNumCols);
+			bool bVisible;
+			if (j < i)
+				bVisible = TestBit(j, iX, iY);
+			else if (j == i)
+				bVisible = true;
+			else
+				bVisible = !cLevel.IsBlocked(iTargetY, iTargetX) && cLineOfSight.CastRay(iX, iY, iTargetX, iTargetY);
+			if (!bVisible)
+				continue;
+
+			arrVisible.push_back(j);
+			iMinX = std::min(iMinX, iTargetX);
+			iMaxX = std::max(iMaxX, iTargetX);
+			iMinY = std::min(iMinY, iTargetY);
+			iMaxY = std::max(iMaxY, iTargetY);
+		}
+
+		// Store them as bits over that rectangle
+		TileSet& sTileSet = arrTileSets[i];
+		sTileSet.usMinX = (unsigned short)iMinX;
+		sTileSet.usMinY = (unsigned short)iMinY;
+		sTileSet.usWidth = (unsigned short)(iMaxX - iMinX + 1);
+		sTileSet.usHeight = (unsigned short)(iMaxY - iMinY + 1);
+		sTileSet.uiOffset = (unsigned int)arrBits.size() * 32;
+		arrBits.resize(arrBits.size() + (sTileSet.usWidth * sTileSet.usHeight + 31) / 32, 0);
+		for (unsigned int k = 0; k < arrVisible.size(); k++)
+		{
+			const int iTargetX = (int)(arrVisible[k] % iNumCols);
+			const int iTargetY = (int)(arrVisible[k] / iNumCols);
+			const unsigned int uiBit = sTileSet.uiOffset + (iTargetY - iMinY) * sTileSet.usWidth + (iTargetX - iMinX);
+			arrBits[uiBit >> 5] |= 1u << (uiBit & 31);
+		}
+	}
+
+	this->uiMapVersion = uiMapVersion;
+	bValid = true;
+}
+
+/**
+ @brief Load the visible sets from a file
+ @param filename A const std::string& variable containing the name of the file
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ */
+bool CPotentiallyVisibleSet::Load(const std::string& filename, const CMapLevel& cLevel, const unsigned int uiMapVersion)
+{
+	bValid = false;
+
+	ifstream file(filename.c_str(), ios::binary);
+	if (!file.is_open())
+		return false;
+
+	unsigned int arrHeader[6];
+	if (!file.read((char*)arrHeader, sizeof(arrHeader)))
+		return false;
+	// A file for another layout, another map size or other blocking tiles is out of date
+	if ((arrHeader[0] != uiFileMagic) ||
+		(arrHeader[1] != uiFileVersion) ||
+		(arrHeader[2] != cLevel.GetNumRows()) ||
+		(arrHeader[3] != cLevel.GetNumCols()) ||
+		(arrHeader[4] != HashBlockedTiles(cLevel)))
+		return false;
+
+	const unsigned int uiNumTiles = arrHeader[2] * arrHeader[3];
+	arrTileSets.resize(uiNumTiles);
+	arrBits.resize(arrHeader[5]);
+	if ((!file.read((char*)arrTileSets.data(), uiNumTiles * sizeof(TileSet))) ||
+		(!file.read((char*)arrBits.data(), arrBits.size() * sizeof(unsigned int))))
+		return false;
+
+	sMapSize.uiRowSize = arrHeader[2];
+	sMapSize.uiColSize = arrHeader[3];
+	uiBlockedHash = arrHeader[4];
+	this->uiMapVersion = uiMapVersion;
+	bValid = true;
+	return true;
+}
+
+/**
+ @brief Save the visible sets to a file
+ @param filename A const std::string& variable containing the name of the file
+ */
+bool CPotentiallyVisibleSet::Save(const std::string& filename) const
+{
+	if (!bValid)
+		return false;
+
+	ofstream file(filename.c_str(), ios::binary | ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	const unsigned int arrHeader[6] = { uiFileMagic,
+										uiFileVersion,
+										sMapSize.uiRowSize,
+										sMapSize.uiColSize,
+										uiBlockedHash,
+										(unsigned int)arrBits.size() };
+	file.write((const char*)arrHeader, sizeof(arrHeader));
+	file.write((const char*)arrTileSets.data(), arrTileSets.size() * sizeof(TileSet));
+	file.write((const char*)arrBits.data(), arrBits.size() * sizeof(unsigned int));
+	return file.good();
+}
+
+/**
+ @brief Mark the visible sets as out of date
+ */
+void CPotentiallyVisibleSet::Invalidate(void)
+{
+	bValid = false;
+}
+
+/**
+ @brief Swap the visible sets with others
+ @param cVisibleSet A CPotentiallyVisibleSet& variable containing the other visible sets
+ */
+void CPotentiallyVisibleSet::Swap(CPotentiallyVisibleSet& cVisibleSet)
+{
+	std::swap(bValid, cVisibleSet.bValid);
+	std::swap(uiMapVersion, cVisibleSet.uiMapVersion);
+	std::swap(sMapSize, cVisibleSet.sMapSize);
+	std::swap(uiBlockedHash, cVisibleSet.uiBlockedHash);
+	arrTileSets.swap(cVisibleSet.arrTileSets);
+	arrBits.swap(cVisibleSet.arrBits);
+}
+
+/**
+ @brief Set the version of the level the visible sets were made for
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ */
+void CPotentiallyVisibleSet::SetMapVersion(const unsigned int uiMapVersion)
+{
+	this->uiMapVersion = uiMapVersion;
+}
+
+/**
+ @brief Check if the visible sets are up to date for this version of the level
+ @param uiMapVersion A const unsigned int variable containing the version of the level
+ */
+bool CPotentiallyVisibleSet::IsValid(const unsigned int uiMapVersion) const
+{
+	return bValid && (this->uiMapVersion == uiMapVersion);
+}
+
+/**
+ @brief Check if a tile can be seen from another tile. Blocked tiles and tiles outside the level cannot see or be seen
+ @param observerPos A const glm::vec2& variable containing the tile of the observer
+ @param targetPos A const glm::vec2& variable containing the tile being looked at
+ */
+bool CPotentiallyVisibleSet::IsVisible(const glm::vec2& observerPos, const glm::vec2& targetPos) const
+{
+	const int iObserverX = (int)observerPos.x;
+	const int iObserverY = (int)observerPos.y;
+	if ((iObserverX < 0) || (iObserverX >= (int)sMapSize.uiColSize) ||
+		(iObserverY < 0) || (iObserverY >= (int)sMapSize.uiRowSize))
+		return false;
+	return TestBit(iObserverY * sMapSize.uiColSize + iObserverX, (int)targetPos.x, (int)targetPos.y);
+}
+
+/**
+ @brief Get the number of bytes used by the visible sets
+ */
+unsigned int CPotentiallyVisibleSet::GetMemorySize(void) const
+{
+	return (unsigned int)(arrTileSets.size() * sizeof(TileSet) + arrBits.size() * sizeof(unsigned int));
+}
+
+/**
+ @brief Get the name of the visible set file which belongs to a CSV file, by replacing its extension with ".pvs"
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ */
+std::string CPotentiallyVisibleSet::GetFilename(const std::string& csvFilename)
+{
+	const size_t uiDot = csvFilename.find_last_of('.');
+	const size_t uiSlash = csvFilename.find_last_of("/\\");
+	if ((uiDot == string::npos) || ((uiSlash != string::npos) && (uiDot < uiSlash)))
+		return csvFilename + ".pvs";
+	return csvFilename.substr(0, uiDot) + ".pvs";
+}
+
+/**
+ @brief Check if a tile is in the visible set of another tile
+ @param uiObserver A const unsigned int variable containing the index of the observer's tile
+ @param iTargetX A const int variable containing the column of the target
+ @param iTargetY A const int variable containing the inverted row of the target
+ */
+bool CPotentiallyVisibleSet::TestBit(const unsigned int uiObserver, const int iTargetX, const int iTargetY) const
+{
+	const TileSet& sTileSet = arrTileSets[uiObserver];
+	const int iX = iTargetX - sTileSet.usMinX;
+	const int iY = iTargetY - sTileSet.usMinY;
+	if ((iX < 0) || (iX >= sTileSet.usWidth) || (iY < 0) || (iY >= sTileSet.usHeight))
+		return false;
+	const unsigned int uiBit = sTileSet.uiOffset + iY * sTileSet.usWidth + iX;
+	return (arrBits[uiBit >> 5] & (1u << (uiBit & 31))) != 0;
+}
+
+/**
+ @brief Get the FNV-1a hash of the blocking tiles of a level
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+unsigned int CPotentiallyVisibleSet::HashBlockedTiles(const CMapLevel& cLevel)
+{
+	const unsigned int uiNumCols = cLevel.GetNumCols();
+	const unsigned int uiNumTiles = cLevel.GetNumRows() * uiNumCols;
+	unsigned int uiHash = 2166136261u;
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+	{
+		uiHash ^= cLevel.IsBlocked(i / uiNumCols, i % uiNumCols) ? 1u : 0u;
+		uiHash *= 16777619u;
+	}
+	return uiHash;
+}
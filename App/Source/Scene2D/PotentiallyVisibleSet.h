@@ -0,0 +1,85 @@
+/**
+ CPotentiallyVisibleSet
+ @brief A class which stores, for every free tile of a CMapLevel, the set of tiles which can be seen from it.
+		Each set is a bitset over the smallest rectangle holding its visible tiles, so a check is a single bit test.
+		The sets can be saved to and loaded from a file next to the CSV of the level.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include LineOfSight for the rays which the sets are built from
+#include "LineOfSight.h"
+
+#include <string>
+#include <vector>
+
+class CPotentiallyVisibleSet
+{
+public:
+	// Constructor
+	CPotentiallyVisibleSet(void);
+
+	// Destructor
+	~CPotentiallyVisibleSet(void);
+
+	// Build the visible sets of cLevel with the rays of cLineOfSight, which must already be built for cLevel
+	void Build(const CMapLevel& cLevel, const CLineOfSight& cLineOfSight, const unsigned int uiMapVersion);
+
+	// Load the visible sets from a file. Returns false if there is no file, or it was built for other blocking tiles
+	bool Load(const std::string& filename, const CMapLevel& cLevel, const unsigned int uiMapVersion);
+	// Save the visible sets to a file
+	bool Save(const std::string& filename) const;
+
+	// Mark the visible sets as out of date, e.g. when a new map was loaded
+	void Invalidate(void);
+
+	// Swap the visible sets with others, e.g. along with the level they were made for
+	void Swap(CPotentiallyVisibleSet& cVisibleSet);
+	// Set the version of the level the visible sets were made for, once they are swapped into a level with another version
+	void SetMapVersion(const unsigned int uiMapVersion);
+
+	// Check if the visible sets are up to date for this version of the level
+	bool IsValid(const unsigned int uiMapVersion) const;
+
+	// Check if targetPos can be seen from observerPos. Positions are (column, inverted row)
+	bool IsVisible(const glm::vec2& observerPos, const glm::vec2& targetPos) const;
+
+	// Get the number of bytes used by the visible sets
+	unsigned int GetMemorySize(void) const;
+
+	// Get the name of the visible set file which belongs to a CSV file
+	static std::string GetFilename(const std::string& csvFilename);
+
+protected:
+	// The rectangle around the tiles visible from one tile, and where its bits start in arrBits
+	struct TileSet
+	{
+		unsigned short usMinX;
+		unsigned short usMinY;
+		unsigned short usWidth;
+		unsigned short usHeight;
+		unsigned int uiOffset;
+	};
+
+	// Whether the visible sets are up to date, and the version of the level they were made for
+	bool bValid;
+	unsigned int uiMapVersion;
+	// The size of the level the visible sets were made for
+	MapSize sMapSize;
+	// The hash of the blocking tiles the visible sets were made for
+	unsigned int uiBlockedHash;
+
+	// The visible set of each tile, with the tile index being (inverted row * columns + column)
+	std::vector<TileSet> arrTileSets;
+	// The bits of all the visible sets
+	std::vector<unsigned int> arrBits;
+
+	// Check if tile uiTarget is in the visible set of tile uiObserver
+	bool TestBit(const unsigned int uiObserver, const int iTargetX, const int iTargetY) const;
+	// Get the hash of the blocking tiles of a level
+	static unsigned int HashBlockedTiles(const CMapLevel& cLevel);
+};
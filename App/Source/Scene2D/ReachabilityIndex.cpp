@@ -0,0 +1,296 @@
+/**
+ CReachabilityIndex
+ @brief A class which labels the connected regions of free tiles in a CMapLevel, so that it can tell
+		in O(1) whether a path exists between two tiles. It is kept up to date as single tiles change.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "ReachabilityIndex.h"
+
+// The 8 tiles around a tile, in the order of going around it
+static const int iRingX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int iRingY[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+
+/**
+ @brief Constructor
+ */
+CReachabilityIndex::CReachabilityIndex(void)
+	: bValid(false)
+	, uiNrOfDirections(0)
+	, uiNumSplits(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CReachabilityIndex::~CReachabilityIndex(void)
+{
+}
+
+/**
+ @brief Label the connected regions of a level
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+void CReachabilityIndex::Build(const CMapLevel& cLevel, const unsigned int uiNrOfDirections)
+{
+	this->uiNrOfDirections = uiNrOfDirections;
+	sMapSize.uiRowSize = cLevel.GetNumRows();
+	sMapSize.uiColSize = cLevel.GetNumCols();
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iNumTiles = (int)(sMapSize.uiRowSize * sMapSize.uiColSize);
+	arrLabels.assign(iNumTiles, -1);
+	arrParents.clear();
+	arrQueue.reserve(iNumTiles);
+
+	// Mark the free tiles as belonging to a region which has not been found yet
+	const int iUnlabelled = 0;
+	arrParents.push_back(iUnlabelled);
+	for (int i = 0; i < iNumTiles; i++)
+	{
+		if (!cLevel.IsBlocked(i / iNumCols, i % iNumCols))
+			arrLabels[i] = iUnlabelled;
+	}
+
+	for (int i = 0; i < iNumTiles; i++)
+	{
+		if (arrLabels[i] != iUnlabelled)
+			continue;
+		const int iLabel = (int)arrParents.size();
+		arrParents.push_back(iLabel);
+		FloodFill(cLevel, i, iUnlabelled, iLabel);
+	}
+
+	bValid = true;
+}
+
+/**
+ @brief Mark the labels as out of date
+ */
+void CReachabilityIndex::Invalidate(void)
+{
+	bValid = false;
+}
+
+/**
+ @brief Check if the labels are up to date for this level size and number of directions
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ */
+bool CReachabilityIndex::IsValid(const CMapLevel& cLevel, const unsigned int uiNrOfDirections) const
+{
+	return bValid &&
+		(this->uiNrOfDirections == uiNrOfDirections) &&
+		(sMapSize.uiRowSize == cLevel.GetNumRows()) &&
+		(sMapSize.uiColSize == cLevel.GetNumCols());
+}
+
+/**
+ @brief Update the labels after a tile changed between blocked and free.
+		A freed tile joins the regions around it. A blocked tile can split its region,
+		which is then labelled again unless its neighbours are still connected around it
+ @param cLevel A const CMapLevel& variable containing the level, with the tile already changed
+ @param uiRow A const unsigned int variable containing the inverted row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CReachabilityIndex::OnTileChanged(const CMapLevel& cLevel, const unsigned int uiRow, const unsigned int uiCol)
+{
+	if (!bValid)
+		return;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iX = (int)uiCol;
+	const int iY = (int)uiRow;
+	const int iTile = iY * iNumCols + iX;
+
+	if (!cLevel.IsBlocked(iY, iX))
+	{
+		if (arrLabels[iTile] >= 0)
+			return;
+
+		// Join the regions of the free neighbours, or start a new region
+		int iRoot = -1;
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+		{
+			const int iNeighborX = iX + iDirectionX[i];
+			const int iNeighborY = iY + iDirectionY[i];
+			if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+				continue;
+			const int iNeighborRoot = FindRoot(arrLabels[iNeighborY * iNumCols + iNeighborX]);
+			if (iRoot < 0)
+				iRoot = iNeighborRoot;
+			else if (iNeighborRoot != iRoot)
+				arrParents[iNeighborRoot] = iRoot;
+		}
+		if (iRoot < 0)
+		{
+			iRoot = (int)arrParents.size();
+			arrParents.push_back(iRoot);
+		}
+		arrLabels[iTile] = iRoot;
+		return;
+	}
+
+	if (arrLabels[iTile] < 0)
+		return;
+	const int iRoot = FindRoot(arrLabels[iTile]);
+	arrLabels[iTile] = -1;
+	if (IsLocallyConnected(cLevel, iX, iY))
+		return;
+
+	// Old labels are never reused, so start again once there are too many of them
+	if (arrParents.size() > arrLabels.size() * 2)
+	{
+		Build(cLevel, uiNrOfDirections);
+		return;
+	}
+
+	// Give each part of the region which a free neighbour is in a new label.
+	// The tiles left with the old label after all but one neighbour are the part of that last neighbour
+	uiNumSplits++;
+	int iLastNeighbor = -1;
+	for (unsigned int i = 0; i < uiNrOfDirections; i++)
+	{
+		const int iNeighborX = iX + iDirectionX[i];
+		const int iNeighborY = iY + iDirectionY[i];
+		if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+			continue;
+		const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+		if (FindRoot(arrLabels[iNeighbor]) != iRoot)
+			continue;
+		// The previous neighbour may have been given a new label already, by the flood fill of a neighbour in its part
+		if ((iLastNeighbor >= 0) && (FindRoot(arrLabels[iLastNeighbor]) == iRoot))
+		{
+			const int iLabel = (int)arrParents.size();
+			arrParents.push_back(iLabel);
+			FloodFill(cLevel, iLastNeighbor, iRoot, iLabel);
+		}
+		iLastNeighbor = iNeighbor;
+	}
+}
+
+/**
+ @brief Check if a path exists between two positions
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+bool CReachabilityIndex::IsConnected(const glm::vec2& startPos, const glm::vec2& targetPos)
+{
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iNumRows = (int)sMapSize.uiRowSize;
+	if ((startPos.x < 0) || (startPos.x >= iNumCols) || (startPos.y < 0) || (startPos.y >= iNumRows) ||
+		(targetPos.x < 0) || (targetPos.x >= iNumCols) || (targetPos.y < 0) || (targetPos.y >= iNumRows))
+		return false;
+
+	const int iStartLabel = arrLabels[(int)startPos.y * iNumCols + (int)startPos.x];
+	const int iTargetLabel = arrLabels[(int)targetPos.y * iNumCols + (int)targetPos.x];
+	if ((iStartLabel < 0) || (iTargetLabel < 0))
+		return false;
+	return FindRoot(iStartLabel) == FindRoot(iTargetLabel);
+}
+
+/**
+ @brief Get the number of times a region had to be labelled again
+ */
+unsigned int CReachabilityIndex::GetNumSplits(void) const
+{
+	return uiNumSplits;
+}
+
+/**
+ @brief Get the root label of a label
+ @param iLabel An int variable containing the label
+ */
+int CReachabilityIndex::FindRoot(int iLabel)
+{
+	while (arrParents[iLabel] != iLabel)
+	{
+		arrParents[iLabel] = arrParents[arrParents[iLabel]];
+		iLabel = arrParents[iLabel];
+	}
+	return iLabel;
+}
+
+/**
+ @brief Give a new label to the tiles in a region which can be reached from a tile
+ @param cLevel A const CMapLevel& variable containing the level
+ @param iStart A const int variable containing the tile to start from
+ @param iRoot A const int variable containing the root label of the region
+ @param iLabel A const int variable containing the new label, which must be its own root
+ */
+void CReachabilityIndex::FloodFill(const CMapLevel& cLevel, const int iStart, const int iRoot, const int iLabel)
+{
+	const int iNumCols = (int)sMapSize.uiColSize;
+	arrQueue.clear();
+	arrQueue.push_back(iStart);
+	arrLabels[iStart] = iLabel;
+	for (unsigned int uiHead = 0; uiHead < arrQueue.size(); uiHead++)
+	{
+		const int iCurrent = arrQueue[uiHead];
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+		for (unsigned int i = 0; i < uiNrOfDirections; i++)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if (!CJumpTable::IsFree(cLevel, iNeighborX, iNeighborY))
+				continue;
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			if ((arrLabels[iNeighbor] < 0) || (FindRoot(arrLabels[iNeighbor]) != iRoot))
+				continue;
+			arrLabels[iNeighbor] = iLabel;
+			arrQueue.push_back(iNeighbor);
+		}
+	}
+}
+
+/**
+ @brief Check if the free neighbours of a tile are connected through the 8 tiles around it.
+		This is so if they are all in one unbroken run of free tiles around it
+ @param cLevel A const CMapLevel& variable containing the level
+ @param iX A const int variable containing the column of the tile
+ @param iY A const int variable containing the inverted row of the tile
+ */
+bool CReachabilityIndex::IsLocallyConnected(const CMapLevel& cLevel, const int iX, const int iY) const
+{
+	bool bFree[8];
+	int iBlocked = -1;
+	for (int i = 0; i < 8; i++)
+	{
+		bFree[i] = CJumpTable::IsFree(cLevel, iX + iRingX[i], iY + iRingY[i]);
+		if (!bFree[i])
+			iBlocked = i;
+	}
+	if (iBlocked < 0)
+		return true;
+
+	// Count the runs of free tiles which hold a neighbour, starting after a blocked tile.
+	// With 4 directions only the straight neighbours, at the even places of the ring, are neighbours
+	unsigned int uiNumRuns = 0;
+	bool bInRun = false;
+	bool bRunCounted = false;
+	for (int k = 1; k <= 8; k++)
+	{
+		const int i = (iBlocked + k) % 8;
+		if (!bFree[i])
+		{
+			bInRun = false;
+			continue;
+		}
+		if (!bInRun)
+		{
+			bInRun = true;
+			bRunCounted = false;
+		}
+		if ((!bRunCounted) && ((uiNrOfDirections == 8) || (i % 2 == 0)))
+		{
+			bRunCounted = true;
+			uiNumRuns++;
+		}
+	}
+	return uiNumRuns <= 1;
+}
@@ -0,0 +1,69 @@
+/**
+ CReachabilityIndex
+ @brief A class which labels the connected regions of free tiles in a CMapLevel, so that it can tell
+		in O(1) whether a path exists between two tiles. It is kept up to date as single tiles change.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include JumpTable for the directions and the free tile check
+#include "JumpTable.h"
+
+#include <vector>
+
+class CReachabilityIndex
+{
+public:
+	// Constructor
+	CReachabilityIndex(void);
+
+	// Destructor
+	~CReachabilityIndex(void);
+
+	// Label the connected regions of cLevel, moving in 4 or 8 directions
+	void Build(const CMapLevel& cLevel, const unsigned int uiNrOfDirections);
+
+	// Mark the labels as out of date, e.g. when a new map was loaded
+	void Invalidate(void);
+
+	// Check if the labels are up to date for this level size and number of directions
+	bool IsValid(const CMapLevel& cLevel, const unsigned int uiNrOfDirections) const;
+
+	// Update the labels after a tile changed between blocked and free. The row is inverted, like the path positions
+	void OnTileChanged(const CMapLevel& cLevel, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Check if a path exists between two positions. Blocked positions and positions outside the level are not connected
+	bool IsConnected(const glm::vec2& startPos, const glm::vec2& targetPos);
+
+	// Get the number of times a region had to be labelled again because a blocked tile could have split it
+	unsigned int GetNumSplits(void) const;
+
+protected:
+	// Whether the labels are up to date
+	bool bValid;
+	// The number of directions the labels were built for
+	unsigned int uiNrOfDirections;
+	// The size of the level the labels were built for
+	MapSize sMapSize;
+
+	// The label of each tile, or -1 if it is blocked
+	std::vector<int> arrLabels;
+	// The union-find parent of each label. Labels with the same root are in the same region
+	std::vector<int> arrParents;
+	// The flood fill queue
+	std::vector<int> arrQueue;
+
+	// The number of times a region was labelled again
+	unsigned int uiNumSplits;
+
+	// Get the root label of a label, halving the path to it on the way
+	int FindRoot(int iLabel);
+	// Give a new label to the tiles in the region of iRoot which can be reached from iStart
+	void FloodFill(const CMapLevel& cLevel, const int iStart, const int iRoot, const int iLabel);
+	// Check if the free neighbours of a tile are connected around it, so that blocking it cannot split their region
+	bool IsLocallyConnected(const CMapLevel& cLevel, const int iX, const int iY) const;
+};
@@ -13,6 +13,14 @@ using namespace std;
 
 #include "System\filesystem.h"
 
+// The CSV file of each level, in the order they are played. Every level has to be the size which CMap2D::Init
+// is given, 40x30 tiles
+static const char* const arrLevelFilenames[] = {
+	"Maps/DM2213_Map_Level_01.csv",
+	"Maps/DM2213_Map_Level_02.csv"
+};
+static const unsigned int uiNumLevels = sizeof(arrLevelFilenames) / sizeof(arrLevelFilenames[0]);
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -90,17 +98,22 @@ bool CScene2D::Init(void)
 	cMap2D->SetShader("Shader2D");
 	// Load the map into an array
 	// Initialise the instance
-	if (cMap2D->Init(2, 30, 40) == false)
+	if (cMap2D->Init(uiNumLevels, 30, 40) == false)
 	{
 		cout << "Failed to load CMap2D" << endl;
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_01.csv") == false)
+	if (cMap2D->LoadMap(arrLevelFilenames[0]) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
+	// Load the next level in the background while this one is played
+	if (uiNumLevels > 1)
+		cMap2D->PreloadMap(arrLevelFilenames[1], 1);
+	// The enemies walk one tile at a time, so they only need the tiles where their paths turn
+	cMap2D->SetPathSmoothing(pathsmoothing::TURNPOINTS);
 
 	srand(time(NULL)); 
 	RandomSpawns(); // has to be called before initialising the cPlayer2D 
@@ -175,6 +188,9 @@ bool CScene2D::Init(void)
 */
 bool CScene2D::Update(const double dElapsedTime)
 {
+	// Hand the paths requested last frame to the entities before they update
+	cMap2D->SyncPathRequests();
+
 	// Call the cPlayer2D's update method before Map2D as we want to capture the inputs before map2D update
 	cPlayer2D->Update(dElapsedTime);
 
@@ -184,16 +200,22 @@ bool CScene2D::Update(const double dElapsedTime)
 	// Call all the cPet2D's updated method
 	cPet2D->Update(dElapsedTime);
 
-	// Call the Map2D's update method
+	// Call the Map2D's update method, keeping the chunks of a streamed level around the player
+	cMap2D->SetStreamingFocus(cPlayer2D->vec2Index);
 	cMap2D->Update(dElapsedTime);
 
 	// Get keyboard updates
 	if (cKeyboardController->IsKeyReleased(GLFW_KEY_F6))
 	{
-		// Save the current game to a save file
+		// Save the current game to a save file. It is written by the I/O thread, so the game carries on meanwhile
 		// Make sure the file is open
 		try {
-			if (cMap2D->SaveMap("Maps/DM2213_Map_Level_01_SAVEGAMEtest.csv") == false)
+			if (cMap2D->SaveMap("Maps/DM2213_Map_Level_01_SAVEGAMEtest.csv", cMap2D->GetCurrentLevel(),
+								[](const unsigned int, const bool bSaved)
+								{
+									if (!bSaved)
+										cout << "Unable to save the current game to a file" << endl;
+								}) == false)
 			{
 				throw runtime_error("Unable to save the current game to a file");
 			}
@@ -208,7 +230,18 @@ bool CScene2D::Update(const double dElapsedTime)
 	//Check if the game should go to the next level
 	if (cGameManager->bLevelCompleted == true)
 	{
-		cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 1);
+		// The next level was preloaded, so switching to it only swaps it in. The completed level is not played again,
+		// so it is freed, and the level after the next one is loaded in the background
+		const unsigned int uiCompletedLevel = cMap2D->GetCurrentLevel();
+		const unsigned int uiNextLevel = uiCompletedLevel + 1;
+		if (cMap2D->SetCurrentLevel(uiNextLevel))
+		{
+			cMap2D->UnloadMap(uiCompletedLevel);
+			if (uiNextLevel + 1 < uiNumLevels)
+				cMap2D->PreloadMap(arrLevelFilenames[uiNextLevel + 1], uiNextLevel + 1);
+		}
+		else
+			cout << "Unable to switch to level " << uiNextLevel << ", staying on level " << uiCompletedLevel << endl;
 		cPlayer2D->Reset();
 		cGameManager->bLevelCompleted = false;
 	}
@@ -316,6 +349,8 @@ void CScene2D::RandomSpawns(void)
 	//unsigned int HiFreqWhistleSpawn;	// 2 different locations
 	unsigned int CerealSpawn[2] = {};	// 4 different locations
 
+	arrSpawnPositions.clear();
+
 
 	// set player's spawn at 1 of 4 random locations
 	PlayerSpawn = rand() % 4;
@@ -358,16 +393,16 @@ void CScene2D::RandomSpawns(void)
 	switch (PlayerSpawn)
 	{
 	case 0:
-		cMap2D->SetMapInfo(26, 4, 200);
+		Spawn(26, 4, tiletype::PLAYER_SPAWN);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(4, 4, 200);
+		Spawn(4, 4, tiletype::PLAYER_SPAWN);
 		break;
 	case 2:
-		cMap2D->SetMapInfo(4, 36, 200);
+		Spawn(4, 36, tiletype::PLAYER_SPAWN);
 		break;
 	case 3:
-		cMap2D->SetMapInfo(26, 36, 200);
+		Spawn(26, 36, tiletype::PLAYER_SPAWN);
 		break;
 	default:
 		cout << "Player is not spawned" << endl;
@@ -378,28 +413,28 @@ void CScene2D::RandomSpawns(void)
 	switch (WinZone)
 	{
 	case 0:
-		cMap2D->SetMapInfo(23, 13, 99);
-		cMap2D->SetMapInfo(22, 13, 99);
-		cMap2D->SetMapInfo(22, 12, 99);
-		cMap2D->SetMapInfo(23, 12, 99);
+		Spawn(23, 13, tiletype::EXIT);
+		Spawn(22, 13, tiletype::EXIT);
+		Spawn(22, 12, tiletype::EXIT);
+		Spawn(23, 12, tiletype::EXIT);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(7, 4, 99);
-		cMap2D->SetMapInfo(6, 4, 99);
-		cMap2D->SetMapInfo(6, 3, 99);
-		cMap2D->SetMapInfo(7, 3, 99);
+		Spawn(7, 4, tiletype::EXIT);
+		Spawn(6, 4, tiletype::EXIT);
+		Spawn(6, 3, tiletype::EXIT);
+		Spawn(7, 3, tiletype::EXIT);
 		break;
 	case 2:
-		cMap2D->SetMapInfo(4, 30, 99);
-		cMap2D->SetMapInfo(3, 30, 99);
-		cMap2D->SetMapInfo(3, 29, 99);
-		cMap2D->SetMapInfo(4, 29, 99);
+		Spawn(4, 30, tiletype::EXIT);
+		Spawn(3, 30, tiletype::EXIT);
+		Spawn(3, 29, tiletype::EXIT);
+		Spawn(4, 29, tiletype::EXIT);
 		break;
 	case 3:
-		cMap2D->SetMapInfo(19, 33, 99);
-		cMap2D->SetMapInfo(20, 33, 99);
-		cMap2D->SetMapInfo(20, 32, 99);
-		cMap2D->SetMapInfo(19, 32, 99);
+		Spawn(19, 33, tiletype::EXIT);
+		Spawn(20, 33, tiletype::EXIT);
+		Spawn(20, 32, tiletype::EXIT);
+		Spawn(19, 32, tiletype::EXIT);
 		break;
 	default:
 		cout << "Win-Zone is not spawned" << endl;
@@ -410,22 +445,22 @@ void CScene2D::RandomSpawns(void)
 	switch (DogSpawn)
 	{
 	case 0:
-		cMap2D->SetMapInfo(29, 13, 400);
+		Spawn(29, 13, tiletype::PET_SPAWN);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(7, 13, 400);
+		Spawn(7, 13, tiletype::PET_SPAWN);
 		break;
 	case 2:
-		cMap2D->SetMapInfo(1, 28, 400);
+		Spawn(1, 28, tiletype::PET_SPAWN);
 		break;
 	case 3:
-		cMap2D->SetMapInfo(26, 28, 400);
+		Spawn(26, 28, tiletype::PET_SPAWN);
 		break;
 	case 4:
-		cMap2D->SetMapInfo(18, 30, 400);
+		Spawn(18, 30, tiletype::PET_SPAWN);
 		break;
 	case 5:
-		cMap2D->SetMapInfo(17, 1, 400);
+		Spawn(17, 1, tiletype::PET_SPAWN);
 		break;
 	default:
 		cout << "Player is not spawned" << endl;
@@ -436,10 +471,10 @@ void CScene2D::RandomSpawns(void)
 	switch (FlareSpawn)
 	{
 	case 0:
-		cMap2D->SetMapInfo(26, 18, 2);
+		Spawn(26, 18, tiletype::FLARE);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(3, 21, 2);
+		Spawn(3, 21, tiletype::FLARE);
 		break;
 	default:
 		cout << "Flare is not spawned" << endl;
@@ -450,16 +485,16 @@ void CScene2D::RandomSpawns(void)
 	switch (CerealSpawn[0])
 	{
 	case 0:
-		cMap2D->SetMapInfo(19, 12, 4);
+		Spawn(19, 12, tiletype::CEREAL);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(10, 8, 4);
+		Spawn(10, 8, tiletype::CEREAL);
 		break;
 	case 2:
-		cMap2D->SetMapInfo(17, 30, 4);
+		Spawn(17, 30, tiletype::CEREAL);
 		break;
 	case 3:
-		cMap2D->SetMapInfo(9, 26, 4);
+		Spawn(9, 26, tiletype::CEREAL);
 		break;
 	default:
 		cout << "Cereal1 is not spawned" << endl;
@@ -470,16 +505,16 @@ void CScene2D::RandomSpawns(void)
 	switch (CerealSpawn[1])
 	{
 	case 0:
-		cMap2D->SetMapInfo(19, 12, 4);
+		Spawn(19, 12, tiletype::CEREAL);
 		break;
 	case 1:
-		cMap2D->SetMapInfo(10, 8, 4);
+		Spawn(10, 8, tiletype::CEREAL);
 		break;
 	case 2:
-		cMap2D->SetMapInfo(17, 30, 4);
+		Spawn(17, 30, tiletype::CEREAL);
 		break;
 	case 3:
-		cMap2D->SetMapInfo(9, 26, 4);
+		Spawn(9, 26, tiletype::CEREAL);
 		break;
 	default:
 		cout << "Cereal2 is not spawned" << endl;
@@ -495,10 +530,32 @@ void CScene2D::RandomSpawns(void)
 		<< "CS1: " << CerealSpawn[1] << endl
 		<< endl;*/
 
+	// Everything which was spawned has to be reachable from the player spawn
+	for (unsigned int i = 1; i < arrSpawnPositions.size(); i++)
+	{
+		if (!cMap2D->IsReachable(arrSpawnPositions[0], arrSpawnPositions[i]))
+		{
+			cout << "Spawn at (" << arrSpawnPositions[i].x << ", " << arrSpawnPositions[i].y
+				<< ") cannot be reached from (" << arrSpawnPositions[0].x << ", " << arrSpawnPositions[0].y << ")" << endl;
+		}
+	}
+
 	return;
 }
 
 
+/**
+ @brief Set a tile to a spawned value, and remember where it is for checking that the spawns are reachable
+ @param uiRow A const unsigned int variable containing the row of the tile, counted from the bottom
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param iValue A const int variable containing the value of the spawned tile
+ */
+void CScene2D::Spawn(const unsigned int uiRow, const unsigned int uiCol, const int iValue)
+{
+	cMap2D->SetMapInfo(uiRow, uiCol, iValue);
+	arrSpawnPositions.push_back(glm::vec2(uiCol, uiRow));
+}
+
 /**
  @brief PostRender Set up the OpenGL display environment after rendering.
  */
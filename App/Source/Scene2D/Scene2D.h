@@ -98,6 +98,10 @@ protected:
 	// Randomly set the player spawn, dog spawn, win-zone spawn, 
 	// cereal spawn, hi-freq whistle spawn, flare spawn 
 	void RandomSpawns(void);
+	// Set a tile to a spawned value, and remember where it is
+	void Spawn(const unsigned int uiRow, const unsigned int uiCol, const int iValue);
+	// The positions set by RandomSpawns, starting with the player spawn
+	std::vector<glm::vec2> arrSpawnPositions;
 
 	// Constructor
 	CScene2D(void);
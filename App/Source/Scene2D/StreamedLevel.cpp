@@ -0,0 +1,637 @@
+/**
+ CStreamedLevel
+ @brief A class which stores a level in a chunk file of fixed-size square chunks, and keeps only the chunks
+		around a focus tile in memory. A worker thread reads the chunks around the focus before they are needed,
+		the chunks furthest from use are evicted when the memory budget is reached, and edited chunks are
+		written back into the file when they are evicted. The tiles inside a chunk can be stored in Morton order,
+		so that neighbouring tiles are close together in memory whichever way they neighbour.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "StreamedLevel.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// The first 4 bytes of a chunk file, and the version of its layout.
+// The header is { magic, version, rows, columns, log2 of the chunk size, layout, CSV size (low, high), CSV hash },
+// followed by the chunks row by row, each holding all of its tiles even at the edges of the level
+static const unsigned int uiFileMagic = 0x314B4843;	// "CHK1"
+static const unsigned int uiFileVersion = 2;
+static const unsigned int uiHeaderSize = 9 * sizeof(unsigned int);
+// The smallest and largest chunks, as the log2 of their size
+static const unsigned int uiMinChunkShift = 3;
+static const unsigned int uiMaxChunkShift = 8;
+
+const unsigned int CStreamedLevel::uiNoSlot;
+const unsigned int CStreamedLevel::uiLoadingBit;
+
+/**
+ @brief Constructor
+ */
+CStreamedLevel::CStreamedLevel(void)
+	: uiNumRows(0)
+	, uiNumCols(0)
+	, uiChunkShift(0)
+	, uiChunkMask(0)
+	, uiNumChunkRows(0)
+	, uiNumChunkCols(0)
+	, eLayout(ROW_MAJOR)
+	, uiFocusChunkRow(0)
+	, uiFocusChunkCol(0)
+	, uiLoadRadius(0)
+	, uiClock(0)
+	, m_uiActiveSlot(uiNoSlot)
+	, m_bStop(false)
+	, uiNumLoads(0)
+	, uiNumMisses(0)
+	, uiNumEvictions(0)
+	, uiNumWriteBacks(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CStreamedLevel::~CStreamedLevel(void)
+{
+	Close();
+}
+
+/**
+ @brief Open a chunk file
+ @param filename A const std::string& variable containing the name of the file
+ @param uiMemoryBudget A const size_t variable containing the number of bytes of chunks which may be kept in memory
+ @param uiLoadRadius A const unsigned int variable containing how many chunks away from the focus are read ahead
+ */
+bool CStreamedLevel::Open(const std::string& filename, const size_t uiMemoryBudget, const unsigned int uiLoadRadius)
+{
+	Close();
+
+	file.open(filename.c_str(), ios::in | ios::out | ios::binary);
+	if (!file.is_open())
+		return false;
+
+	// A file of another layout, or one which was cut short, cannot be used
+	unsigned int arrHeader[9] = { 0 };
+	file.read((char*)arrHeader, sizeof(arrHeader));
+	file.seekg(0, ios::end);
+	const unsigned long long ullFileSize = (unsigned long long)file.tellg();
+	if ((!file) ||
+		(arrHeader[0] != uiFileMagic) ||
+		(arrHeader[1] != uiFileVersion) ||
+		(arrHeader[4] < uiMinChunkShift) || (arrHeader[4] > uiMaxChunkShift) ||
+		(arrHeader[5] >= NUM_LAYOUTS))
+	{
+		file.close();
+		return false;
+	}
+	uiNumRows = arrHeader[2];
+	uiNumCols = arrHeader[3];
+	uiChunkShift = arrHeader[4];
+	uiChunkMask = (1u << uiChunkShift) - 1;
+	eLayout = (LAYOUT)arrHeader[5];
+	uiNumChunkRows = (uiNumRows + uiChunkMask) >> uiChunkShift;
+	uiNumChunkCols = (uiNumCols + uiChunkMask) >> uiChunkShift;
+	const unsigned long long ullNumChunks = (unsigned long long)uiNumChunkRows * uiNumChunkCols;
+	const size_t uiChunkBytes = sizeof(int) << (2 * uiChunkShift);
+	if ((ullNumChunks == 0) || (ullNumChunks >= uiLoadingBit) || (uiHeaderSize + ullNumChunks * uiChunkBytes > ullFileSize))
+	{
+		file.close();
+		return false;
+	}
+	GetChunkOffsets(uiChunkShift, eLayout, arrRowOffsets, arrColOffsets);
+
+	// Every chunk within the load radius of the focus has to fit, with one more for a chunk read at once
+	this->uiLoadRadius = uiLoadRadius;
+	const unsigned long long ullWindowChunks = (2ull * uiLoadRadius + 1) * (2ull * uiLoadRadius + 1) + 1;
+	unsigned long long ullNumSlots = std::max((unsigned long long)(uiMemoryBudget / uiChunkBytes), ullWindowChunks);
+	ullNumSlots = std::min(ullNumSlots, ullNumChunks);
+	arrSlotTiles.assign((size_t)ullNumSlots << (2 * uiChunkShift), 0);
+	const Slot sFreeSlot = { FREE, 0, 0, false };
+	arrSlots.assign((size_t)ullNumSlots, sFreeSlot);
+	arrChunkSlots.assign((size_t)ullNumChunks, uiNoSlot);
+
+	uiFocusChunkRow = 0;
+	uiFocusChunkCol = 0;
+	uiClock = 0;
+	uiNumLoads = 0;
+	uiNumMisses = 0;
+	uiNumEvictions = 0;
+	uiNumWriteBacks = 0;
+
+	m_bStop = false;
+	m_uiActiveSlot = uiNoSlot;
+	cWorker = std::thread(&CStreamedLevel::WorkerLoop, this);
+	return true;
+}
+
+/**
+ @brief Write the edited chunks back, stop the worker thread and close the file
+ */
+void CStreamedLevel::Close(void)
+{
+	if (!IsOpen())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+		m_pendingSlots.clear();
+	}
+	m_cvWork.notify_all();
+	if (cWorker.joinable())
+		cWorker.join();
+
+	if (!Flush())
+		cout << "CStreamedLevel::Close() : unable to write the edited chunks back" << endl;
+	file.close();
+
+	m_loadedSlots.clear();
+	arrSlotTiles.clear();
+	arrSlots.clear();
+	arrChunkSlots.clear();
+	uiNumRows = 0;
+	uiNumCols = 0;
+}
+
+/**
+ @brief Check if a chunk file is open
+ */
+bool CStreamedLevel::IsOpen(void) const
+{
+	return file.is_open();
+}
+
+/**
+ @brief Set the tile around which the chunks are kept in memory
+ @param uiRow A const unsigned int variable containing the row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ @param bInvert A const bool variable which indicates if the row is inverted
+ */
+void CStreamedLevel::SetFocus(unsigned int uiRow, const unsigned int uiCol, const bool bInvert)
+{
+	if ((uiRow >= uiNumRows) || (uiCol >= uiNumCols))
+		return;
+	if (bInvert)
+		uiRow = uiNumRows - uiRow - 1;
+	uiFocusChunkRow = uiRow >> uiChunkShift;
+	uiFocusChunkCol = uiCol >> uiChunkShift;
+}
+
+/**
+ @brief Take the chunks read by the worker thread, and queue the chunks around the focus which are not in memory yet
+ */
+void CStreamedLevel::Update(void)
+{
+	if (!IsOpen())
+		return;
+
+	uiClock++;
+	const unsigned int uiMinRow = uiFocusChunkRow - std::min(uiFocusChunkRow, uiLoadRadius);
+	const unsigned int uiMaxRow = std::min(uiFocusChunkRow + uiLoadRadius, uiNumChunkRows - 1);
+	const unsigned int uiMinCol = uiFocusChunkCol - std::min(uiFocusChunkCol, uiLoadRadius);
+	const unsigned int uiMaxCol = std::min(uiFocusChunkCol + uiLoadRadius, uiNumChunkCols - 1);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		InstallLoadedSlots();
+
+		// The chunks which the focus has moved away from before they were read are not needed any more
+		std::deque<unsigned int>::iterator it = m_pendingSlots.begin();
+		while (it != m_pendingSlots.end())
+		{
+			const unsigned int uiChunk = arrSlots[*it].uiChunk;
+			const unsigned int uiChunkRow = uiChunk / uiNumChunkCols;
+			const unsigned int uiChunkCol = uiChunk % uiNumChunkCols;
+			if ((uiChunkRow < uiMinRow) || (uiChunkRow > uiMaxRow) || (uiChunkCol < uiMinCol) || (uiChunkCol > uiMaxCol))
+			{
+				arrSlots[*it].eState = FREE;
+				arrChunkSlots[uiChunk] = uiNoSlot;
+				it = m_pendingSlots.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	// Mark every chunk around the focus as used, so that none of them is evicted to make room for another
+	for (unsigned int uiChunkRow = uiMinRow; uiChunkRow <= uiMaxRow; uiChunkRow++)
+	{
+		for (unsigned int uiChunkCol = uiMinCol; uiChunkCol <= uiMaxCol; uiChunkCol++)
+		{
+			const unsigned int uiSlot = arrChunkSlots[uiChunkRow * uiNumChunkCols + uiChunkCol];
+			if (uiSlot != uiNoSlot)
+				arrSlots[uiSlot & ~uiLoadingBit].uiLastUsed = uiClock;
+		}
+	}
+
+	// Queue the missing chunks nearest to the focus first
+	std::vector<unsigned int> arrQueuedSlots;
+	for (unsigned int uiDistance = 0; uiDistance <= uiLoadRadius; uiDistance++)
+	{
+		for (unsigned int uiChunkRow = uiMinRow; uiChunkRow <= uiMaxRow; uiChunkRow++)
+		{
+			for (unsigned int uiChunkCol = uiMinCol; uiChunkCol <= uiMaxCol; uiChunkCol++)
+			{
+				const unsigned int uiRowDistance = (unsigned int)abs((int)uiChunkRow - (int)uiFocusChunkRow);
+				const unsigned int uiColDistance = (unsigned int)abs((int)uiChunkCol - (int)uiFocusChunkCol);
+				const unsigned int uiChunk = uiChunkRow * uiNumChunkCols + uiChunkCol;
+				if ((std::max(uiRowDistance, uiColDistance) != uiDistance) || (arrChunkSlots[uiChunk] != uiNoSlot))
+					continue;
+
+				const unsigned int uiSlot = AcquireSlot(false);
+				if (uiSlot == uiNoSlot)
+					break;
+				const Slot sSlot = { LOADING, uiChunk, uiClock, false };
+				arrSlots[uiSlot] = sSlot;
+				arrChunkSlots[uiChunk] = uiSlot | uiLoadingBit;
+				arrQueuedSlots.push_back(uiSlot);
+			}
+		}
+	}
+	if (!arrQueuedSlots.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingSlots.insert(m_pendingSlots.end(), arrQueuedSlots.begin(), arrQueuedSlots.end());
+		}
+		m_cvWork.notify_one();
+	}
+}
+
+/**
+ @brief Write every edited chunk back into the file
+ */
+bool CStreamedLevel::Flush(void)
+{
+	bool bResult = true;
+	for (unsigned int uiSlot = 0; uiSlot < arrSlots.size(); uiSlot++)
+	{
+		Slot& sSlot = arrSlots[uiSlot];
+		if ((sSlot.eState != RESIDENT) || (!sSlot.bDirty))
+			continue;
+		if (WriteChunk(sSlot.uiChunk, &arrSlotTiles[(size_t)uiSlot << (2 * uiChunkShift)]))
+		{
+			sSlot.bDirty = false;
+			uiNumWriteBacks++;
+		}
+		else
+			bResult = false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	file.flush();
+	return bResult && file.good();
+}
+
+/**
+ @brief Read a chunk which is not in memory on the calling thread
+ @param uiChunk A const unsigned int variable containing the chunk
+ */
+unsigned int CStreamedLevel::LoadChunkNow(const unsigned int uiChunk)
+{
+	uiNumMisses++;
+
+	unsigned int uiSlot = arrChunkSlots[uiChunk];
+	if (uiSlot != uiNoSlot)
+	{
+		// The chunk was queued for the worker thread. Take it back if the worker has not started on it,
+		// or else wait for the worker to finish it
+		uiSlot &= ~uiLoadingBit;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		std::deque<unsigned int>::iterator it = std::find(m_pendingSlots.begin(), m_pendingSlots.end(), uiSlot);
+		if (it != m_pendingSlots.end())
+			m_pendingSlots.erase(it);
+		else
+		{
+			m_cvDone.wait(lock, [this, uiSlot] { return m_uiActiveSlot != uiSlot; });
+			InstallLoadedSlots();
+			return uiSlot;
+		}
+	}
+	else
+		uiSlot = AcquireSlot(true);
+
+	int* pTiles = &arrSlotTiles[(size_t)uiSlot << (2 * uiChunkShift)];
+	if (!ReadChunk(uiChunk, pTiles))
+		std::fill(pTiles, pTiles + ((size_t)1 << (2 * uiChunkShift)), 0);
+	const Slot sSlot = { RESIDENT, uiChunk, uiClock, false };
+	arrSlots[uiSlot] = sSlot;
+	arrChunkSlots[uiChunk] = uiSlot;
+	return uiSlot;
+}
+
+/**
+ @brief Get a free slot, evicting the least recently used chunk which was not used in this frame
+ @param bForce A const bool variable which allows a chunk used in this frame to be evicted
+ */
+unsigned int CStreamedLevel::AcquireSlot(const bool bForce)
+{
+	unsigned int uiOldestSlot = uiNoSlot;
+	for (unsigned int uiSlot = 0; uiSlot < arrSlots.size(); uiSlot++)
+	{
+		const Slot& sSlot = arrSlots[uiSlot];
+		if (sSlot.eState == FREE)
+			return uiSlot;
+		if ((sSlot.eState == RESIDENT) &&
+			(bForce || (sSlot.uiLastUsed != uiClock)) &&
+			((uiOldestSlot == uiNoSlot) || (sSlot.uiLastUsed < arrSlots[uiOldestSlot].uiLastUsed)))
+			uiOldestSlot = uiSlot;
+	}
+	if (uiOldestSlot != uiNoSlot)
+		EvictSlot(uiOldestSlot);
+	return uiOldestSlot;
+}
+
+/**
+ @brief Evict the chunk in a slot, writing it back if it was edited
+ @param uiSlot A const unsigned int variable containing the slot
+ */
+void CStreamedLevel::EvictSlot(const unsigned int uiSlot)
+{
+	Slot& sSlot = arrSlots[uiSlot];
+	if (sSlot.bDirty)
+	{
+		if (!WriteChunk(sSlot.uiChunk, &arrSlotTiles[(size_t)uiSlot << (2 * uiChunkShift)]))
+			cout << "CStreamedLevel::EvictSlot() : unable to write chunk " << sSlot.uiChunk << " back" << endl;
+		uiNumWriteBacks++;
+	}
+	arrChunkSlots[sSlot.uiChunk] = uiNoSlot;
+	sSlot.eState = FREE;
+	sSlot.bDirty = false;
+	uiNumEvictions++;
+}
+
+/**
+ @brief Mark the slots read by the worker thread as resident. m_mutex must be held
+ */
+void CStreamedLevel::InstallLoadedSlots(void)
+{
+	for (unsigned int i = 0; i < m_loadedSlots.size(); i++)
+	{
+		Slot& sSlot = arrSlots[m_loadedSlots[i]];
+		sSlot.eState = RESIDENT;
+		arrChunkSlots[sSlot.uiChunk] = m_loadedSlots[i];
+		uiNumLoads++;
+	}
+	m_loadedSlots.clear();
+}
+
+/**
+ @brief Read the tiles of a chunk in the file
+ @param uiChunk A const unsigned int variable containing the chunk
+ @param pTiles An int* variable which will store the tiles
+ */
+bool CStreamedLevel::ReadChunk(const unsigned int uiChunk, int* pTiles)
+{
+	const std::streamsize uiChunkBytes = (std::streamsize)sizeof(int) << (2 * uiChunkShift);
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	file.seekg((std::streamoff)uiHeaderSize + (std::streamoff)uiChunk * uiChunkBytes);
+	file.read((char*)pTiles, uiChunkBytes);
+	if (!file)
+	{
+		file.clear();
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Write the tiles of a chunk in the file
+ @param uiChunk A const unsigned int variable containing the chunk
+ @param pTiles A const int* variable containing the tiles
+ */
+bool CStreamedLevel::WriteChunk(const unsigned int uiChunk, const int* pTiles)
+{
+	const std::streamsize uiChunkBytes = (std::streamsize)sizeof(int) << (2 * uiChunkShift);
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	file.seekp((std::streamoff)uiHeaderSize + (std::streamoff)uiChunk * uiChunkBytes);
+	file.write((const char*)pTiles, uiChunkBytes);
+	if (!file)
+	{
+		file.clear();
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief The loop run by the worker thread
+ */
+void CStreamedLevel::WorkerLoop(void)
+{
+	for (;;)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cvWork.wait(lock, [this] { return m_bStop || !m_pendingSlots.empty(); });
+		if (m_bStop)
+			return;
+		const unsigned int uiSlot = m_pendingSlots.front();
+		m_pendingSlots.pop_front();
+		m_uiActiveSlot = uiSlot;
+		const unsigned int uiChunk = arrSlots[uiSlot].uiChunk;
+		lock.unlock();
+
+		int* pTiles = &arrSlotTiles[(size_t)uiSlot << (2 * uiChunkShift)];
+		if (!ReadChunk(uiChunk, pTiles))
+			std::fill(pTiles, pTiles + ((size_t)1 << (2 * uiChunkShift)), 0);
+
+		lock.lock();
+		m_loadedSlots.push_back(uiSlot);
+		m_uiActiveSlot = uiNoSlot;
+		lock.unlock();
+		m_cvDone.notify_all();
+	}
+}
+
+/**
+ @brief Fill the offsets of the tiles inside a chunk
+ @param uiChunkShift A const unsigned int variable containing the log2 of the chunk size
+ @param eLayout A const LAYOUT variable containing how the tiles are stored inside a chunk
+ @param arrRowOffsets A std::vector<unsigned int>& variable which will store the offset of each row
+ @param arrColOffsets A std::vector<unsigned int>& variable which will store the offset of each column
+ */
+void CStreamedLevel::GetChunkOffsets(const unsigned int uiChunkShift,
+									const LAYOUT eLayout,
+									std::vector<unsigned int>& arrRowOffsets,
+									std::vector<unsigned int>& arrColOffsets)
+{
+	const unsigned int uiChunkSize = 1u << uiChunkShift;
+	arrRowOffsets.resize(uiChunkSize);
+	arrColOffsets.resize(uiChunkSize);
+	for (unsigned int i = 0; i < uiChunkSize; i++)
+	{
+		if (eLayout == MORTON)
+		{
+			// Spread the bits of i apart, so that the column bits and row bits of an offset interleave
+			unsigned int uiSpread = 0;
+			for (unsigned int uiBit = 0; uiBit < uiChunkShift; uiBit++)
+				uiSpread |= ((i >> uiBit) & 1u) << (2 * uiBit);
+			arrRowOffsets[i] = uiSpread << 1;
+			arrColOffsets[i] = uiSpread;
+		}
+		else
+		{
+			arrRowOffsets[i] = i << uiChunkShift;
+			arrColOffsets[i] = i;
+		}
+	}
+}
+
+/**
+ @brief Write the header of a chunk file
+ @param output A std::ofstream& variable containing the file
+ @param uiNumRows A const unsigned int variable containing the number of rows of the level
+ @param uiNumCols A const unsigned int variable containing the number of columns of the level
+ @param uiChunkShift A const unsigned int variable containing the log2 of the chunk size
+ @param eLayout A const LAYOUT variable containing how the tiles are stored inside a chunk
+ @param sSource A const SourceStamp& variable containing the stamp of the CSV file which the level was built from
+ */
+bool CStreamedLevel::WriteHeader(std::ofstream& output,
+								const unsigned int uiNumRows,
+								const unsigned int uiNumCols,
+								const unsigned int uiChunkShift,
+								const LAYOUT eLayout,
+								const SourceStamp& sSource)
+{
+	const unsigned int arrHeader[9] = { uiFileMagic, uiFileVersion, uiNumRows, uiNumCols, uiChunkShift, (unsigned int)eLayout,
+										sSource.uiSizeLow, sSource.uiSizeHigh, sSource.uiHash };
+	output.write((const char*)arrHeader, sizeof(arrHeader));
+	return output.good();
+}
+
+/**
+ @brief Get the log2 of the chunk size to store, rounding it up to a power of 2 within the supported sizes
+ */
+static unsigned int GetChunkShift(const unsigned int uiChunkSize)
+{
+	unsigned int uiChunkShift = uiMinChunkShift;
+	while ((uiChunkShift < uiMaxChunkShift) && ((1u << uiChunkShift) < uiChunkSize))
+		uiChunkShift++;
+	return uiChunkShift;
+}
+
+/**
+ @brief Write a level into a chunk file
+ @param filename A const std::string& variable containing the name of the file
+ @param cLevel A const CMapLevel& variable containing the level
+ @param uiChunkSize A const unsigned int variable containing the number of tiles along each side of a chunk
+ @param eLayout A const LAYOUT variable containing how the tiles are stored inside a chunk
+ @param sSource A const SourceStamp& variable containing the stamp of the CSV file which the level was built from
+ */
+bool CStreamedLevel::Save(const std::string& filename,
+						const CMapLevel& cLevel,
+						const unsigned int uiChunkSize,
+						const LAYOUT eLayout,
+						const SourceStamp& sSource)
+{
+	ofstream output(filename.c_str(), ios::binary | ios::trunc);
+	const unsigned int uiChunkShift = GetChunkShift(uiChunkSize);
+	if ((!output.is_open()) || (!WriteHeader(output, cLevel.GetNumRows(), cLevel.GetNumCols(), uiChunkShift, eLayout, sSource)))
+		return false;
+
+	std::vector<unsigned int> arrRowOffsets, arrColOffsets;
+	GetChunkOffsets(uiChunkShift, eLayout, arrRowOffsets, arrColOffsets);
+	const unsigned int uiChunkMask = (1u << uiChunkShift) - 1;
+	const unsigned int uiNumChunkRows = (cLevel.GetNumRows() + uiChunkMask) >> uiChunkShift;
+	const unsigned int uiNumChunkCols = (cLevel.GetNumCols() + uiChunkMask) >> uiChunkShift;
+	std::vector<int> arrChunk((size_t)1 << (2 * uiChunkShift));
+	for (unsigned int uiChunkRow = 0; uiChunkRow < uiNumChunkRows; uiChunkRow++)
+	{
+		for (unsigned int uiChunkCol = 0; uiChunkCol < uiNumChunkCols; uiChunkCol++)
+		{
+			// The tiles past the edges of the level are 0
+			std::fill(arrChunk.begin(), arrChunk.end(), 0);
+			const unsigned int uiFirstRow = uiChunkRow << uiChunkShift;
+			const unsigned int uiFirstCol = uiChunkCol << uiChunkShift;
+			const unsigned int uiLastRow = std::min(uiFirstRow + uiChunkMask + 1, cLevel.GetNumRows());
+			const unsigned int uiLastCol = std::min(uiFirstCol + uiChunkMask + 1, cLevel.GetNumCols());
+			for (unsigned int uiRow = uiFirstRow; uiRow < uiLastRow; uiRow++)
+			{
+				for (unsigned int uiCol = uiFirstCol; uiCol < uiLastCol; uiCol++)
+					arrChunk[arrRowOffsets[uiRow - uiFirstRow] + arrColOffsets[uiCol - uiFirstCol]] = cLevel.GetTile(uiRow, uiCol, false);
+			}
+			output.write((const char*)arrChunk.data(), arrChunk.size() * sizeof(int));
+		}
+	}
+	return output.good();
+}
+
+/**
+ @brief Write a level whose tiles all hold one value into a chunk file
+ @param filename A const std::string& variable containing the name of the file
+ @param uiNumRows A const unsigned int variable containing the number of rows of the level
+ @param uiNumCols A const unsigned int variable containing the number of columns of the level
+ @param iValue A const int variable containing the value of every tile
+ @param uiChunkSize A const unsigned int variable containing the number of tiles along each side of a chunk
+ @param eLayout A const LAYOUT variable containing how the tiles are stored inside a chunk
+ */
+bool CStreamedLevel::Create(const std::string& filename,
+							const unsigned int uiNumRows,
+							const unsigned int uiNumCols,
+							const int iValue,
+							const unsigned int uiChunkSize,
+							const LAYOUT eLayout)
+{
+	ofstream output(filename.c_str(), ios::binary | ios::trunc);
+	const unsigned int uiChunkShift = GetChunkShift(uiChunkSize);
+	if ((!output.is_open()) || (!WriteHeader(output, uiNumRows, uiNumCols, uiChunkShift, eLayout, SourceStamp())))
+		return false;
+
+	const unsigned int uiChunkMask = (1u << uiChunkShift) - 1;
+	const unsigned long long ullNumChunks = (unsigned long long)((uiNumRows + uiChunkMask) >> uiChunkShift) *
+											((uiNumCols + uiChunkMask) >> uiChunkShift);
+	const std::vector<int> arrChunk((size_t)1 << (2 * uiChunkShift), iValue);
+	for (unsigned long long i = 0; (i < ullNumChunks) && output.good(); i++)
+		output.write((const char*)arrChunk.data(), arrChunk.size() * sizeof(int));
+	return output.good();
+}
+
+/**
+ @brief Check if a chunk file exists, and was built from its CSV file as it is now
+ @param filename A const std::string& variable containing the name of the chunk file
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ */
+bool CStreamedLevel::IsUpToDate(const std::string& filename, const std::string& csvFilename)
+{
+	ifstream input(filename.c_str(), ios::binary);
+	unsigned int arrHeader[9] = { 0 };
+	input.read((char*)arrHeader, sizeof(arrHeader));
+	if ((!input) || (arrHeader[0] != uiFileMagic) || (arrHeader[1] != uiFileVersion))
+		return false;
+
+	// A chunk file without a CSV file is all there is
+	SourceStamp sStamp;
+	if (!CLevelFile::GetSourceStamp(csvFilename, sStamp))
+		return true;
+	return (sStamp.uiSizeLow == arrHeader[6]) && (sStamp.uiSizeHigh == arrHeader[7]) && (sStamp.uiHash == arrHeader[8]);
+}
+
+/**
+ @brief Get the name of the chunk file which belongs to a CSV file, by replacing its extension with ".chunks"
+ @param csvFilename A const std::string& variable containing the name of the CSV file
+ */
+std::string CStreamedLevel::GetFilename(const std::string& csvFilename)
+{
+	const size_t uiDot = csvFilename.find_last_of('.');
+	const size_t uiSlash = csvFilename.find_last_of("/\\");
+	if ((uiDot == string::npos) || ((uiSlash != string::npos) && (uiDot < uiSlash)))
+		return csvFilename + ".chunks";
+	return csvFilename.substr(0, uiDot) + ".chunks";
+}
+
+/**
+ @brief Print out the details about this class instance in the console
+ */
+void CStreamedLevel::PrintSelf(void) const
+{
+	cout << "CStreamedLevel::PrintSelf()" << endl;
+	cout << "Size: " << uiNumCols << "x" << uiNumRows << ", chunks of " << GetChunkSize() << "x" << GetChunkSize()
+		<< (eLayout == MORTON ? " in Morton order" : " row by row") << endl;
+	cout << "Chunks in memory: " << arrSlots.size() << " (" << arrSlotTiles.size() * sizeof(int) << " bytes)" << endl;
+	cout << "Chunks read ahead: " << uiNumLoads << ", read at once: " << uiNumMisses
+		<< ", evicted: " << uiNumEvictions << ", written back: " << uiNumWriteBacks << endl;
+}
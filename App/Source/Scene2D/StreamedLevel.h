@@ -0,0 +1,226 @@
+/**
+ CStreamedLevel
+ @brief A class which stores a level in a chunk file of fixed-size square chunks, and keeps only the chunks
+		around a focus tile in memory. A worker thread reads the chunks around the focus before they are needed,
+		the chunks furthest from use are evicted when the memory budget is reached, and edited chunks are
+		written back into the file when they are evicted. The tiles inside a chunk can be stored in Morton order,
+		so that neighbouring tiles are close together in memory whichever way they neighbour.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+// Include LevelFile for the stamp of the CSV file which a chunk file was built from
+#include "LevelFile.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CStreamedLevel
+{
+public:
+	// How the tiles are stored inside a chunk
+	enum LAYOUT
+	{
+		ROW_MAJOR = 0,
+		MORTON,
+		NUM_LAYOUTS
+	};
+
+	// Constructor
+	CStreamedLevel(void);
+
+	// Destructor, which closes the file
+	~CStreamedLevel(void);
+
+	// Open a chunk file, and keep at most uiMemoryBudget bytes of chunks in memory.
+	// The chunks up to uiLoadRadius chunks away from the focus are read ahead by a worker thread.
+	// Returns false if it cannot be opened, or it is not a chunk file of this version
+	bool Open(const std::string& filename, const size_t uiMemoryBudget, const unsigned int uiLoadRadius = 2);
+	// Write the edited chunks back, stop the worker thread and close the file
+	void Close(void);
+
+	// Check if a chunk file is open
+	bool IsOpen(void) const;
+
+	// Get the size of the level
+	unsigned int GetNumRows(void) const { return uiNumRows; }
+	unsigned int GetNumCols(void) const { return uiNumCols; }
+	// Get the number of tiles along each side of a chunk
+	unsigned int GetChunkSize(void) const { return 1u << uiChunkShift; }
+	// Get the layout of the tiles inside a chunk
+	LAYOUT GetLayout(void) const { return eLayout; }
+
+	// Get the value of a tile. A chunk which is not in memory is read at once
+	int GetTile(unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true)
+	{
+		if (bInvert)
+			uiRow = uiNumRows - uiRow - 1;
+		return GetChunkTiles(uiRow, uiCol)[arrRowOffsets[uiRow & uiChunkMask] + arrColOffsets[uiCol & uiChunkMask]];
+	}
+	// Set the value of a tile. Its chunk is written back when it is evicted, or by Flush()
+	void SetTile(unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert = true)
+	{
+		if (bInvert)
+			uiRow = uiNumRows - uiRow - 1;
+		GetChunkTiles(uiRow, uiCol)[arrRowOffsets[uiRow & uiChunkMask] + arrColOffsets[uiCol & uiChunkMask]] = iValue;
+		arrSlots[arrChunkSlots[(uiRow >> uiChunkShift) * uiNumChunkCols + (uiCol >> uiChunkShift)]].bDirty = true;
+	}
+	// Check if a tile is blocked
+	bool IsBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true)
+	{
+		return tiletype::IsBlocking(GetTile(uiRow, uiCol, bInvert));
+	}
+
+	// Set the tile around which the chunks are kept in memory
+	void SetFocus(unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true);
+	// Called once per frame: take the chunks read by the worker thread, and queue the chunks around the focus
+	// which are not in memory yet, evicting the least recently used chunks to make room for them
+	void Update(void);
+	// Write every edited chunk back into the file
+	bool Flush(void);
+
+	// Get the number of chunks read by the worker thread, read at once because they were not in memory,
+	// evicted, and written back, so far
+	unsigned int GetNumLoads(void) const { return uiNumLoads; }
+	unsigned int GetNumMisses(void) const { return uiNumMisses; }
+	unsigned int GetNumEvictions(void) const { return uiNumEvictions; }
+	unsigned int GetNumWriteBacks(void) const { return uiNumWriteBacks; }
+	// Get the number of chunks which fit in the memory budget
+	unsigned int GetNumSlots(void) const { return (unsigned int)arrSlots.size(); }
+
+	// Write a level into a chunk file, with the stamp of the CSV file it was built from. The chunk size is rounded up to a power of 2
+	static bool Save(const std::string& filename,
+					const CMapLevel& cLevel,
+					const unsigned int uiChunkSize = 32,
+					const LAYOUT eLayout = MORTON,
+					const SourceStamp& sSource = SourceStamp());
+	// Write a level whose tiles all hold one value into a chunk file, without keeping the level in memory
+	static bool Create(const std::string& filename,
+						const unsigned int uiNumRows,
+						const unsigned int uiNumCols,
+						const int iValue,
+						const unsigned int uiChunkSize = 32,
+						const LAYOUT eLayout = MORTON);
+
+	// Check if a chunk file exists, and was built from the CSV file as it is now, if there is one
+	static bool IsUpToDate(const std::string& filename, const std::string& csvFilename);
+	// Get the name of the chunk file which belongs to a CSV file
+	static std::string GetFilename(const std::string& csvFilename);
+
+	// Print out details about this class instance in the console window
+	void PrintSelf(void) const;
+
+protected:
+	// What a slot of chunk memory holds
+	enum SLOTSTATE
+	{
+		FREE = 0,
+		LOADING,
+		RESIDENT
+	};
+	struct Slot
+	{
+		SLOTSTATE eState;
+		// The chunk in this slot
+		unsigned int uiChunk;
+		// The frame in which the chunk was last used
+		unsigned int uiLastUsed;
+		// Set when a tile of the chunk was changed after it was read
+		bool bDirty;
+	};
+
+	// The open chunk file. It is shared with the worker thread, behind m_fileMutex
+	std::fstream file;
+	std::mutex m_fileMutex;
+
+	// The size of the level, and of its chunks
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+	unsigned int uiChunkShift;
+	unsigned int uiChunkMask;
+	unsigned int uiNumChunkRows;
+	unsigned int uiNumChunkCols;
+	LAYOUT eLayout;
+	// The position of a tile inside its chunk is arrRowOffsets[row] + arrColOffsets[column], for either layout
+	std::vector<unsigned int> arrRowOffsets;
+	std::vector<unsigned int> arrColOffsets;
+
+	// The memory for the chunks, one slot after another, and what each slot holds
+	std::vector<int> arrSlotTiles;
+	std::vector<Slot> arrSlots;
+	// The slot of each chunk which is in memory, the slot with uiLoadingBit set if the worker thread is reading it, or uiNoSlot
+	std::vector<unsigned int> arrChunkSlots;
+	static const unsigned int uiNoSlot = 0xFFFFFFFF;
+	static const unsigned int uiLoadingBit = 0x80000000;
+
+	// The focus chunk, how far from it the chunks are read ahead, and the frame counter for the least recently used chunks
+	unsigned int uiFocusChunkRow;
+	unsigned int uiFocusChunkCol;
+	unsigned int uiLoadRadius;
+	unsigned int uiClock;
+
+	// The worker thread, which reads the slots queued in m_pendingSlots and hands them back in m_loadedSlots
+	std::thread cWorker;
+	// Guards m_pendingSlots, m_loadedSlots, m_uiActiveSlot and m_bStop
+	std::mutex m_mutex;
+	// Wakes the worker when a chunk is queued
+	std::condition_variable m_cvWork;
+	// Wakes the main thread when a chunk has been read
+	std::condition_variable m_cvDone;
+	std::deque<unsigned int> m_pendingSlots;
+	std::vector<unsigned int> m_loadedSlots;
+	// The slot the worker is reading, or uiNoSlot
+	unsigned int m_uiActiveSlot;
+	bool m_bStop;
+
+	// Counters
+	unsigned int uiNumLoads;
+	unsigned int uiNumMisses;
+	unsigned int uiNumEvictions;
+	unsigned int uiNumWriteBacks;
+
+	// Get the tiles of the chunk holding a tile, whose row is not inverted, reading the chunk at once if it is not in memory
+	int* GetChunkTiles(const unsigned int uiRow, const unsigned int uiCol)
+	{
+		const unsigned int uiChunk = (uiRow >> uiChunkShift) * uiNumChunkCols + (uiCol >> uiChunkShift);
+		unsigned int uiSlot = arrChunkSlots[uiChunk];
+		if (uiSlot >= uiLoadingBit)
+			uiSlot = LoadChunkNow(uiChunk);
+		arrSlots[uiSlot].uiLastUsed = uiClock;
+		return &arrSlotTiles[(size_t)uiSlot << (2 * uiChunkShift)];
+	}
+	// Read a chunk which is not in memory on the calling thread, and return its slot
+	unsigned int LoadChunkNow(const unsigned int uiChunk);
+	// Get a free slot, evicting the least recently used chunk which was not used in this frame.
+	// Returns uiNoSlot if every chunk was used in this frame, unless bForce is true
+	unsigned int AcquireSlot(const bool bForce);
+	// Evict the chunk in a slot, writing it back if it was edited
+	void EvictSlot(const unsigned int uiSlot);
+	// Mark the slots read by the worker thread as resident. m_mutex must be held
+	void InstallLoadedSlots(void);
+	// Read or write the tiles of a chunk in the file
+	bool ReadChunk(const unsigned int uiChunk, int* pTiles);
+	bool WriteChunk(const unsigned int uiChunk, const int* pTiles);
+	// The loop run by the worker thread
+	void WorkerLoop(void);
+	// Fill the offsets of the tiles inside a chunk
+	static void GetChunkOffsets(const unsigned int uiChunkShift,
+								const LAYOUT eLayout,
+								std::vector<unsigned int>& arrRowOffsets,
+								std::vector<unsigned int>& arrColOffsets);
+	// Write the header of a chunk file
+	static bool WriteHeader(std::ofstream& output,
+							const unsigned int uiNumRows,
+							const unsigned int uiNumCols,
+							const unsigned int uiChunkShift,
+							const LAYOUT eLayout,
+							const SourceStamp& sSource);
+};
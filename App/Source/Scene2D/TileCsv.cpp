@@ -0,0 +1,442 @@
+/**
+ TileCsv
+ @brief Functions which read and write the CSV files of tile maps without a std::string per cell.
+		A file is read into one buffer, its delimiters are found 16 bytes at a time with SSE2,
+		and the integers are parsed where they lie. The first line holds the column labels, e.g. "//1,2,3,...".
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "TileCsv.h"
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+// SSE2 is always there on x64, and on x86 when the compiler is allowed to use it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define TILECSV_SSE2
+	#include <emmintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
+#endif
+
+using namespace std;
+
+namespace
+{
+	// Where a parse is: the start of the current cell, and the row and column the next value goes to
+	struct ParseState
+	{
+		const char* pCellBegin;
+		int* pTiles;
+		unsigned int uiNumRows;
+		unsigned int uiNumCols;
+		unsigned int uiRow;
+		unsigned int uiCol;
+		bool bError;
+	};
+
+	// The number of characters parsed at a time. The positions of their delimiters are kept in an array on the stack
+	const unsigned int uiChunkSize = 4096;
+
+#ifdef TILECSV_SSE2
+	// Get the position of the lowest set bit of a non-zero mask
+	inline unsigned int LowestBit(const unsigned int uiMask)
+	{
+#ifdef _MSC_VER
+		unsigned long ulIndex;
+		_BitScanForward(&ulIndex, uiMask);
+		return (unsigned int)ulIndex;
+#else
+		return (unsigned int)__builtin_ctz(uiMask);
+#endif
+	}
+
+	// Get the number of set bits of a 16 bit mask. POPCNT is not part of SSE2
+	inline unsigned int CountBits(unsigned int uiMask)
+	{
+		uiMask = uiMask - ((uiMask >> 1) & 0x5555u);
+		uiMask = (uiMask & 0x3333u) + ((uiMask >> 2) & 0x3333u);
+		uiMask = (uiMask + (uiMask >> 4)) & 0x0F0Fu;
+		return (uiMask + (uiMask >> 8)) & 0x1Fu;
+	}
+#endif
+
+	// Store the positions of the commas and new lines from pBegin to pEnd, relative to pBegin, in puiDelimiters,
+	// which must have room for 8 more than (pEnd - pBegin) of them. brPlain is set to false if there is any character
+	// other than a digit, a comma or a new line. Returns the number of delimiters
+	inline unsigned int FindDelimiters(const char* pBegin, const char* pEnd, unsigned int* puiDelimiters, bool& brPlain)
+	{
+		unsigned int uiNumDelimiters = 0;
+		unsigned int uiOthers = 0;
+		const char* p = pBegin;
+#ifdef TILECSV_SSE2
+		// Find the delimiters of 16 bytes at once. A cell takes at least 2 bytes with its delimiter,
+		// so there are at most 8 of them unless there are empty cells, and 8 positions are written without a branch
+		const __m128i vComma = _mm_set1_epi8(',');
+		const __m128i vNewLine = _mm_set1_epi8('\n');
+		const __m128i vBeforeZero = _mm_set1_epi8('0' - 1);
+		const __m128i vAfterNine = _mm_set1_epi8('9' + 1);
+		for (; pEnd - p >= 16; p += 16)
+		{
+			const __m128i vBytes = _mm_loadu_si128((const __m128i*)p);
+			const __m128i vDelimiters = _mm_or_si128(_mm_cmpeq_epi8(vBytes, vComma), _mm_cmpeq_epi8(vBytes, vNewLine));
+			const __m128i vDigits = _mm_and_si128(_mm_cmpgt_epi8(vBytes, vBeforeZero), _mm_cmplt_epi8(vBytes, vAfterNine));
+			const unsigned int uiMask = (unsigned int)_mm_movemask_epi8(vDelimiters);
+			uiOthers |= (unsigned int)_mm_movemask_epi8(_mm_or_si128(vDelimiters, vDigits)) ^ 0xFFFFu;
+
+			const unsigned int uiOffset = (unsigned int)(p - pBegin);
+			unsigned int* puiOut = puiDelimiters + uiNumDelimiters;
+			unsigned int uiBits = uiMask;
+			for (unsigned int i = 0; i < 8; i++)
+			{
+				// Bit 16 stops LowestBit from seeing an empty mask once the delimiters run out
+				puiOut[i] = uiOffset + LowestBit(uiBits | 0x10000u);
+				uiBits &= uiBits - 1;
+			}
+			const unsigned int uiCount = CountBits(uiMask);
+			for (unsigned int i = 8; i < uiCount; i++)
+			{
+				puiOut[i] = uiOffset + LowestBit(uiBits);
+				uiBits &= uiBits - 1;
+			}
+			uiNumDelimiters += uiCount;
+		}
+#endif
+		for (; p < pEnd; p++)
+		{
+			if ((*p == ',') || (*p == '\n'))
+				puiDelimiters[uiNumDelimiters++] = (unsigned int)(p - pBegin);
+			else if ((*p < '0') || (*p > '9'))
+				uiOthers = 1;
+		}
+		brPlain = (uiOthers == 0);
+		return uiNumDelimiters;
+	}
+
+	// Get the end of the line starting at pLine, without its '\r'. pNext is set to the start of the next line
+	inline const char* FindLineEnd(const char* pLine, const char* pTextEnd, const char*& prNext)
+	{
+		const char* pNewLine = (const char*)memchr(pLine, '\n', pTextEnd - pLine);
+		prNext = pNewLine ? pNewLine + 1 : pTextEnd;
+		const char* pLineEnd = pNewLine ? pNewLine : pTextEnd;
+		if ((pLineEnd > pLine) && (pLineEnd[-1] == '\r'))
+			pLineEnd--;
+		return pLineEnd;
+	}
+
+	// Get the start of the tiles, after the byte order mark and the line of column labels
+	inline const char* SkipColumnLabels(const char* pText, const char* pTextEnd, std::string* pColumnLabels)
+	{
+		if ((pTextEnd - pText >= 3) && (memcmp(pText, "\xEF\xBB\xBF", 3) == 0))
+			pText += 3;
+		const char* pNext;
+		const char* pLabelsEnd = FindLineEnd(pText, pTextEnd, pNext);
+		if (pColumnLabels)
+			pColumnLabels->assign(pText, pLabelsEnd);
+		return pNext;
+	}
+
+	// The bytes of a word which hold the digits of a value of 1 to 4 digits, and the '0's put in front of them
+	const unsigned int arrDigitBytes[5] = { 0, 0xFF000000u, 0xFFFF0000u, 0xFFFFFF00u, 0xFFFFFFFFu };
+	const unsigned int arrZeroBytes[5] = { 0x30303030u, 0x00303030u, 0x00003030u, 0x00000030u, 0 };
+
+	// Parse a value of 1 to 4 digits which ends at pCellEnd, without a branch per digit. The 4 bytes before pCellEnd
+	// are loaded into a little-endian word, so the digits are in its top bytes, and the bytes before them become '0's.
+	// The digits must have been checked already
+	inline int ParseShortValue(const char* pCellEnd, const size_t uiNumDigits)
+	{
+		unsigned int uiWord;
+		memcpy(&uiWord, pCellEnd - 4, 4);
+		uiWord = ((uiWord & arrDigitBytes[uiNumDigits]) | arrZeroBytes[uiNumDigits]) & 0x0F0F0F0Fu;
+		uiWord = ((uiWord * 10) + (uiWord >> 8)) & 0x00FF00FFu;
+		return (int)(((uiWord * 100) + (uiWord >> 16)) & 0x0000FFFFu);
+	}
+
+	// Parse the cell which ends at pCellEnd, where bLineEnd tells if the delimiter is a new line
+	inline void EndCell(ParseState& sState, const char* pCellEnd, const bool bLineEnd)
+	{
+		const char* pBegin = sState.pCellBegin;
+		sState.pCellBegin = pCellEnd + 1;
+		if ((pCellEnd > pBegin) && (pCellEnd[-1] == '\r'))
+			pCellEnd--;
+
+		if (pCellEnd == pBegin)
+		{
+			// An empty cell can only be a blank line, or follow a comma after the last value of a row
+			if ((!bLineEnd) || ((sState.uiCol != 0) && (sState.uiCol != sState.uiNumCols)))
+				sState.bError = true;
+			else if (sState.uiCol != 0)
+			{
+				sState.uiRow++;
+				sState.uiCol = 0;
+			}
+			return;
+		}
+		if ((sState.uiRow >= sState.uiNumRows) || (sState.uiCol >= sState.uiNumCols))
+		{
+			sState.bError = true;
+			return;
+		}
+
+		bool bNegative = false;
+		if (*pBegin == '-')
+		{
+			bNegative = true;
+			pBegin++;
+		}
+		unsigned int uiValue = 0;
+		for (const char* p = pBegin; p < pCellEnd; p++)
+		{
+			const unsigned int uiDigit = (unsigned int)(unsigned char)*p - '0';
+			if (uiDigit > 9)
+			{
+				sState.bError = true;
+				return;
+			}
+			uiValue = uiValue * 10 + uiDigit;
+		}
+		if (pBegin == pCellEnd)
+		{
+			sState.bError = true;
+			return;
+		}
+		sState.pTiles[sState.uiRow * sState.uiNumCols + sState.uiCol] = bNegative ? -(int)uiValue : (int)uiValue;
+		sState.uiCol++;
+
+		if (bLineEnd)
+		{
+			if (sState.uiCol != sState.uiNumCols)
+				sState.bError = true;
+			sState.uiRow++;
+			sState.uiCol = 0;
+		}
+	}
+
+	// Write an integer at p, and get the position after it
+	inline char* FormatInt(char* p, const int iValue)
+	{
+		unsigned int uiValue = (unsigned int)iValue;
+		if (iValue < 0)
+		{
+			*p++ = '-';
+			uiValue = 0u - uiValue;
+		}
+		char arrDigits[10];
+		unsigned int uiNumDigits = 0;
+		do
+		{
+			arrDigits[uiNumDigits++] = (char)('0' + uiValue % 10);
+			uiValue /= 10;
+		} while (uiValue > 0);
+		while (uiNumDigits > 0)
+			*p++ = arrDigits[--uiNumDigits];
+		return p;
+	}
+}
+
+/**
+ @brief Read a whole file into a buffer
+ @param filename A const std::string& variable containing the name of the file
+ @param buffer A std::vector<char>& variable which will store the text, and only grows
+ @param uirSize A size_t& variable which will store the number of characters read
+ */
+bool tilecsv::ReadFile(const std::string& filename, std::vector<char>& buffer, size_t& uirSize)
+{
+	ifstream file(filename.c_str(), ios::binary | ios::ate);
+	if (!file.is_open())
+		return false;
+
+	const streamoff iSize = file.tellg();
+	if (iSize < 0)
+		return false;
+	uirSize = (size_t)iSize;
+	if (buffer.size() < uirSize)
+		buffer.resize(uirSize);
+	file.seekg(0);
+	return uirSize == 0 || (bool)file.read(buffer.data(), uirSize);
+}
+
+/**
+ @brief Write a text into a file
+ @param filename A const std::string& variable containing the name of the file
+ @param pText A const char* variable containing the text
+ @param uiSize A const size_t variable containing the number of characters to write
+ */
+bool tilecsv::WriteFile(const std::string& filename, const char* pText, const size_t uiSize)
+{
+	ofstream file(filename.c_str(), ios::binary | ios::trunc);
+	if (!file.is_open())
+		return false;
+	file.write(pText, uiSize);
+	return file.good();
+}
+
+/**
+ @brief Get the number of rows and columns of the tiles in a CSV text. The columns are counted in the first row
+ @param pText A const char* variable containing the text
+ @param uiSize A const size_t variable containing the number of characters in the text
+ @param uirNumRows An unsigned int& variable which will store the number of rows
+ @param uirNumCols An unsigned int& variable which will store the number of columns
+ */
+bool tilecsv::GetSize(const char* pText, const size_t uiSize, unsigned int& uirNumRows, unsigned int& uirNumCols)
+{
+	const char* pTextEnd = pText + uiSize;
+	const char* pLine = SkipColumnLabels(pText, pTextEnd, NULL);
+
+	uirNumRows = 0;
+	uirNumCols = 0;
+	while (pLine < pTextEnd)
+	{
+		const char* pNext;
+		const char* pLineEnd = FindLineEnd(pLine, pTextEnd, pNext);
+		if (pLineEnd > pLine)
+		{
+			if (uirNumRows == 0)
+			{
+				uirNumCols = 1;
+				for (const char* p = pLine; p < pLineEnd; p++)
+				{
+					if (*p == ',')
+						uirNumCols++;
+				}
+				// A comma after the last value does not start another column
+				if (pLineEnd[-1] == ',')
+					uirNumCols--;
+			}
+			uirNumRows++;
+		}
+		pLine = pNext;
+	}
+	return uirNumRows > 0;
+}
+
+/**
+ @brief Parse the tiles in a CSV text
+ @param pText A const char* variable containing the text
+ @param uiSize A const size_t variable containing the number of characters in the text
+ @param uiNumRows A const unsigned int variable containing the number of rows expected
+ @param uiNumCols A const unsigned int variable containing the number of columns expected
+ @param pTiles An int* variable which will store the tiles
+ @param pColumnLabels A std::string* variable which will store the line of column labels, if it is not NULL
+ */
+bool tilecsv::Parse(const char* pText,
+					const size_t uiSize,
+					const unsigned int uiNumRows,
+					const unsigned int uiNumCols,
+					int* pTiles,
+					std::string* pColumnLabels)
+{
+	const char* pTextEnd = pText + uiSize;
+	const char* p = SkipColumnLabels(pText, pTextEnd, pColumnLabels);
+
+	ParseState sState;
+	sState.pCellBegin = p;
+	sState.pTiles = pTiles;
+	sState.uiNumRows = uiNumRows;
+	sState.uiNumCols = uiNumCols;
+	sState.uiRow = 0;
+	sState.uiCol = 0;
+	sState.bError = false;
+
+	// Find the delimiters of a chunk first, then parse the cell before each of them,
+	// so that neither loop has a branch which depends on where the delimiters are
+	unsigned int arrDelimiters[uiChunkSize + 8];
+	while (p < pTextEnd)
+	{
+		const char* pChunkEnd = (pTextEnd - p > (ptrdiff_t)uiChunkSize) ? p + uiChunkSize : pTextEnd;
+		bool bPlain;
+		const unsigned int uiNumDelimiters = FindDelimiters(p, pChunkEnd, arrDelimiters, bPlain);
+		if ((!bPlain) || (uiNumDelimiters == 0))
+		{
+			// Anything other than digits, commas and new lines is checked cell by cell
+			for (unsigned int i = 0; i < uiNumDelimiters; i++)
+				EndCell(sState, p + arrDelimiters[i], p[arrDelimiters[i]] == '\n');
+		}
+		else
+		{
+			// The first cell may start in the last chunk, whose characters were not checked with this one
+			EndCell(sState, p + arrDelimiters[0], p[arrDelimiters[0]] == '\n');
+
+			// Most cells are a value of 1 to 4 digits followed by a comma. The rest go through EndCell.
+			// The state is kept in locals in between, so that it stays in registers
+			const char* pCellBegin = sState.pCellBegin;
+			int* pOut = NULL;
+			int* pRowEnd = NULL;
+			if (sState.uiRow < uiNumRows)
+			{
+				pOut = pTiles + sState.uiRow * uiNumCols + sState.uiCol;
+				pRowEnd = pTiles + (sState.uiRow + 1) * uiNumCols;
+			}
+			for (unsigned int i = 1; i < uiNumDelimiters; i++)
+			{
+				const char* pDelimiter = p + arrDelimiters[i];
+				const size_t uiNumDigits = pDelimiter - pCellBegin;
+				if ((*pDelimiter == ',') && (uiNumDigits - 1 < 4) && (pDelimiter - pText >= 4) && (pOut < pRowEnd))
+					*pOut++ = ParseShortValue(pDelimiter, uiNumDigits);
+				else
+				{
+					sState.pCellBegin = pCellBegin;
+					if (pRowEnd)
+						sState.uiCol = uiNumCols - (unsigned int)(pRowEnd - pOut);
+					EndCell(sState, pDelimiter, *pDelimiter == '\n');
+					if (sState.uiRow < uiNumRows)
+					{
+						pOut = pTiles + sState.uiRow * uiNumCols + sState.uiCol;
+						pRowEnd = pTiles + (sState.uiRow + 1) * uiNumCols;
+					}
+					else
+						pOut = pRowEnd = NULL;
+				}
+				pCellBegin = pDelimiter + 1;
+			}
+			sState.pCellBegin = pCellBegin;
+			if (pRowEnd)
+				sState.uiCol = uiNumCols - (unsigned int)(pRowEnd - pOut);
+		}
+		if (sState.bError)
+			return false;
+		p = pChunkEnd;
+	}
+	// The last line may not end with a new line
+	EndCell(sState, pTextEnd, true);
+
+	return (!sState.bError) && (sState.uiRow == uiNumRows);
+}
+
+/**
+ @brief Format the line of column labels and the tiles into a CSV text
+ @param pTiles A const int* variable containing the tiles, row by row in CSV order
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ @param columnLabels A const std::string& variable containing the line of column labels
+ @param buffer A std::vector<char>& variable which will store the text, and only grows
+ */
+size_t tilecsv::Format(const int* pTiles,
+						const unsigned int uiNumRows,
+						const unsigned int uiNumCols,
+						const std::string& columnLabels,
+						std::vector<char>& buffer)
+{
+	// An int takes at most 11 characters, and is followed by a comma or a new line
+	const size_t uiMaxSize = columnLabels.size() + 1 + (size_t)uiNumRows * uiNumCols * 12;
+	if (buffer.size() < uiMaxSize)
+		buffer.resize(uiMaxSize);
+
+	char* p = buffer.data();
+	memcpy(p, columnLabels.data(), columnLabels.size());
+	p += columnLabels.size();
+	*p++ = '\n';
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			p = FormatInt(p, *pTiles++);
+			*p++ = ',';
+		}
+		if (uiNumCols > 0)
+			p[-1] = '\n';
+	}
+	return (size_t)(p - buffer.data());
+}
@@ -0,0 +1,44 @@
+/**
+ TileCsv
+ @brief Functions which read and write the CSV files of tile maps without a std::string per cell.
+		A file is read into one buffer, its delimiters are found 16 bytes at a time with SSE2,
+		and the integers are parsed where they lie. The first line holds the column labels, e.g. "//1,2,3,...".
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tilecsv
+{
+	// Read a whole file into buffer, which only ever grows, so that the caller can reuse it between files.
+	// Returns false if the file cannot be read
+	bool ReadFile(const std::string& filename, std::vector<char>& buffer, size_t& uirSize);
+
+	// Write the first uiSize characters of pText into a file
+	bool WriteFile(const std::string& filename, const char* pText, const size_t uiSize);
+
+	// Get the number of rows and columns of the tiles in a CSV text, without the line of column labels
+	bool GetSize(const char* pText, const size_t uiSize, unsigned int& uirNumRows, unsigned int& uirNumCols);
+
+	// Parse the tiles in a CSV text into pTiles, row by row in CSV order like CMapLevel::GetTiles(),
+	// and store the line of column labels in pColumnLabels if it is given.
+	// Returns false if a cell is not an integer, or the text does not have this number of rows and columns.
+	// Blank lines, and a comma at the end of a line, are skipped
+	bool Parse(const char* pText,
+				const size_t uiSize,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols,
+				int* pTiles,
+				std::string* pColumnLabels = NULL);
+
+	// Format the line of column labels and the tiles into a CSV text in buffer, which only ever grows.
+	// Returns the number of characters written
+	size_t Format(const int* pTiles,
+					const unsigned int uiNumRows,
+					const unsigned int uiNumCols,
+					const std::string& columnLabels,
+					std::vector<char>& buffer);
+}
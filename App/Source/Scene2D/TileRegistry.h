@@ -0,0 +1,179 @@
+/**
+ TileRegistry
+ @brief The types of the tiles in the maps, in one table. Each type has the values it is stored as, its flags,
+		the handler which the entities run when they step on it, and its texture. A lookup table with an entry
+		for each value is built from the table at compile time, so checking a value is one table load.
+		Adding a type of tile means adding a row to arrTileTypes, and a case to the entities which handle it.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace tiletype
+{
+	// The values of the tiles in the map CSV files
+	enum VALUE
+	{
+		EMPTY = 0,
+		FLARE = 2,				// A flare which the player can pick up
+		FLARE_DROPPED = 3,		// A flare dropped by the player, which lures the enemies
+		CEREAL = 4,				// A cereal which the player can pick up
+		CEREAL_DROPPED = 5,		// A cereal dropped by the player, which stuns the enemies
+		LIFE = 10,
+		SPIKES = 20,
+		SPA = 21,
+		EXIT = 99,				// The win zone, which the pet has to reach
+		WALL = 100,				// The walls are the values from WALL to WALL_LAST
+		WALL_LAST = 199,
+		PLAYER_SPAWN = 200,
+		ENEMY_SPAWN = 300,
+		PET_SPAWN = 400
+	};
+
+	// The flags of a type of tile
+	enum FLAG
+	{
+		FLAG_BLOCKING = 1 << 0,		// Nothing can walk through it. These are kept in the collision layer of CMapLevel
+		FLAG_COLLECTIBLE = 1 << 1,	// It is picked up by whoever steps on it
+		FLAG_HAZARD = 1 << 2,		// It hurts or stops whoever steps on it
+		FLAG_SPAWN = 1 << 3,		// An entity starts on it, and it is cleared once the entity is spawned
+		FLAG_EXIT = 1 << 4			// Reaching it wins the level
+	};
+
+	// What an entity does when it steps on a type of tile. Each entity only handles the ones which concern it
+	enum HANDLER
+	{
+		HANDLER_NONE = 0,
+		HANDLER_PICK_UP_FLARE,
+		HANDLER_PICK_UP_CEREAL,
+		HANDLER_EAT_FLARE,
+		HANDLER_EAT_CEREAL,
+		HANDLER_ADD_LIFE,
+		HANDLER_DAMAGE,
+		HANDLER_HEAL,
+		HANDLER_WIN
+	};
+
+	// A type of tile, stored as the values from iFirstValue to iLastValue
+	struct TileType
+	{
+		int iFirstValue;
+		int iLastValue;
+		unsigned int uiFlags;
+		HANDLER eHandler;
+		// The texture drawn for it, or NULL if it is not drawn
+		const char* pTextureFile;
+	};
+
+	// The types of tiles. The first row is used for the values which are not in the table
+	constexpr TileType arrTileTypes[] =
+	{
+		// Values,						Flags,								Handler,				Texture
+		{ EMPTY, EMPTY,					0,									HANDLER_NONE,			NULL },
+		{ FLARE, FLARE,					FLAG_COLLECTIBLE,					HANDLER_PICK_UP_FLARE,	"Image/Flare.tga" },
+		{ FLARE_DROPPED, FLARE_DROPPED,	FLAG_COLLECTIBLE,					HANDLER_EAT_FLARE,		"Image/Flare.tga" },
+		{ CEREAL, CEREAL,				FLAG_COLLECTIBLE,					HANDLER_PICK_UP_CEREAL,	"Image/Cornflakes.tga" },
+		{ CEREAL_DROPPED, CEREAL_DROPPED, FLAG_HAZARD,						HANDLER_EAT_CEREAL,		"Image/Cornflakes.tga" },
+		{ LIFE, LIFE,					FLAG_COLLECTIBLE,					HANDLER_ADD_LIFE,		NULL },
+		{ SPIKES, SPIKES,				FLAG_HAZARD,						HANDLER_DAMAGE,			NULL },
+		{ SPA, SPA,						0,									HANDLER_HEAL,			NULL },
+		{ EXIT, EXIT,					FLAG_EXIT,							HANDLER_WIN,			"Image/Scene2D_Exit.tga" },
+		{ WALL, WALL_LAST,				FLAG_BLOCKING,						HANDLER_NONE,			"Image/Assets/wall.tga" },
+		{ PLAYER_SPAWN, PLAYER_SPAWN,	FLAG_SPAWN,							HANDLER_NONE,			NULL },
+		{ ENEMY_SPAWN, ENEMY_SPAWN,		FLAG_SPAWN,							HANDLER_NONE,			NULL },
+		{ PET_SPAWN, PET_SPAWN,			FLAG_SPAWN,							HANDLER_NONE,			NULL }
+	};
+	const unsigned int NUM_TILETYPES = sizeof(arrTileTypes) / sizeof(arrTileTypes[0]);
+
+	// The number of values in the lookup table. Every type has to be stored as values below it
+	const unsigned int NUM_VALUES = 512;
+
+	// The entry of a value in the lookup table
+	struct TileInfo
+	{
+		unsigned char ucFlags;
+		unsigned char ucHandler;
+		// The row of its type in arrTileTypes, which is also the slot of its texture
+		unsigned char ucType;
+	};
+
+	// The lookup table, with an entry for each value from 0 to NUM_VALUES - 1
+	struct LookupTable
+	{
+		TileInfo arrEntries[NUM_VALUES];
+	};
+
+	// Check that the values of every type are in the lookup table, and that no value has two types
+	constexpr bool AreTileTypesValid(void)
+	{
+		for (unsigned int i = 0; i < NUM_TILETYPES; i++)
+		{
+			if ((arrTileTypes[i].iFirstValue < 0) || (arrTileTypes[i].iLastValue >= (int)NUM_VALUES) ||
+				(arrTileTypes[i].iFirstValue > arrTileTypes[i].iLastValue))
+				return false;
+			for (unsigned int j = 0; j < i; j++)
+			{
+				if ((arrTileTypes[i].iFirstValue <= arrTileTypes[j].iLastValue) &&
+					(arrTileTypes[j].iFirstValue <= arrTileTypes[i].iLastValue))
+					return false;
+			}
+		}
+		return true;
+	}
+	static_assert(AreTileTypesValid(), "Every tile type has to be stored as values below NUM_VALUES, which no other type uses");
+	static_assert(NUM_TILETYPES <= 256, "The row of a tile type has to fit into TileInfo::ucType");
+
+	// Build the lookup table from arrTileTypes. The values which are not in it get the first row
+	constexpr LookupTable BuildLookupTable(void)
+	{
+		LookupTable sTable = {};
+		for (unsigned int i = 0; i < NUM_TILETYPES; i++)
+		{
+			for (int iValue = arrTileTypes[i].iFirstValue; iValue <= arrTileTypes[i].iLastValue; iValue++)
+			{
+				sTable.arrEntries[iValue].ucFlags = (unsigned char)arrTileTypes[i].uiFlags;
+				sTable.arrEntries[iValue].ucHandler = (unsigned char)arrTileTypes[i].eHandler;
+				sTable.arrEntries[iValue].ucType = (unsigned char)i;
+			}
+		}
+		return sTable;
+	}
+	constexpr LookupTable sLookupTable = BuildLookupTable();
+
+	// Get the entry of a value. The values outside the lookup table get the entry of EMPTY
+	constexpr const TileInfo& GetInfo(const int iValue)
+	{
+		return sLookupTable.arrEntries[((unsigned int)iValue < NUM_VALUES) ? (unsigned int)iValue : 0];
+	}
+
+	// Check if a value has a flag
+	constexpr bool HasFlag(const int iValue, const FLAG eFlag)
+	{
+		return (GetInfo(iValue).ucFlags & eFlag) != 0;
+	}
+	// Check if a value blocks its tile
+	constexpr bool IsBlocking(const int iValue)
+	{
+		return HasFlag(iValue, FLAG_BLOCKING);
+	}
+	// Check if a value is an item or a trigger, which is kept in the item layer of CMapLevel
+	constexpr bool IsItem(const int iValue)
+	{
+		return (GetInfo(iValue).ucType != 0) && !IsBlocking(iValue);
+	}
+	// Get the handler which the entities run when they step on a value
+	constexpr HANDLER GetHandler(const int iValue)
+	{
+		return (HANDLER)GetInfo(iValue).ucHandler;
+	}
+	// Get the row of the type of a value in arrTileTypes, which is also the slot of its texture
+	constexpr unsigned int GetType(const int iValue)
+	{
+		return GetInfo(iValue).ucType;
+	}
+
+	static_assert(IsBlocking(WALL) && IsBlocking(WALL_LAST) && !IsBlocking(WALL_LAST + 1) && !IsBlocking(-1),
+		"The walls have to be the only blocking values");
+}
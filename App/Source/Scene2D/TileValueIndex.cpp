@@ -0,0 +1,128 @@
+/**
+ CTileValueIndex
+ @brief A class which keeps the tiles holding each value of a CMapLevel, so that finding and counting a value
+		does not scan the level. It is updated tile by tile as the level changes.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "TileValueIndex.h"
+
+// The list returned for a value which no tile holds
+static const std::vector<unsigned int> arrNoTiles;
+
+/**
+ @brief Constructor
+ */
+CTileValueIndex::CTileValueIndex(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTileValueIndex::~CTileValueIndex(void)
+{
+}
+
+/**
+ @brief Index every tile of a level
+ @param cLevel A const CMapLevel& variable containing the level
+ */
+void CTileValueIndex::Build(const CMapLevel& cLevel)
+{
+	const unsigned int uiNumTiles = cLevel.GetNumRows() * cLevel.GetNumCols();
+	const int* pTiles = cLevel.GetTiles();
+
+	mapValueTiles.clear();
+	arrSlots.resize(uiNumTiles);
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+		Add(i, pTiles[i]);
+}
+
+/**
+ @brief Swap the tiles of each value with another index
+ @param cIndex A CTileValueIndex& variable containing the other index
+ */
+void CTileValueIndex::Swap(CTileValueIndex& cIndex)
+{
+	mapValueTiles.swap(cIndex.mapValueTiles);
+	arrSlots.swap(cIndex.arrSlots);
+}
+
+/**
+ @brief Move a tile from the list of its old value to the list of its new value
+ @param uiIndex A const unsigned int variable containing the index of the tile
+ @param iOldValue A const int variable containing the value the tile held
+ @param iNewValue A const int variable containing the value the tile holds now
+ */
+void CTileValueIndex::OnTileChanged(const unsigned int uiIndex, const int iOldValue, const int iNewValue)
+{
+	if ((iOldValue == iNewValue) || (uiIndex >= arrSlots.size()))
+		return;
+
+	Remove(uiIndex, iOldValue);
+	Add(uiIndex, iNewValue);
+}
+
+/**
+ @brief Find a tile holding a value
+ @param iValue A const int variable containing the value
+ @param uirIndex An unsigned int& variable which will store the index of the tile
+ */
+bool CTileValueIndex::Find(const int iValue, unsigned int& uirIndex) const
+{
+	const std::unordered_map<int, std::vector<unsigned int>>::const_iterator it = mapValueTiles.find(iValue);
+	if ((it == mapValueTiles.end()) || it->second.empty())
+		return false;
+
+	uirIndex = it->second.front();
+	return true;
+}
+
+/**
+ @brief Get the number of tiles holding a value
+ @param iValue A const int variable containing the value
+ */
+unsigned int CTileValueIndex::GetCount(const int iValue) const
+{
+	return (unsigned int)GetTiles(iValue).size();
+}
+
+/**
+ @brief Get the tiles holding a value
+ @param iValue A const int variable containing the value
+ */
+const std::vector<unsigned int>& CTileValueIndex::GetTiles(const int iValue) const
+{
+	const std::unordered_map<int, std::vector<unsigned int>>::const_iterator it = mapValueTiles.find(iValue);
+	if (it == mapValueTiles.end())
+		return arrNoTiles;
+	return it->second;
+}
+
+/**
+ @brief Add a tile to the list of a value
+ @param uiIndex A const unsigned int variable containing the index of the tile
+ @param iValue A const int variable containing the value
+ */
+void CTileValueIndex::Add(const unsigned int uiIndex, const int iValue)
+{
+	std::vector<unsigned int>& arrTiles = mapValueTiles[iValue];
+	arrSlots[uiIndex] = (unsigned int)arrTiles.size();
+	arrTiles.push_back(uiIndex);
+}
+
+/**
+ @brief Remove a tile from the list of a value, by moving the last tile of the list into its slot
+ @param uiIndex A const unsigned int variable containing the index of the tile
+ @param iValue A const int variable containing the value
+ */
+void CTileValueIndex::Remove(const unsigned int uiIndex, const int iValue)
+{
+	std::vector<unsigned int>& arrTiles = mapValueTiles[iValue];
+	const unsigned int uiSlot = arrSlots[uiIndex];
+	const unsigned int uiLast = arrTiles.back();
+	arrTiles[uiSlot] = uiLast;
+	arrSlots[uiLast] = uiSlot;
+	arrTiles.pop_back();
+}
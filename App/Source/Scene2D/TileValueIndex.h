@@ -0,0 +1,54 @@
+/**
+ CTileValueIndex
+ @brief A class which keeps the tiles holding each value of a CMapLevel, so that finding and counting a value
+		does not scan the level. It is updated tile by tile as the level changes.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include MapLevel
+#include "MapLevel.h"
+
+#include <unordered_map>
+#include <vector>
+
+class CTileValueIndex
+{
+public:
+	// Constructor
+	CTileValueIndex(void);
+
+	// Destructor
+	~CTileValueIndex(void);
+
+	// Index every tile of cLevel
+	void Build(const CMapLevel& cLevel);
+
+	// Swap the tiles of each value with another index, e.g. along with the level it was built for
+	void Swap(CTileValueIndex& cIndex);
+
+	// Move a tile from the list of its old value to the list of its new value.
+	// The tile index is (row * columns + column), with the rows in CSV order like CMapLevel::GetTiles()
+	void OnTileChanged(const unsigned int uiIndex, const int iOldValue, const int iNewValue);
+
+	// Find a tile holding a value. Returns false if no tile holds it
+	bool Find(const int iValue, unsigned int& uirIndex) const;
+
+	// Get the number of tiles holding a value
+	unsigned int GetCount(const int iValue) const;
+
+	// Get the tiles holding a value, in no particular order
+	const std::vector<unsigned int>& GetTiles(const int iValue) const;
+
+protected:
+	// The tiles holding each value
+	std::unordered_map<int, std::vector<unsigned int>> mapValueTiles;
+	// Where each tile is stored in the list of its value, so that it can be removed in O(1)
+	std::vector<unsigned int> arrSlots;
+
+	// Add a tile to the list of a value
+	void Add(const unsigned int uiIndex, const int iValue);
+	// Remove a tile from the list of a value
+	void Remove(const unsigned int uiIndex, const int iValue);
+};
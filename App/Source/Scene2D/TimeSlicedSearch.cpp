@@ -0,0 +1,397 @@
+/**
+ CTimeSlicedSearch
+ @brief A class which runs an A* search a few nodes at a time, so that one search can be spread over several frames.
+		Until the target is reached, it offers the path to the most promising node found so far.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "TimeSlicedSearch.h"
+
+#include <algorithm>
+#include <climits>
+
+/**
+ @brief Constructor
+ */
+CTimeSlicedSearch::CTimeSlicedSearch(void)
+	: pLevel(NULL)
+	, startPos(0, 0)
+	, targetPos(0, 0)
+	, uiNrOfDirections(4)
+	, eHeuristic(MANHATTAN)
+	, weight(1)
+	, eStatus(IDLE)
+	, m_uiGeneration(0)
+	, iBestNode(-1)
+	, uiBestHeuristic(UINT_MAX)
+	, m_uiNumFrames(0)
+	, m_uiNumNodesExpanded(0)
+{
+	sMapSize.uiRowSize = 0;
+	sMapSize.uiColSize = 0;
+}
+
+/**
+ @brief Destructor
+ */
+CTimeSlicedSearch::~CTimeSlicedSearch(void)
+{
+	// We won't delete this since it was created elsewhere
+	pLevel = NULL;
+}
+
+/**
+ @brief Start a search. No nodes are expanded until Run() is called
+ @param cLevel A const CMapLevel& variable containing the level to search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uiNrOfDirections A const unsigned int variable containing the number of directions, 4 or 8
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic to use
+ @param weight An int variable containing the weight of the heuristic
+ */
+void CTimeSlicedSearch::Begin(const CMapLevel& cLevel,
+	const glm::vec2& startPos,
+	const glm::vec2& targetPos,
+	const unsigned int uiNrOfDirections,
+	HeuristicFunction heuristicFunc,
+	int weight)
+{
+	pLevel = &cLevel;
+	this->startPos = startPos;
+	this->targetPos = targetPos;
+	this->uiNrOfDirections = uiNrOfDirections;
+	this->heuristicFunc = heuristicFunc;
+	this->weight = weight;
+
+	// Use the inlined heuristics for the built-in heuristic functions
+	typedef unsigned int (*HeuristicPointer)(const glm::vec2&, const glm::vec2&, int);
+	const HeuristicPointer* pFunction = heuristicFunc.target<HeuristicPointer>();
+	if (pFunction && (*pFunction == &heuristic::manhattan))
+		eHeuristic = MANHATTAN;
+	else if (pFunction && (*pFunction == &heuristic::euclidean))
+		eHeuristic = EUCLIDEAN;
+	else
+		eHeuristic = FUNCTION;
+
+	m_uiNumFrames = 0;
+	m_uiNumNodesExpanded = 0;
+	Restart();
+}
+
+/**
+ @brief Start the same search again
+ */
+void CTimeSlicedSearch::Restart(void)
+{
+	if (pLevel == NULL)
+		return;
+
+	// Make sure that the lists are big enough for this level
+	if ((pLevel->GetNumRows() != sMapSize.uiRowSize) || (pLevel->GetNumCols() != sMapSize.uiColSize))
+	{
+		sMapSize.uiRowSize = pLevel->GetNumRows();
+		sMapSize.uiColSize = pLevel->GetNumCols();
+
+		Node node;
+		node.uiGeneration = 0;
+		node.g = 0;
+		node.iParent = -1;
+		node.bClosed = false;
+		m_nodes.assign(sMapSize.uiRowSize * sMapSize.uiColSize, node);
+		m_openList.Init(sMapSize.uiRowSize * sMapSize.uiColSize);
+		m_uiGeneration = 0;
+	}
+
+	m_openList.Clear();
+	m_uiGeneration++;
+	// If the generation counter wrapped around, then the old stamps could match again
+	if (m_uiGeneration == 0)
+	{
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			m_nodes[i].uiGeneration = 0;
+		m_uiGeneration = 1;
+	}
+	iBestNode = -1;
+	uiBestHeuristic = UINT_MAX;
+	arrPath.clear();
+
+	const int iStart = ConvertTo1D(startPos);
+	const int iTarget = ConvertTo1D(targetPos);
+	if ((iStart < 0) || (iTarget < 0) ||
+		pLevel->IsBlocked((unsigned int)startPos.y, (unsigned int)startPos.x) ||
+		pLevel->IsBlocked((unsigned int)targetPos.y, (unsigned int)targetPos.x))
+	{
+		eStatus = NOT_FOUND;
+		return;
+	}
+
+	Node& startNode = GetNode(iStart);
+	startNode.iParent = iStart;
+	m_openList.Push(iStart, 0);
+	eStatus = RUNNING;
+}
+
+/**
+ @brief Stop the search
+ */
+void CTimeSlicedSearch::Stop(void)
+{
+	m_openList.Clear();
+	arrPath.clear();
+	eStatus = IDLE;
+}
+
+/**
+ @brief End the search with a path found elsewhere
+ @param path A const std::vector<glm::vec2>& variable containing the path, which is empty if the target cannot be reached
+ */
+void CTimeSlicedSearch::Finish(const std::vector<glm::vec2>& path)
+{
+	m_openList.Clear();
+	arrPath = path;
+	eStatus = path.empty() ? NOT_FOUND : FOUND;
+}
+
+/**
+ @brief Expand at most uiMaxNodes nodes
+ @param uiMaxNodes A const unsigned int variable containing the largest number of nodes to expand
+ */
+unsigned int CTimeSlicedSearch::Run(const unsigned int uiMaxNodes)
+{
+	if (eStatus != RUNNING)
+		return 0;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iNumRows = (int)sMapSize.uiRowSize;
+	const int iTarget = ConvertTo1D(targetPos);
+	const int iOldBestNode = iBestNode;
+	unsigned int uiNumExpanded = 0;
+	while (uiNumExpanded < uiMaxNodes)
+	{
+		if (m_openList.Empty())
+		{
+			eStatus = NOT_FOUND;
+			break;
+		}
+
+		// Get the node with the least f value
+		const int iCurrent = m_openList.Top();
+
+		// If the targetPos was reached, then the search is done
+		if (iCurrent == iTarget)
+		{
+			m_openList.Clear();
+			iBestNode = iCurrent;
+			uiBestHeuristic = 0;
+			eStatus = FOUND;
+			break;
+		}
+
+		m_openList.Pop();
+		Node& currentNode = m_nodes[iCurrent];
+		currentNode.bClosed = true;
+		uiNumExpanded++;
+
+		const int iCurrentX = iCurrent % iNumCols;
+		const int iCurrentY = iCurrent / iNumCols;
+
+		// Remember the node closest to the target, for the path followed before the target is reached
+		const unsigned int uiHeuristic = GetHeuristic(iCurrentX, iCurrentY);
+		if ((iBestNode < 0) || (uiHeuristic < uiBestHeuristic) ||
+			((uiHeuristic == uiBestHeuristic) && (currentNode.g < m_nodes[iBestNode].g)))
+		{
+			iBestNode = iCurrent;
+			uiBestHeuristic = uiHeuristic;
+		}
+
+		// Check the neighbors of the current node
+		const unsigned int gNew = currentNode.g + 1;
+		for (unsigned int i = 0; i < uiNrOfDirections; ++i)
+		{
+			const int iNeighborX = iCurrentX + iDirectionX[i];
+			const int iNeighborY = iCurrentY + iDirectionY[i];
+			if ((iNeighborX < 0) || (iNeighborX >= iNumCols) ||
+				(iNeighborY < 0) || (iNeighborY >= iNumRows) ||
+				pLevel->IsBlocked(iNeighborY, iNeighborX))
+				continue;
+
+			const int iNeighbor = iNeighborY * iNumCols + iNeighborX;
+			const bool bSeen = (m_nodes[iNeighbor].uiGeneration == m_uiGeneration);
+			Node& neighborNode = GetNode(iNeighbor);
+			if (neighborNode.bClosed)
+				continue;
+
+			// Only update the neighbor if it is new or this path to it is shorter
+			if (!bSeen || gNew < neighborNode.g)
+			{
+				neighborNode.g = gNew;
+				neighborNode.iParent = iCurrent;
+				m_openList.Push(iNeighbor, gNew + GetHeuristic(iNeighborX, iNeighborY));
+			}
+		}
+	}
+
+	// The parents of the expanded nodes do not change, so the path only changes with the best node
+	if (iBestNode != iOldBestNode)
+		BuildPath();
+
+	m_uiNumNodesExpanded += uiNumExpanded;
+	return uiNumExpanded;
+}
+
+/**
+ @brief Count a frame in which this search was running
+ */
+void CTimeSlicedSearch::NextFrame(void)
+{
+	m_uiNumFrames++;
+}
+
+/**
+ @brief Get the state of the search
+ */
+CTimeSlicedSearch::STATUS CTimeSlicedSearch::GetStatus(void) const
+{
+	return eStatus;
+}
+
+/**
+ @brief Get the level being searched
+ */
+const CMapLevel* CTimeSlicedSearch::GetLevel(void) const
+{
+	return pLevel;
+}
+
+/**
+ @brief Get the path to the target, or to the node closest to the target found so far
+ */
+const std::vector<glm::vec2>& CTimeSlicedSearch::GetPath(void) const
+{
+	return arrPath;
+}
+
+/**
+ @brief Check if a position is the start or on the path
+ @param pos A const glm::vec2& variable containing the position
+ */
+bool CTimeSlicedSearch::IsOnPath(const glm::vec2& pos) const
+{
+	if (eStatus == IDLE)
+		return false;
+	if (pos == startPos)
+		return true;
+	return std::find(arrPath.begin(), arrPath.end(), pos) != arrPath.end();
+}
+
+/**
+ @brief Get the furthest tile which can be reached from a position on the path in one straight run
+ @param pos A const glm::vec2& variable containing the position
+ @param destination A glm::vec2& variable which will store the furthest tile
+ @param direction A glm::vec2& variable which will store the direction of the run
+ */
+bool CTimeSlicedSearch::GetDestination(const glm::vec2& pos, glm::vec2& destination, glm::vec2& direction) const
+{
+	const std::vector<glm::vec2>& path = arrPath;
+
+	// Find the step after pos
+	unsigned int uiNext = 0;
+	if (pos != startPos)
+	{
+		std::vector<glm::vec2>::const_iterator it = std::find(path.begin(), path.end(), pos);
+		if (it == path.end())
+			return false;
+		uiNext = (unsigned int)(it - path.begin()) + 1;
+	}
+	if (uiNext >= path.size())
+		return false;
+
+	destination = path[uiNext];
+	direction = destination - pos;
+	for (unsigned int i = uiNext + 1; (i < path.size()) && ((path[i] - destination) == direction); i++)
+		destination = path[i];
+	return true;
+}
+
+/**
+ @brief Get the number of frames this search has been running for
+ */
+unsigned int CTimeSlicedSearch::GetNumFrames(void) const
+{
+	return m_uiNumFrames;
+}
+
+/**
+ @brief Get the number of nodes this search has expanded
+ */
+unsigned int CTimeSlicedSearch::GetNumNodesExpanded(void) const
+{
+	return m_uiNumNodesExpanded;
+}
+
+/**
+ @brief Build the path to iBestNode from the parents of the nodes, reusing the memory of the old path
+ */
+void CTimeSlicedSearch::BuildPath(void)
+{
+	arrPath.clear();
+	if (iBestNode < 0)
+		return;
+
+	const int iNumCols = (int)sMapSize.uiColSize;
+	const int iStart = ConvertTo1D(startPos);
+	for (int iCurrent = iBestNode; iCurrent != iStart; iCurrent = m_nodes[iCurrent].iParent)
+		arrPath.push_back(glm::vec2(iCurrent % iNumCols, iCurrent / iNumCols));
+	std::reverse(arrPath.begin(), arrPath.end());
+
+	// If the path to the target has only 1 entry, then it is the the target position
+	// This is only OK if startPos is next to targetPos
+	if ((eStatus == FOUND) && (arrPath.size() == 1) &&
+		(abs(targetPos.y - startPos.y) + abs(targetPos.x - startPos.x) > 1))
+		arrPath.clear();
+}
+
+/**
+ @brief Get a node, resetting it if it was last touched by an older search
+ @param iNode A const int variable containing the 1D position of the node
+ */
+CTimeSlicedSearch::Node& CTimeSlicedSearch::GetNode(const int iNode)
+{
+	Node& node = m_nodes[iNode];
+	if (node.uiGeneration != m_uiGeneration)
+	{
+		node.uiGeneration = m_uiGeneration;
+		node.g = 0;
+		node.iParent = -1;
+		node.bClosed = false;
+	}
+	return node;
+}
+
+/**
+ @brief Get the heuristic of a position
+ @param iX A const int variable containing the column of the position
+ @param iY A const int variable containing the inverted row of the position
+ */
+unsigned int CTimeSlicedSearch::GetHeuristic(const int iX, const int iY) const
+{
+	switch (eHeuristic)
+	{
+	case MANHATTAN:
+		return heuristic::Manhattan()(iX, iY, (int)targetPos.x, (int)targetPos.y, weight);
+	case EUCLIDEAN:
+		return heuristic::Euclidean()(iX, iY, (int)targetPos.x, (int)targetPos.y, weight);
+	default:
+		return heuristicFunc(glm::vec2(iX, iY), targetPos, weight);
+	}
+}
+
+/**
+ @brief Convert a position to a 1D index, or -1 if it is outside the level
+ */
+int CTimeSlicedSearch::ConvertTo1D(const glm::vec2& pos) const
+{
+	if ((pos.x < 0) || (pos.x >= sMapSize.uiColSize) || (pos.y < 0) || (pos.y >= sMapSize.uiRowSize))
+		return -1;
+	return (int)pos.y * sMapSize.uiColSize + (int)pos.x;
+}
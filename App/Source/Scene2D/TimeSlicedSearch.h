@@ -0,0 +1,127 @@
+/**
+ CTimeSlicedSearch
+ @brief A class which runs an A* search a few nodes at a time, so that one search can be spread over several frames.
+		Until the target is reached, it offers the path to the most promising node found so far.
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include PathFinder for the heuristics
+#include "PathFinder.h"
+
+#include <vector>
+
+class CTimeSlicedSearch
+{
+public:
+	// The state of the search
+	enum STATUS
+	{
+		IDLE = 0,	// No search was started, or it was stopped
+		RUNNING,	// The search has nodes left to expand
+		FOUND,		// The target was reached
+		NOT_FOUND,	// The target cannot be reached
+		NUM_STATUSES
+	};
+
+	// Constructor
+	CTimeSlicedSearch(void);
+
+	// Destructor
+	~CTimeSlicedSearch(void);
+
+	// Start a search in cLevel from startPos to targetPos, moving in 4 or 8 directions. No nodes are expanded yet
+	void Begin(const CMapLevel& cLevel,
+				const glm::vec2& startPos,
+				const glm::vec2& targetPos,
+				const unsigned int uiNrOfDirections,
+				HeuristicFunction heuristicFunc,
+				int weight = 1);
+	// Start the same search again, e.g. after a blocking tile changed. The frame counter is kept
+	void Restart(void);
+	// Stop the search
+	void Stop(void);
+	// End the search with a path found elsewhere, e.g. in a path cache. An empty path means the target cannot be reached
+	void Finish(const std::vector<glm::vec2>& path);
+
+	// Expand at most uiMaxNodes nodes, and return the number of nodes expanded
+	unsigned int Run(const unsigned int uiMaxNodes);
+	// Count a frame in which this search was running
+	void NextFrame(void);
+
+	// Get the state of the search
+	STATUS GetStatus(void) const;
+	// Get the level being searched
+	const CMapLevel* GetLevel(void) const;
+
+	// Get the path to the target once it is found, or else the path to the node closest to the target found so far.
+	// It has the same shape as the paths of CPathFinder::PathFind, and is only built again when Run() changes it
+	const std::vector<glm::vec2>& GetPath(void) const;
+	// Check if a position is the start or on the path returned by GetPath()
+	bool IsOnPath(const glm::vec2& pos) const;
+	// Get the furthest tile which can be reached from a position on the path in one straight run,
+	// and the direction of that run. Returns false if the position is not on the path or at its end
+	bool GetDestination(const glm::vec2& pos, glm::vec2& destination, glm::vec2& direction) const;
+
+	// Get the number of frames this search has been running for, and the number of nodes it has expanded
+	unsigned int GetNumFrames(void) const;
+	unsigned int GetNumNodesExpanded(void) const;
+
+protected:
+	// The A* data of a map grid. A node only holds valid data if its
+	// uiGeneration matches m_uiGeneration, so a new search resets every node in O(1)
+	struct Node
+	{
+		unsigned int uiGeneration;
+		unsigned int g;
+		int iParent;
+		bool bClosed;
+	};
+
+	// The heuristics which are computed without a call through heuristicFunc
+	enum HEURISTIC
+	{
+		MANHATTAN = 0,
+		EUCLIDEAN,
+		FUNCTION
+	};
+
+	// The query
+	const CMapLevel* pLevel;
+	glm::vec2 startPos;
+	glm::vec2 targetPos;
+	unsigned int uiNrOfDirections;
+	HeuristicFunction heuristicFunc;
+	HEURISTIC eHeuristic;
+	int weight;
+	STATUS eStatus;
+
+	// The size of the level being searched
+	MapSize sMapSize;
+
+	// Lists for the search
+	CIndexedHeap<unsigned int> m_openList;
+	std::vector<Node> m_nodes;
+	unsigned int m_uiGeneration;
+
+	// The expanded node with the lowest heuristic, and its heuristic
+	int iBestNode;
+	unsigned int uiBestHeuristic;
+
+	// The path returned by GetPath(): the path given to Finish(), or else the path to iBestNode
+	std::vector<glm::vec2> arrPath;
+
+	// Counters
+	unsigned int m_uiNumFrames;
+	unsigned int m_uiNumNodesExpanded;
+
+	// Get a node, resetting it if it was last touched by an older search
+	Node& GetNode(const int iNode);
+	// Build arrPath from the parents of iBestNode
+	void BuildPath(void);
+	// Get the heuristic of a position
+	unsigned int GetHeuristic(const int iX, const int iY) const;
+	// Convert a position to a 1D index, or -1 if it is outside the level
+	int ConvertTo1D(const glm::vec2& pos) const;
+};
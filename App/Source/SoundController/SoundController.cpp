@@ -80,6 +80,11 @@ bool CSoundController::LoadSound(	string filename,
 									CSoundInfo::SOUNDTYPE eSoundType,
 									vec3df vec3dfSoundPos)
 {
+	// The sound was kept from the last time the scene was initialised, so it is not read again
+	CSoundInfo* pExistingSoundInfo = GetSound(ID);
+	if ((pExistingSoundInfo != nullptr) && (filename == pExistingSoundInfo->GetSound()->getName()))
+		return true;
+
 	// Load the sound from the file
 	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
 																	E_STREAM_MODE::ESM_NO_STREAMING, 
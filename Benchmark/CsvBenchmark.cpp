@@ -0,0 +1,141 @@
+/**
+ CsvBenchmark
+ @brief Compares reading and writing tile map CSV text with rapidcsv, the way CMap2D::LoadMap and SaveMap did,
+		against the TileCsv functions, in MB of CSV text per second
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+#include "TileCsv.h"
+
+// rapidcsv uses std::numeric_limits without including it
+#include <limits>
+#include "rapidcsv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+// Simple xorshift so that every run sees the same map
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+// Time a function, returning the nanoseconds per iteration
+template <typename Function>
+static double TimeIt(const unsigned int uiIterations, Function function)
+{
+	const auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < uiIterations; i++)
+		function();
+	const auto end = chrono::high_resolution_clock::now();
+	return chrono::duration<double, nano>(end - start).count() / uiIterations;
+}
+
+static void PrintResult(const char* cName, const size_t uiNumBytes, const double dRapidCsv, const double dTileCsv)
+{
+	// Bytes per nanosecond is GB per second, so scale it to MB per second
+	cout << "  " << left << setw(10) << cName << right
+		<< setw(12) << fixed << setprecision(1) << uiNumBytes / dRapidCsv * 1000.0 << " MB/s"
+		<< setw(12) << uiNumBytes / dTileCsv * 1000.0 << " MB/s"
+		<< setw(10) << setprecision(2) << (dRapidCsv / dTileCsv) << "x" << endl;
+}
+
+static bool RunBenchmark(const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	// Mostly floor, some walls and a few items, like the DM2213 levels, with the same "//1,2,3,..." line of column labels
+	CMapLevel cLevel;
+	cLevel.Init(uiNumRows, uiNumCols);
+	int* pTiles = cLevel.GetTiles();
+	for (unsigned int i = 0; i < uiNumRows * uiNumCols; i++)
+	{
+		const unsigned int uiRandom = NextRandom() % 100;
+		pTiles[i] = (uiRandom < 25) ? 100 : (uiRandom < 28) ? (int)(1 + uiRandom % 5) : 0;
+	}
+	string columnLabels = "//1";
+	for (unsigned int uiCol = 2; uiCol <= uiNumCols; uiCol++)
+		columnLabels += "," + to_string(uiCol);
+
+	vector<char> buffer;
+	const size_t uiNumBytes = tilecsv::Format(pTiles, uiNumRows, uiNumCols, columnLabels, buffer);
+	const string text(buffer.data(), uiNumBytes);
+	const unsigned int uiIterations = (unsigned int)max((size_t)3, (size_t)20000000 / uiNumBytes);
+	volatile int iSink = 0;
+
+	cout << uiNumCols << "x" << uiNumRows << " (" << uiNumBytes << " bytes, " << uiIterations << " iterations)" << endl;
+	cout << "  " << left << setw(10) << "" << right << setw(17) << "rapidcsv" << setw(17) << "TileCsv" << setw(11) << "speedup" << endl;
+
+	// Load: a std::string per cell and stoi, against parsing the integers where they lie
+	CMapLevel cRapidLevel, cTileLevel;
+	cRapidLevel.Init(uiNumRows, uiNumCols);
+	cTileLevel.Init(uiNumRows, uiNumCols);
+	const double dRapidLoad = TimeIt(uiIterations, [&]() {
+		istringstream stream(text);
+		rapidcsv::Document doc(stream);
+		int* pOut = cRapidLevel.GetTiles();
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; ++uiCol)
+				*pOut++ = stoi(row[uiCol]);
+		}
+		iSink += cRapidLevel.GetTiles()[0];
+	});
+	bool bParsed = true;
+	const double dTileLoad = TimeIt(uiIterations * 10, [&]() {
+		bParsed &= tilecsv::Parse(text.data(), text.size(), uiNumRows, uiNumCols, cTileLevel.GetTiles());
+		iSink += cTileLevel.GetTiles()[0];
+	}) ;
+	PrintResult("Load", uiNumBytes, dRapidLoad, dTileLoad);
+
+	// Save: SetCell and Save of a rapidcsv::Document, against formatting into one buffer
+	istringstream stream(text);
+	rapidcsv::Document doc(stream);
+	string rapidText;
+	const double dRapidSave = TimeIt(uiIterations, [&]() {
+		const int* pIn = cLevel.GetTiles();
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+				doc.SetCell(uiCol, uiRow, *pIn++);
+		ostringstream out;
+		doc.Save(out);
+		rapidText = out.str();
+	});
+	size_t uiSavedBytes = 0;
+	const double dTileSave = TimeIt(uiIterations * 10, [&]() {
+		uiSavedBytes = tilecsv::Format(cLevel.GetTiles(), uiNumRows, uiNumCols, columnLabels, buffer);
+	});
+	PrintResult("Save", uiNumBytes, dRapidSave, dTileSave);
+	cout << endl;
+
+	// Both must read the same tiles, and write the same text
+	const unsigned int uiNumTiles = uiNumRows * uiNumCols;
+	if ((!bParsed) ||
+		(!equal(pTiles, pTiles + uiNumTiles, cRapidLevel.GetTiles())) ||
+		(!equal(pTiles, pTiles + uiNumTiles, cTileLevel.GetTiles())) ||
+		(rapidText != string(buffer.data(), uiSavedBytes)))
+	{
+		cout << "  The results differ" << endl;
+		return false;
+	}
+	return true;
+}
+
+int main(void)
+{
+	// The size of the shipped DM2213 levels, then larger maps
+	bool bSame = RunBenchmark(30, 40);
+	bSame &= RunBenchmark(256, 256);
+	bSame &= RunBenchmark(1024, 1024);
+	return bSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
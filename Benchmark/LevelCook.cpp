@@ -0,0 +1,65 @@
+/**
+ LevelCook
+ @brief Compiles map CSV files into the binary level files which CMap2D::LoadMap maps into memory,
+		saving each one next to its CSV. Usage: LevelCook <map.csv>...
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "LevelFile.h"
+
+#include "MapCsv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: LevelCook <map.csv>..." << endl;
+		return 1;
+	}
+
+	int iResult = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		const string filename = argv[i];
+		CMapLevel cLevel;
+		string columnLabels;
+		if (!LoadMapCsv(filename, cLevel, &columnLabels))
+		{
+			iResult = 1;
+			continue;
+		}
+
+		const string levelFilename = CLevelFile::GetFilename(filename);
+		SourceStamp sSource;
+		if ((!CLevelFile::GetSourceStamp(filename, sSource)) ||
+			(!CLevelFile::Save(levelFilename, cLevel, columnLabels, sSource)))
+		{
+			cout << "Unable to save " << levelFilename << endl;
+			iResult = 1;
+			continue;
+		}
+
+		// Load it back the way LoadMap does, to check it and time it
+		const auto start = chrono::steady_clock::now();
+		CLevelFile cLevelFile;
+		CMapLevel cLoadedLevel;
+		cLoadedLevel.Init(cLevel.GetNumRows(), cLevel.GetNumCols());
+		const bool bLoaded = cLevelFile.Open(levelFilename) && cLevelFile.CopyTo(cLoadedLevel);
+		const double dMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		if ((!bLoaded) ||
+			(!equal(cLevel.GetTiles(), cLevel.GetTiles() + cLevel.GetNumRows() * cLevel.GetNumCols(), cLoadedLevel.GetTiles())))
+		{
+			cout << "Unable to load " << levelFilename << " back" << endl;
+			iResult = 1;
+			continue;
+		}
+		cout << levelFilename << ": " << cLevel.GetNumCols() << "x" << cLevel.GetNumRows()
+			<< ", loaded back in " << dMs << " ms" << endl;
+	}
+	return iResult;
+}
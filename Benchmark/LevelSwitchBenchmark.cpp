@@ -0,0 +1,97 @@
+/**
+ LevelSwitchBenchmark
+ @brief Compares switching to a level which is loaded when it is needed, as CMap2D::LoadMap did, against
+		switching to a level which CLevelLoader preloaded on its worker thread. Checks that both give the same level
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+#include "LevelLoader.h"
+#include "MapCsv.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// The shipped map CSV files, separated by '|'
+#ifndef SHIPPED_MAPS
+#define SHIPPED_MAPS ""
+#endif
+
+// The loaded visible sets have to be valid exactly when PvsCook has saved them for the level
+static bool IsSameLevel(const CMapLevel& cLevel, const bool bHasVisibleSet, const LoadedLevel& sLevel)
+{
+	if ((cLevel.GetNumRows() != sLevel.cLevel.GetNumRows()) || (cLevel.GetNumCols() != sLevel.cLevel.GetNumCols()))
+		return false;
+	for (unsigned int i = 0; i < cLevel.GetNumRows() * cLevel.GetNumCols(); i++)
+	{
+		if (cLevel.GetTiles()[i] != sLevel.cLevel.GetTiles()[i])
+			return false;
+	}
+	return sLevel.cVisibleSet.IsValid(0) == bHasVisibleSet;
+}
+
+int main(void)
+{
+	const unsigned int uiNumSwitches = 20;
+	bool bSame = true;
+	stringstream maps(SHIPPED_MAPS);
+	string filename;
+	while (getline(maps, filename, '|'))
+	{
+		CMapLevel cLevel;
+		if (!LoadMapCsv(filename, cLevel))
+			continue;
+		const unsigned int uiNumRows = cLevel.GetNumRows(), uiNumCols = cLevel.GetNumCols();
+		CPotentiallyVisibleSet cVisibleSet;
+		const bool bHasVisibleSet = cVisibleSet.Load(CPotentiallyVisibleSet::GetFilename(filename), cLevel, 0);
+
+		// Load the level at the moment it is switched to
+		double dLoadTotal = 0.0;
+		vector<char> arrCsvText;
+		for (unsigned int i = 0; i < uiNumSwitches; i++)
+		{
+			LoadedLevel sLevel;
+			const auto start = chrono::high_resolution_clock::now();
+			const bool bLoaded = CLevelLoader::Load(filename, uiNumRows, uiNumCols, sLevel, arrCsvText);
+			dLoadTotal += chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count();
+			bSame &= bLoaded && IsSameLevel(cLevel, bHasVisibleSet, sLevel);
+		}
+
+		// Preload the level while the current one is played, then swap it in when it is switched to
+		double dTakeTotal = 0.0;
+		CLevelLoader cLevelLoader;
+		LoadedLevel sCurrentLevel;
+		for (unsigned int i = 0; i < uiNumSwitches; i++)
+		{
+			cLevelLoader.Preload(filename, uiNumRows, uiNumCols);
+			while (!cLevelLoader.IsReady())
+				this_thread::sleep_for(chrono::milliseconds(1));
+			LoadedLevel sLevel;
+			const auto start = chrono::high_resolution_clock::now();
+			const bool bLoaded = cLevelLoader.Take(sLevel);
+			sCurrentLevel.cLevel.Swap(sLevel.cLevel);
+			sCurrentLevel.cValueIndex.Swap(sLevel.cValueIndex);
+			sCurrentLevel.cVisibleSet.Swap(sLevel.cVisibleSet);
+			dTakeTotal += chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count();
+			bSame &= bLoaded && IsSameLevel(cLevel, bHasVisibleSet, sCurrentLevel);
+		}
+
+		cout << filename.substr(filename.find_last_of("/\\") + 1) << " (" << uiNumCols << "x" << uiNumRows << "): "
+			<< fixed << setprecision(1) << dLoadTotal / uiNumSwitches << " us loaded when switched to, "
+			<< dTakeTotal / uiNumSwitches << " us when preloaded" << endl;
+	}
+
+	if (!bSame)
+	{
+		cout << "The preloaded levels differ" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
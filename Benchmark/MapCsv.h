@@ -0,0 +1,37 @@
+/**
+ MapCsv
+ @brief Reads a map CSV into a CMapLevel the same way as CMap2D::LoadMap, for the headless tools
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#pragma once
+
+#include "MapLevel.h"
+#include "TileCsv.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Read a map CSV with its first line as the column labels, which are stored in pColumnLabels if it is given.
+// Returns false if the file cannot be read
+inline bool LoadMapCsv(const std::string& filename, CMapLevel& cLevel, std::string* pColumnLabels = NULL)
+{
+	std::vector<char> buffer;
+	size_t uiSize = 0;
+	unsigned int uiNumRows = 0, uiNumCols = 0;
+	if ((!tilecsv::ReadFile(filename, buffer, uiSize)) ||
+		(!tilecsv::GetSize(buffer.data(), uiSize, uiNumRows, uiNumCols)))
+	{
+		std::cerr << filename << ": unable to read the map" << std::endl;
+		return false;
+	}
+	cLevel.Init(uiNumRows, uiNumCols);
+	if (!tilecsv::Parse(buffer.data(), uiSize, uiNumRows, uiNumCols, cLevel.GetTiles(), pColumnLabels))
+	{
+		std::cerr << filename << ": a cell is not an integer, or a row has another number of columns" << std::endl;
+		return false;
+	}
+	cLevel.UpdateLayers();
+	return true;
+}
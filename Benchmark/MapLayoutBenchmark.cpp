@@ -0,0 +1,195 @@
+/**
+ MapLayoutBenchmark
+ @brief Compares full-map scans (FindValue, SaveMap) and random tile reads over the flat
+		CMapLevel storage against the old Grid*** arrMapInfo layout
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+
+#include <includes/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+// The map grid as it was stored before CMapLevel: the tile value plus the A* scratch data
+struct LegacyGrid {
+	unsigned int value;
+	glm::vec2 pos;
+	glm::vec2 parent;
+	unsigned int f;
+	unsigned int g;
+	unsigned int h;
+};
+
+// The old arrMapInfo layout: one heap array per row
+class CLegacyLevel
+{
+public:
+	CLegacyLevel(const unsigned int uiNumRows, const unsigned int uiNumCols)
+		: uiNumRows(uiNumRows)
+		, uiNumCols(uiNumCols)
+	{
+		arrMapInfo = new LegacyGrid*[uiNumRows];
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			arrMapInfo[uiRow] = new LegacyGrid[uiNumCols]();
+	}
+	~CLegacyLevel(void)
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			delete[] arrMapInfo[uiRow];
+		delete[] arrMapInfo;
+	}
+
+	// Same loop as the old CMap2D::FindValue
+	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol) const
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				if (arrMapInfo[uiRow][uiCol].value == (unsigned int)iValue)
+				{
+					uirRow = uiNumRows - uiRow - 1;
+					uirCol = uiCol;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// Same check as the old CMap2D::isBlocked
+	bool IsBlocked(const unsigned int uiRow, const unsigned int uiCol) const
+	{
+		const unsigned int value = arrMapInfo[uiNumRows - uiRow - 1][uiCol].value;
+		return (value >= 100) && (value < 200);
+	}
+
+	LegacyGrid** arrMapInfo;
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+};
+
+// Simple xorshift so that both layouts see the same map and the same queries
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+// Time a function, returning the nanoseconds per iteration
+template <typename Function>
+static double TimeIt(const unsigned int uiIterations, Function function)
+{
+	const auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < uiIterations; i++)
+		function();
+	const auto end = chrono::high_resolution_clock::now();
+	return chrono::duration<double, nano>(end - start).count() / uiIterations;
+}
+
+static void PrintResult(const char* cName, const double dLegacy, const double dFlat)
+{
+	cout << "  " << left << setw(28) << cName << right
+		<< setw(14) << fixed << setprecision(1) << dLegacy << " ns"
+		<< setw(14) << dFlat << " ns"
+		<< setw(10) << setprecision(2) << (dLegacy / dFlat) << "x" << endl;
+}
+
+static void RunBenchmark(const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	CLegacyLevel cLegacy(uiNumRows, uiNumCols);
+	CMapLevel cFlat;
+	cFlat.Init(uiNumRows, uiNumCols);
+
+	// Fill both layouts with the same walls; the value searched for sits in the last tile
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			const int iValue = (NextRandom() % 4 == 0) ? 100 : 0;
+			cLegacy.arrMapInfo[uiRow][uiCol].value = iValue;
+			cFlat.SetTile(uiRow, uiCol, iValue, false);
+		}
+	}
+	cLegacy.arrMapInfo[uiNumRows - 1][uiNumCols - 1].value = 300;
+	cFlat.SetTile(uiNumRows - 1, uiNumCols - 1, 300, false);
+
+	const unsigned int uiNumTiles = uiNumRows * uiNumCols;
+	const unsigned int uiScanIterations = (unsigned int)max(10u, 50000000u / uiNumTiles);
+	unsigned int uiRow = 0, uiCol = 0;
+	volatile unsigned long long ullSink = 0;
+
+	cout << uiNumCols << "x" << uiNumRows << " (" << uiScanIterations << " scans)" << endl;
+	cout << "  " << left << setw(28) << "" << right << setw(17) << "Grid***" << setw(17) << "CMapLevel" << setw(11) << "speedup" << endl;
+
+	// FindValue: a full scan for a value in the last tile
+	const double dLegacyFind = TimeIt(uiScanIterations, [&]() {
+		cLegacy.FindValue(300, uiRow, uiCol);
+		ullSink += uiRow + uiCol;
+	});
+	const double dFlatFind = TimeIt(uiScanIterations, [&]() {
+		cFlat.FindValue(300, uiRow, uiCol);
+		ullSink += uiRow + uiCol;
+	});
+	PrintResult("FindValue (full scan)", dLegacyFind, dFlatFind);
+
+	// SaveMap: copy every tile, row by row, into the document being saved
+	vector<int> arrDocument(uiNumTiles);
+	const double dLegacySave = TimeIt(uiScanIterations, [&]() {
+		int* pOut = arrDocument.data();
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+				*pOut++ = cLegacy.arrMapInfo[uiRow][uiCol].value;
+		ullSink += arrDocument[uiNumTiles / 2];
+	});
+	const double dFlatSave = TimeIt(uiScanIterations, [&]() {
+		const int* pTiles = cFlat.GetTiles();
+		int* pOut = arrDocument.data();
+		for (unsigned int uiIndex = 0; uiIndex < uiNumTiles; uiIndex++)
+			*pOut++ = *pTiles++;
+		ullSink += arrDocument[uiNumTiles / 2];
+	});
+	PrintResult("SaveMap (full copy)", dLegacySave, dFlatSave);
+
+	// isBlocked: random tile reads, like CheckPosition and the A* neighbour checks
+	const unsigned int uiNumQueries = 1 << 16;
+	vector<unsigned int> arrQueryRows(uiNumQueries), arrQueryCols(uiNumQueries);
+	for (unsigned int i = 0; i < uiNumQueries; i++)
+	{
+		arrQueryRows[i] = NextRandom() % uiNumRows;
+		arrQueryCols[i] = NextRandom() % uiNumCols;
+	}
+	const double dLegacyBlocked = TimeIt(100, [&]() {
+		unsigned int uiCount = 0;
+		for (unsigned int i = 0; i < uiNumQueries; i++)
+			uiCount += cLegacy.IsBlocked(arrQueryRows[i], arrQueryCols[i]);
+		ullSink += uiCount;
+	}) / uiNumQueries;
+	const double dFlatBlocked = TimeIt(100, [&]() {
+		unsigned int uiCount = 0;
+		for (unsigned int i = 0; i < uiNumQueries; i++)
+			uiCount += cFlat.IsBlocked(arrQueryRows[i], arrQueryCols[i]);
+		ullSink += uiCount;
+	}) / uiNumQueries;
+	PrintResult("isBlocked (random read)", dLegacyBlocked, dFlatBlocked);
+	cout << endl;
+}
+
+int main(void)
+{
+	// The shipped DM2213 levels, then larger maps where the layout matters more
+	RunBenchmark(30, 40);
+	RunBenchmark(256, 256);
+	RunBenchmark(1024, 1024);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,389 @@
+/**
+ PathFindBenchmark
+ @brief Runs fixed-seed path queries through every search mode over the shipped maps and generated maps
+		(random walls, mazes and open fields at 40x30, 256x256 and 2048x2048), and reports
+		queries/sec, nodes expanded, p50/p99 latency and bytes allocated per query as JSON or CSV.
+		Usage: PathFindBenchmark [--csv] [--quick]
+		--csv	Print CSV instead of JSON
+		--quick	Skip the 2048x2048 maps
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PathFinder.h"
+#include "ClusterGraph.h"
+#include "JumpTable.h"
+#include "ReachabilityIndex.h"
+
+#include "MapCsv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// The bytes requested from operator new so far, so that each query can report what it allocated
+static unsigned long long ullBytesAllocated = 0;
+
+void* operator new(size_t uiSize)
+{
+	ullBytesAllocated += uiSize;
+	if (void* p = malloc(uiSize ? uiSize : 1))
+		return p;
+	throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+// Simple xorshift, so that every run builds the same maps and asks the same queries
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+// A map to run the queries on
+struct BenchmarkMap
+{
+	string name;
+	CMapLevel cLevel;
+	unsigned int uiNumQueries;
+};
+
+// The results of one search mode on one map
+struct BenchmarkResult
+{
+	string map;
+	unsigned int uiNumCols;
+	unsigned int uiNumRows;
+	string mode;
+	unsigned int uiNrOfDirections;
+	unsigned int uiNumQueries;
+	unsigned int uiNumFound;
+	double dBuildMs;
+	double dQueriesPerSec;
+	double dNodesExpanded;
+	double dP50Us;
+	double dP99Us;
+	double dBytesPerQuery;
+};
+
+// The walls are placed at random, one tile in iOneIn
+static void GenerateRandomWalls(CMapLevel& cLevel, const unsigned int uiNumRows, const unsigned int uiNumCols, const unsigned int uiOneIn)
+{
+	cLevel.Init(uiNumRows, uiNumCols);
+	int* pTiles = cLevel.GetTiles();
+	for (unsigned int i = 0; i < uiNumRows * uiNumCols; i++)
+		pTiles[i] = (NextRandom() % uiOneIn == 0) ? 100 : 0;
+	cLevel.UpdateLayers();
+}
+
+// A perfect maze carved by a depth first search over the tiles with odd rows and columns
+static void GenerateMaze(CMapLevel& cLevel, const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	cLevel.Init(uiNumRows, uiNumCols);
+	int* pTiles = cLevel.GetTiles();
+	std::fill(pTiles, pTiles + uiNumRows * uiNumCols, 100);
+
+	const int iNumCellsX = (int)(uiNumCols - 1) / 2;
+	const int iNumCellsY = (int)(uiNumRows - 1) / 2;
+	vector<bool> arrVisited(iNumCellsX * iNumCellsY, false);
+	vector<int> arrStack;
+	arrStack.push_back(0);
+	arrVisited[0] = true;
+	pTiles[uiNumCols + 1] = 0;
+	static const int iDeltaX[4] = { 1, -1, 0, 0 };
+	static const int iDeltaY[4] = { 0, 0, 1, -1 };
+	while (!arrStack.empty())
+	{
+		const int iCell = arrStack.back();
+		const int iCellX = iCell % iNumCellsX;
+		const int iCellY = iCell / iNumCellsX;
+
+		// Pick an unvisited neighbour at random, or go back if there is none
+		int arrNeighbours[4];
+		int iNumNeighbours = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			const int iX = iCellX + iDeltaX[i];
+			const int iY = iCellY + iDeltaY[i];
+			if ((iX >= 0) && (iX < iNumCellsX) && (iY >= 0) && (iY < iNumCellsY) && !arrVisited[iY * iNumCellsX + iX])
+				arrNeighbours[iNumNeighbours++] = i;
+		}
+		if (iNumNeighbours == 0)
+		{
+			arrStack.pop_back();
+			continue;
+		}
+
+		const int i = arrNeighbours[NextRandom() % iNumNeighbours];
+		const int iX = iCellX + iDeltaX[i];
+		const int iY = iCellY + iDeltaY[i];
+		arrVisited[iY * iNumCellsX + iX] = true;
+		pTiles[(2 * iY + 1) * uiNumCols + (2 * iX + 1)] = 0;
+		pTiles[(2 * iCellY + 1 + iDeltaY[i]) * uiNumCols + (2 * iCellX + 1 + iDeltaX[i])] = 0;
+		arrStack.push_back(iY * iNumCellsX + iX);
+	}
+	cLevel.UpdateLayers();
+}
+
+// Pick pairs of free tiles which are connected, so that no query is rejected before searching
+static void GenerateQueries(const CMapLevel& cLevel, const unsigned int uiNumQueries, vector<glm::vec2>& arrStarts, vector<glm::vec2>& arrTargets)
+{
+	CReachabilityIndex cReachabilityIndex;
+	cReachabilityIndex.Build(cLevel, 4);
+
+	arrStarts.clear();
+	arrTargets.clear();
+	const unsigned int uiMaxAttempts = uiNumQueries * 1000;
+	for (unsigned int uiAttempt = 0; (uiAttempt < uiMaxAttempts) && (arrStarts.size() < uiNumQueries); uiAttempt++)
+	{
+		const glm::vec2 startPos(NextRandom() % cLevel.GetNumCols(), NextRandom() % cLevel.GetNumRows());
+		const glm::vec2 targetPos(NextRandom() % cLevel.GetNumCols(), NextRandom() % cLevel.GetNumRows());
+		if ((startPos != targetPos) && cReachabilityIndex.IsConnected(startPos, targetPos))
+		{
+			arrStarts.push_back(startPos);
+			arrTargets.push_back(targetPos);
+		}
+	}
+}
+
+// Get a percentile of some sorted latencies
+static double GetPercentile(const vector<double>& arrSorted, const double dPercentile)
+{
+	if (arrSorted.empty())
+		return 0.0;
+	const size_t uiIndex = (size_t)(dPercentile * (arrSorted.size() - 1) + 0.5);
+	return arrSorted[uiIndex];
+}
+
+// Run the queries of one map through one search mode
+template <typename Search>
+static BenchmarkResult RunQueries(const BenchmarkMap& sMap,
+	const string& mode,
+	const unsigned int uiNrOfDirections,
+	const vector<glm::vec2>& arrStarts,
+	const vector<glm::vec2>& arrTargets,
+	const double dBuildMs,
+	Search search)
+{
+	BenchmarkResult sResult;
+	sResult.map = sMap.name;
+	sResult.uiNumCols = sMap.cLevel.GetNumCols();
+	sResult.uiNumRows = sMap.cLevel.GetNumRows();
+	sResult.mode = mode;
+	sResult.uiNrOfDirections = uiNrOfDirections;
+	sResult.uiNumQueries = (unsigned int)arrStarts.size();
+	sResult.uiNumFound = 0;
+	sResult.dBuildMs = dBuildMs;
+
+	vector<double> arrLatencies;
+	arrLatencies.reserve(arrStarts.size());
+	unsigned long long ullNodesExpanded = 0;
+	unsigned long long ullBytes = 0;
+	double dTotalUs = 0.0;
+	for (unsigned int i = 0; i < arrStarts.size(); i++)
+	{
+		unsigned int uiNodesExpanded = 0;
+		const unsigned long long ullBytesBefore = ullBytesAllocated;
+		const auto start = chrono::steady_clock::now();
+		const bool bFound = search(arrStarts[i], arrTargets[i], uiNodesExpanded);
+		const auto end = chrono::steady_clock::now();
+		ullBytes += ullBytesAllocated - ullBytesBefore;
+
+		const double dUs = chrono::duration<double, micro>(end - start).count();
+		arrLatencies.push_back(dUs);
+		dTotalUs += dUs;
+		ullNodesExpanded += uiNodesExpanded;
+		if (bFound)
+			sResult.uiNumFound++;
+	}
+
+	std::sort(arrLatencies.begin(), arrLatencies.end());
+	const double dNumQueries = arrStarts.empty() ? 1.0 : (double)arrStarts.size();
+	sResult.dQueriesPerSec = (dTotalUs > 0.0) ? (arrStarts.size() * 1e6 / dTotalUs) : 0.0;
+	sResult.dNodesExpanded = ullNodesExpanded / dNumQueries;
+	sResult.dP50Us = GetPercentile(arrLatencies, 0.50);
+	sResult.dP99Us = GetPercentile(arrLatencies, 0.99);
+	sResult.dBytesPerQuery = ullBytes / dNumQueries;
+	return sResult;
+}
+
+// Run the queries of one map through every search mode, moving in 4 and in 8 directions
+static void RunBenchmark(BenchmarkMap& sMap, vector<BenchmarkResult>& arrResults)
+{
+	vector<glm::vec2> arrStarts, arrTargets;
+	GenerateQueries(sMap.cLevel, sMap.uiNumQueries, arrStarts, arrTargets);
+	cerr << sMap.name << " (" << sMap.cLevel.GetNumCols() << "x" << sMap.cLevel.GetNumRows() << "): "
+		<< arrStarts.size() << " queries" << endl;
+
+	for (unsigned int uiNrOfDirections = 4; uiNrOfDirections <= 8; uiNrOfDirections += 4)
+	{
+		CPathFinder cPathFinder;
+		cPathFinder.Init(sMap.cLevel.GetNumRows(), sMap.cLevel.GetNumCols());
+		cPathFinder.SetDiagonalMovement(uiNrOfDirections == 8);
+
+		// A*, Jump Point Search, and JPS+ with its jump distances built up front
+		const char* arrModeNames[CPathFinder::NUM_SEARCHMODES] = { "astar", "jps", "jpsplus" };
+		for (int iMode = 0; iMode < CPathFinder::NUM_SEARCHMODES; iMode++)
+		{
+			cPathFinder.SetSearchMode((CPathFinder::SEARCHMODE)iMode);
+			CJumpTable cJumpTable;
+			double dBuildMs = 0.0;
+			if (iMode == CPathFinder::JPSPLUS)
+			{
+				const auto start = chrono::steady_clock::now();
+				cJumpTable.Build(sMap.cLevel, uiNrOfDirections);
+				dBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+			}
+
+			arrResults.push_back(RunQueries(sMap, arrModeNames[iMode], uiNrOfDirections, arrStarts, arrTargets, dBuildMs,
+				[&](const glm::vec2& startPos, const glm::vec2& targetPos, unsigned int& uirNodesExpanded)
+				{
+					const vector<glm::vec2> path = cPathFinder.PathFind(sMap.cLevel, startPos, targetPos, heuristic::manhattan, 1,
+						(iMode == CPathFinder::JPSPLUS) ? &cJumpTable : NULL);
+					uirNodesExpanded = cPathFinder.GetNumNodesExpanded();
+					return !path.empty();
+				}));
+		}
+
+		// HPA*, with the clusters built by a first search which is not counted.
+		// Its nodes expanded are the entrances searched, not tiles
+		cPathFinder.SetSearchMode(CPathFinder::ASTAR);
+		CClusterGraph cClusterGraph;
+		cClusterGraph.Init(sMap.cLevel.GetNumRows(), sMap.cLevel.GetNumCols());
+		double dBuildMs = 0.0;
+		if (!arrStarts.empty())
+		{
+			const auto start = chrono::steady_clock::now();
+			cClusterGraph.PathFind(sMap.cLevel, cPathFinder, arrStarts[0], arrTargets[0], heuristic::manhattan, 1);
+			dBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		}
+		arrResults.push_back(RunQueries(sMap, "hpa", uiNrOfDirections, arrStarts, arrTargets, dBuildMs,
+			[&](const glm::vec2& startPos, const glm::vec2& targetPos, unsigned int& uirNodesExpanded)
+			{
+				const vector<glm::vec2> path = cClusterGraph.PathFind(sMap.cLevel, cPathFinder, startPos, targetPos, heuristic::manhattan, 1);
+				uirNodesExpanded = cClusterGraph.GetNumNodesExpanded();
+				return !path.empty();
+			}));
+	}
+}
+
+static void PrintJson(const vector<BenchmarkResult>& arrResults)
+{
+	cout << "{" << endl << "  \"results\": [" << endl;
+	for (unsigned int i = 0; i < arrResults.size(); i++)
+	{
+		const BenchmarkResult& r = arrResults[i];
+		cout << fixed << setprecision(3)
+			<< "    {\"map\": \"" << r.map << "\""
+			<< ", \"cols\": " << r.uiNumCols
+			<< ", \"rows\": " << r.uiNumRows
+			<< ", \"mode\": \"" << r.mode << "\""
+			<< ", \"directions\": " << r.uiNrOfDirections
+			<< ", \"queries\": " << r.uiNumQueries
+			<< ", \"found\": " << r.uiNumFound
+			<< ", \"build_ms\": " << r.dBuildMs
+			<< ", \"queries_per_sec\": " << r.dQueriesPerSec
+			<< ", \"nodes_expanded\": " << r.dNodesExpanded
+			<< ", \"p50_us\": " << r.dP50Us
+			<< ", \"p99_us\": " << r.dP99Us
+			<< ", \"bytes_per_query\": " << r.dBytesPerQuery
+			<< "}" << ((i + 1 < arrResults.size()) ? "," : "") << endl;
+	}
+	cout << "  ]" << endl << "}" << endl;
+}
+
+static void PrintCsv(const vector<BenchmarkResult>& arrResults)
+{
+	cout << "map,cols,rows,mode,directions,queries,found,build_ms,queries_per_sec,nodes_expanded,p50_us,p99_us,bytes_per_query" << endl;
+	for (unsigned int i = 0; i < arrResults.size(); i++)
+	{
+		const BenchmarkResult& r = arrResults[i];
+		cout << fixed << setprecision(3)
+			<< r.map << "," << r.uiNumCols << "," << r.uiNumRows << "," << r.mode << "," << r.uiNrOfDirections << ","
+			<< r.uiNumQueries << "," << r.uiNumFound << "," << r.dBuildMs << "," << r.dQueriesPerSec << ","
+			<< r.dNodesExpanded << "," << r.dP50Us << "," << r.dP99Us << "," << r.dBytesPerQuery << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool bCsv = false;
+	bool bQuick = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--csv") == 0)
+			bCsv = true;
+		else if (strcmp(argv[i], "--quick") == 0)
+			bQuick = true;
+		else
+		{
+			cerr << "Usage: PathFindBenchmark [--csv] [--quick]" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	vector<BenchmarkMap> arrMaps;
+
+	// The shipped maps, listed by CMake and separated by '|'. Files which are not level CSVs are skipped
+	stringstream shippedMaps(SHIPPED_MAPS);
+	string filename;
+	while (getline(shippedMaps, filename, '|'))
+	{
+		BenchmarkMap sMap;
+		if (!LoadMapCsv(filename, sMap.cLevel))
+			continue;
+		sMap.name = filename.substr(filename.find_last_of("/\\") + 1);
+		sMap.uiNumQueries = 2000;
+		arrMaps.push_back(sMap);
+	}
+
+	// The generated maps, with fewer queries on the larger maps
+	const unsigned int arrSizes[3][3] = { { 30, 40, 2000 }, { 256, 256, 200 }, { 2048, 2048, 10 } };
+	for (unsigned int i = 0; i < (bQuick ? 2u : 3u); i++)
+	{
+		const unsigned int uiNumRows = arrSizes[i][0];
+		const unsigned int uiNumCols = arrSizes[i][1];
+		const string size = to_string(uiNumCols) + "x" + to_string(uiNumRows);
+
+		BenchmarkMap sMap;
+		sMap.uiNumQueries = arrSizes[i][2];
+		sMap.name = "random_walls_" + size;
+		GenerateRandomWalls(sMap.cLevel, uiNumRows, uiNumCols, 5);
+		arrMaps.push_back(sMap);
+		sMap.name = "maze_" + size;
+		GenerateMaze(sMap.cLevel, uiNumRows, uiNumCols);
+		arrMaps.push_back(sMap);
+		sMap.name = "open_field_" + size;
+		GenerateRandomWalls(sMap.cLevel, uiNumRows, uiNumCols, 50);
+		arrMaps.push_back(sMap);
+	}
+
+	vector<BenchmarkResult> arrResults;
+	for (unsigned int i = 0; i < arrMaps.size(); i++)
+		RunBenchmark(arrMaps[i], arrResults);
+
+	if (bCsv)
+		PrintCsv(arrResults);
+	else
+		PrintJson(arrResults);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+/**
+ PvsCook
+ @brief Builds the visible sets of map CSV files offline and saves each one next to its CSV,
+		so that CMap2D::LoadMap only has to load them. Usage: PvsCook <map.csv>...
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "PotentiallyVisibleSet.h"
+
+#include "MapCsv.h"
+
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: PvsCook <map.csv>..." << endl;
+		return 1;
+	}
+
+	int iResult = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		const string filename = argv[i];
+		CMapLevel cLevel;
+		if (!LoadMapCsv(filename, cLevel))
+		{
+			iResult = 1;
+			continue;
+		}
+
+		const auto start = chrono::steady_clock::now();
+		CLineOfSight cLineOfSight;
+		cLineOfSight.Build(cLevel);
+		CPotentiallyVisibleSet cPotentiallyVisibleSet;
+		cPotentiallyVisibleSet.Build(cLevel, cLineOfSight, 0);
+		const double dMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+		const string pvsFilename = CPotentiallyVisibleSet::GetFilename(filename);
+		if (!cPotentiallyVisibleSet.Save(pvsFilename))
+		{
+			cout << "Unable to save " << pvsFilename << endl;
+			iResult = 1;
+			continue;
+		}
+		cout << pvsFilename << ": " << cLevel.GetNumCols() << "x" << cLevel.GetNumRows()
+			<< ", " << cPotentiallyVisibleSet.GetMemorySize() << " bytes, built in " << dMs << " ms" << endl;
+	}
+	return iResult;
+}
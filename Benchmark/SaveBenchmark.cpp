@@ -0,0 +1,132 @@
+/**
+ SaveBenchmark
+ @brief Edits a large level every frame and saves it every few frames with CMapSaver, the way CMap2D::SaveMap does,
+		once writing the saves on the main thread and once on the I/O thread. Checks that the last save holds the
+		edited level, then prints the frame times of both
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+#include "ChangeJournal.h"
+#include "LevelFile.h"
+#include "MapSaver.h"
+#include "MapCsv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Simple xorshift so that every run sees the same edits
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+// Play uiNumFrames frames of a level at 60 frames per second, editing some tiles in each and saving it every
+// uiSaveInterval frames. Returns false if the files of the last save do not hold the level
+static bool PlayFrames(const bool bIOThread, const unsigned int uiSize, const unsigned int uiNumFrames, const unsigned int uiSaveInterval)
+{
+	const string filename = "SaveBenchmark.csv";
+	CMapLevel cLevel;
+	cLevel.Init(uiSize, uiSize);
+	for (unsigned int i = 0; i < uiSize * uiSize; i++)
+		cLevel.GetTiles()[i] = (int)(NextRandom() % 300);
+	CChangeJournal cChangeJournal;
+	cChangeJournal.Reset(cLevel);
+
+	CMapSaver cMapSaver;
+	if (bIOThread)
+		cMapSaver.Init();
+
+	// The copy which the saves write, brought up to date with the edits like CMap2D::GetSaveSnapshot
+	shared_ptr<CMapLevel> pSnapshot;
+	unsigned int uiSnapshotVersion = 0;
+	vector<TileChange> arrChanges;
+	unsigned int uiNumSaved = 0, uiNumCopies = 0;
+
+	double dTotal = 0.0, dMax = 0.0;
+	for (unsigned int uiFrame = 0; uiFrame < uiNumFrames; uiFrame++)
+	{
+		const auto start = chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < 20; i++)
+		{
+			const unsigned int uiRow = NextRandom() % uiSize, uiCol = NextRandom() % uiSize;
+			const int iValue = (int)(NextRandom() % 300);
+			cChangeJournal.Record(uiRow, uiCol, cLevel.GetTile(uiRow, uiCol), iValue);
+			cLevel.SetTile(uiRow, uiCol, iValue);
+		}
+
+		if (uiFrame % uiSaveInterval == 0)
+		{
+			if (pSnapshot && (pSnapshot.use_count() == 1) && cChangeJournal.GetChangesSince(uiSnapshotVersion, arrChanges))
+			{
+				for (unsigned int i = 0; i < arrChanges.size(); i++)
+					pSnapshot->SetTile(arrChanges[i].uiRow, arrChanges[i].uiCol, arrChanges[i].iNewValue);
+			}
+			else
+			{
+				pSnapshot = make_shared<CMapLevel>(cLevel);
+				uiNumCopies++;
+			}
+			uiSnapshotVersion = cChangeJournal.GetVersion();
+			cMapSaver.Save(pSnapshot, "", filename, [&uiNumSaved](const unsigned int, const bool bSaved)
+			{
+				if (bSaved)
+					uiNumSaved++;
+			});
+		}
+		cMapSaver.DeliverResults();
+
+		const double dFrame = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+		dTotal += dFrame;
+		dMax = max(dMax, dFrame);
+		if (dFrame < 1000.0 / 60.0)
+			this_thread::sleep_for(chrono::duration<double, milli>(1000.0 / 60.0 - dFrame));
+	}
+	cMapSaver.Wait();
+
+	cout << "  " << left << setw(12) << (bIOThread ? "I/O thread" : "main thread") << right << fixed << setprecision(2)
+		<< dTotal / uiNumFrames << " ms per frame (max " << dMax << " ms), " << uiNumSaved << " of " << cMapSaver.GetNumSaves()
+		<< " saves written, " << uiNumCopies << " full copies" << endl;
+
+	// The last save was taken before the edits of the frames after it, so compare with its snapshot
+	CMapLevel cSavedLevel;
+	bool bSame = LoadMapCsv(filename, cSavedLevel) && (uiNumSaved == cMapSaver.GetNumSaves());
+	CLevelFile cLevelFile;
+	CMapLevel cCompiledLevel;
+	cCompiledLevel.Init(uiSize, uiSize);
+	bSame = bSame && cLevelFile.Open(CLevelFile::GetFilename(filename)) && cLevelFile.CopyTo(cCompiledLevel);
+	cLevelFile.Close();
+	for (unsigned int i = 0; bSame && (i < uiSize * uiSize); i++)
+		bSame = (cSavedLevel.GetTiles()[i] == pSnapshot->GetTiles()[i]) && (cCompiledLevel.GetTiles()[i] == pSnapshot->GetTiles()[i]);
+
+	remove(filename.c_str());
+	remove(CLevelFile::GetFilename(filename).c_str());
+	return bSame;
+}
+
+int main(void)
+{
+	// 2048x2048 tiles is 16 MB of tiles, and about 16 MB of CSV text
+	cout << "Saving a 2048x2048 level every 30 frames" << endl;
+	bool bSame = PlayFrames(false, 2048, 240, 30);
+	bSame &= PlayFrames(true, 2048, 240, 30);
+	if (!bSame)
+	{
+		cout << "  The saved level differs" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
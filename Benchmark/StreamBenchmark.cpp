@@ -0,0 +1,188 @@
+/**
+ StreamBenchmark
+ @brief Walks a focus across levels streamed from chunk files with CStreamedLevel. Checks that the tiles read
+		and edited through the chunks match a CMapLevel, including after the edited chunks were evicted and written
+		back, then times the frames of a walk across a large level and the neighbour reads of each chunk layout
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "MapLevel.h"
+#include "StreamedLevel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+// Simple xorshift so that every run sees the same maps
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+static const char* GetLayoutName(const CStreamedLevel::LAYOUT eLayout)
+{
+	return (eLayout == CStreamedLevel::MORTON) ? "morton" : "row major";
+}
+
+// Edit random tiles of a level streamed with a small budget while its focus walks around,
+// and compare every tile with a CMapLevel which had the same edits
+static bool CheckLevel(const CStreamedLevel::LAYOUT eLayout)
+{
+	const string filename = "StreamBenchmark_check.chunks";
+	const unsigned int uiNumRows = 700, uiNumCols = 1000;
+	CMapLevel cLevel;
+	cLevel.Init(uiNumRows, uiNumCols);
+	for (unsigned int i = 0; i < uiNumRows * uiNumCols; i++)
+		cLevel.GetTiles()[i] = (int)(NextRandom() % 300);
+	if (!CStreamedLevel::Save(filename, cLevel, 32, eLayout))
+	{
+		cout << "  Unable to write " << filename << endl;
+		return false;
+	}
+
+	bool bSame = true;
+	{
+		// 40 chunks of 32x32 tiles, out of 22 * 32
+		CStreamedLevel cStreamedLevel;
+		if (!cStreamedLevel.Open(filename, 40 * 32 * 32 * sizeof(int)))
+		{
+			cout << "  Unable to open " << filename << endl;
+			return false;
+		}
+		for (unsigned int uiFrame = 0; uiFrame < 2000; uiFrame++)
+		{
+			cStreamedLevel.SetFocus(NextRandom() % uiNumRows, NextRandom() % uiNumCols);
+			cStreamedLevel.Update();
+			for (unsigned int i = 0; i < 20; i++)
+			{
+				const unsigned int uiRow = NextRandom() % uiNumRows, uiCol = NextRandom() % uiNumCols;
+				if (cStreamedLevel.GetTile(uiRow, uiCol) != cLevel.GetTile(uiRow, uiCol))
+					bSame = false;
+				const int iValue = (int)(NextRandom() % 300);
+				cStreamedLevel.SetTile(uiRow, uiCol, iValue);
+				cLevel.SetTile(uiRow, uiCol, iValue);
+			}
+		}
+		cout << "  " << left << setw(10) << GetLayoutName(eLayout) << right << cStreamedLevel.GetNumLoads() << " chunks read ahead, "
+			<< cStreamedLevel.GetNumMisses() << " read at once, " << cStreamedLevel.GetNumEvictions() << " evicted, "
+			<< cStreamedLevel.GetNumWriteBacks() << " written back" << endl;
+	}
+
+	// The level was closed, so every edit has to be in the file now
+	CStreamedLevel cStreamedLevel;
+	if (!cStreamedLevel.Open(filename, 0))
+		return false;
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			if (cStreamedLevel.GetTile(uiRow, uiCol, false) != cLevel.GetTile(uiRow, uiCol, false))
+				bSame = false;
+		}
+	}
+	cStreamedLevel.Close();
+	remove(filename.c_str());
+	return bSame;
+}
+
+// Walk the focus diagonally across a large level, reading the tiles around it in each frame like the AI around the player
+static void TimeWalk(const unsigned int uiSize, const size_t uiMemoryBudget)
+{
+	const string filename = "StreamBenchmark_walk.chunks";
+	if (!CStreamedLevel::Create(filename, uiSize, uiSize, 0))
+	{
+		cout << "  Unable to write " << filename << endl;
+		return;
+	}
+
+	CStreamedLevel cStreamedLevel;
+	cStreamedLevel.Open(filename, uiMemoryBudget);
+	const unsigned int uiStep = 2, uiView = 24;
+	const unsigned int uiNumFrames = (uiSize - 2 * uiView) / uiStep;
+	double dTotal = 0.0, dMax = 0.0;
+	volatile int iSink = 0;
+	for (unsigned int uiFrame = 0; uiFrame < uiNumFrames; uiFrame++)
+	{
+		const unsigned int uiFocus = uiView + uiFrame * uiStep;
+		const auto start = chrono::high_resolution_clock::now();
+		cStreamedLevel.SetFocus(uiFocus, uiFocus);
+		cStreamedLevel.Update();
+		int iSum = 0;
+		for (unsigned int uiRow = uiFocus - uiView; uiRow < uiFocus + uiView; uiRow++)
+			for (unsigned int uiCol = uiFocus - uiView; uiCol < uiFocus + uiView; uiCol++)
+				iSum += cStreamedLevel.GetTile(uiRow, uiCol);
+		iSink += iSum;
+		const double dFrame = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count();
+		dTotal += dFrame;
+		dMax = max(dMax, dFrame);
+	}
+	cout << "  " << uiSize << "x" << uiSize << " (" << ((size_t)uiSize * uiSize * sizeof(int) >> 20) << " MB) in "
+		<< (uiMemoryBudget >> 20) << " MB: " << uiNumFrames << " frames, " << fixed << setprecision(1)
+		<< dTotal / uiNumFrames << " us per frame (max " << dMax << " us), "
+		<< cStreamedLevel.GetNumLoads() << " chunks read ahead, " << cStreamedLevel.GetNumMisses() << " read at once" << endl;
+	cStreamedLevel.Close();
+	remove(filename.c_str());
+}
+
+// Read the 8 neighbours of every tile of a resident level, in nanoseconds per tile
+static double TimeNeighbours(const CStreamedLevel::LAYOUT eLayout)
+{
+	const string filename = "StreamBenchmark_layout.chunks";
+	const unsigned int uiSize = 1024;
+	CStreamedLevel::Create(filename, uiSize, uiSize, 1, 32, eLayout);
+	CStreamedLevel cStreamedLevel;
+	cStreamedLevel.Open(filename, (size_t)uiSize * uiSize * sizeof(int));
+	// Read every chunk once first, so that only the reads are timed
+	for (unsigned int uiRow = 0; uiRow < uiSize; uiRow += 32)
+		for (unsigned int uiCol = 0; uiCol < uiSize; uiCol += 32)
+			cStreamedLevel.GetTile(uiRow, uiCol);
+
+	volatile int iSink = 0;
+	const auto start = chrono::high_resolution_clock::now();
+	for (unsigned int uiRow = 1; uiRow < uiSize - 1; uiRow++)
+	{
+		int iSum = 0;
+		for (unsigned int uiCol = 1; uiCol < uiSize - 1; uiCol++)
+		{
+			for (int iRowOffset = -1; iRowOffset <= 1; iRowOffset++)
+				for (int iColOffset = -1; iColOffset <= 1; iColOffset++)
+					iSum += cStreamedLevel.GetTile(uiRow + iRowOffset, uiCol + iColOffset);
+		}
+		iSink += iSum;
+	}
+	const double dNanoseconds = chrono::duration<double, nano>(chrono::high_resolution_clock::now() - start).count();
+	cStreamedLevel.Close();
+	remove(filename.c_str());
+	return dNanoseconds / ((double)(uiSize - 2) * (uiSize - 2));
+}
+
+int main(void)
+{
+	cout << "Edits through evicted chunks" << endl;
+	bool bSame = true;
+	for (unsigned int i = 0; i < CStreamedLevel::NUM_LAYOUTS; i++)
+		bSame &= CheckLevel((CStreamedLevel::LAYOUT)i);
+	if (!bSame)
+	{
+		cout << "  The streamed tiles differ" << endl;
+		return EXIT_FAILURE;
+	}
+
+	cout << endl << "Walking across a level" << endl;
+	TimeWalk(4096, (size_t)4 << 20);
+
+	cout << endl << "3x3 neighbourhood reads per tile" << endl;
+	for (unsigned int i = 0; i < CStreamedLevel::NUM_LAYOUTS; i++)
+		cout << "  " << left << setw(10) << GetLayoutName((CStreamedLevel::LAYOUT)i) << right << fixed << setprecision(2)
+			<< TimeNeighbours((CStreamedLevel::LAYOUT)i) << " ns" << endl;
+	return EXIT_SUCCESS;
+}
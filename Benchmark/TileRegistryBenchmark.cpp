@@ -0,0 +1,116 @@
+/**
+ TileRegistryBenchmark
+ @brief Compares classifying the tiles of a level with the range checks and switches which the entities used,
+		against the lookup table of the tile registry. Checks that both give the same blocking tiles, items and handlers
+ By: Toh Da Jun
+ Date: Oct 2026
+ */
+#include "TileRegistry.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+// Simple xorshift so that every run sees the same tiles
+static unsigned int uiSeed = 2213;
+static unsigned int NextRandom(void)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+	return uiSeed;
+}
+
+// The checks as they were written inline, before the tile registry
+static bool IsBlockingRange(const int iValue)
+{
+	return (iValue >= 100) && (iValue < 200);
+}
+static tiletype::HANDLER GetHandlerSwitch(const int iValue)
+{
+	switch (iValue)
+	{
+	case 2:
+		return tiletype::HANDLER_PICK_UP_FLARE;
+	case 3:
+		return tiletype::HANDLER_EAT_FLARE;
+	case 4:
+		return tiletype::HANDLER_PICK_UP_CEREAL;
+	case 5:
+		return tiletype::HANDLER_EAT_CEREAL;
+	case 10:
+		return tiletype::HANDLER_ADD_LIFE;
+	case 20:
+		return tiletype::HANDLER_DAMAGE;
+	case 21:
+		return tiletype::HANDLER_HEAL;
+	case 99:
+		return tiletype::HANDLER_WIN;
+	default:
+		return tiletype::HANDLER_NONE;
+	}
+}
+
+int main(void)
+{
+	// Every value the shipped maps use, and some which are not in the registry
+	const int arrValues[] = { 0, 0, 0, 0, 0, 0, 0, 0, 100, 100, 100, 150, 2, 3, 4, 5, 10, 20, 21, 99, 200, 300, 400, 1, -1, 999 };
+	const unsigned int uiNumValues = sizeof(arrValues) / sizeof(arrValues[0]);
+	const unsigned int uiSize = 1024, uiNumPasses = 20;
+	vector<int> arrTiles(uiSize * uiSize);
+	for (unsigned int i = 0; i < arrTiles.size(); i++)
+		arrTiles[i] = arrValues[NextRandom() % uiNumValues];
+
+	// Both have to agree on every value the registry knows, including the values around its ranges
+	bool bSame = true;
+	for (int iValue = -16; iValue < (int)tiletype::NUM_VALUES + 16; iValue++)
+	{
+		const bool bKnown = (iValue == 0) || (GetHandlerSwitch(iValue) != tiletype::HANDLER_NONE) || IsBlockingRange(iValue) ||
+			(iValue == 200) || (iValue == 300) || (iValue == 400);
+		bSame &= (tiletype::IsBlocking(iValue) == IsBlockingRange(iValue)) &&
+			(tiletype::GetHandler(iValue) == GetHandlerSwitch(iValue)) &&
+			(tiletype::IsItem(iValue) == (bKnown && (iValue != 0) && !IsBlockingRange(iValue)));
+	}
+
+	unsigned int uiRangeCount = 0, uiTableCount = 0;
+	const auto startRange = chrono::high_resolution_clock::now();
+	for (unsigned int uiPass = 0; uiPass < uiNumPasses; uiPass++)
+	{
+		for (unsigned int i = 0; i < arrTiles.size(); i++)
+		{
+			const int iValue = arrTiles[i];
+			uiRangeCount += IsBlockingRange(iValue) ? 1 : 0;
+			uiRangeCount += (unsigned int)GetHandlerSwitch(iValue);
+		}
+	}
+	const double dRange = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - startRange).count();
+
+	const auto startTable = chrono::high_resolution_clock::now();
+	for (unsigned int uiPass = 0; uiPass < uiNumPasses; uiPass++)
+	{
+		for (unsigned int i = 0; i < arrTiles.size(); i++)
+		{
+			const int iValue = arrTiles[i];
+			uiTableCount += tiletype::IsBlocking(iValue) ? 1 : 0;
+			uiTableCount += (unsigned int)tiletype::GetHandler(iValue);
+		}
+	}
+	const double dTable = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - startTable).count();
+	bSame &= (uiRangeCount == uiTableCount);
+
+	const double dNumTiles = (double)arrTiles.size() * uiNumPasses;
+	cout << "Classifying " << uiSize << "x" << uiSize << " tiles " << uiNumPasses << " times" << endl;
+	cout << fixed << setprecision(2)
+		<< "  range checks and switches: " << dRange * 1e6 / dNumTiles << " ns per tile" << endl
+		<< "  lookup table:              " << dTable * 1e6 / dNumTiles << " ns per tile" << endl;
+
+	if (!bSame)
+	{
+		cout << "  The lookup table differs from the range checks" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
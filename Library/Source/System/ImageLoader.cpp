@@ -72,6 +72,12 @@ unsigned char * CImageLoader::Load(const char* filename, int& width, int& height
  */
 unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bInvert)
 {
+	// The scenes load their textures whenever they are initialised, so reuse a texture which is already in the graphics card
+	const std::pair<std::string, bool> key(filename, bInvert);
+	std::map<std::pair<std::string, bool>, unsigned int>::const_iterator it = mapTextureIDs.find(key);
+	if (it != mapTextureIDs.end())
+		return it->second;
+
 	// Load from file
 	int image_width = 0;
 	int image_height = 0;
@@ -117,6 +123,7 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 //	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 	stbi_image_free(data);
 
+	mapTextureIDs[key] = image_texture;
 	return image_texture;
 }
 
@@ -15,6 +15,10 @@
 #define GLEW_STATIC
 #endif
 
+#include <map>
+#include <string>
+#include <utility>
+
 class CImageLoader : public CSingletonTemplate<CImageLoader>
 {
 	friend CSingletonTemplate<CImageLoader>;
@@ -27,7 +31,7 @@ public:
 							int& width, int& height, 
 							int& nrChannels, const bool bInvert = false);
 
-	// Load an image and return as a Texture ID
+	// Load an image and return as a Texture ID. An image which was loaded before returns the same Texture ID
 	unsigned int LoadTextureGetID(const char* filename, const bool bInvert);
 protected:
 	// Constructor
@@ -35,5 +39,8 @@ protected:
 
 	// Destructor
 	virtual ~CImageLoader(void);
+
+	// The Texture ID of each image loaded into the graphics card, by its file and whether it was inverted
+	std::map<std::pair<std::string, bool>, unsigned int> mapTextureIDs;
 };
 